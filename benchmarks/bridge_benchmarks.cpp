@@ -0,0 +1,433 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+#include "python_bridge.h"
+#include "type_converter.h"
+#include "error_handler.h"
+#include "numpy_kernels.h"
+#include "bridge_allocator.h"
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace {
+
+const char* g_self_path = nullptr;
+
+const char* kBenchModuleName = "bridge_bench_module";
+
+const char* kBenchModuleSource = R"(
+def add(a, b):
+    return a + b
+
+def fail():
+    raise ValueError("benchmark")
+
+def make_dict(n):
+    return {"key%d" % i: float(i) for i in range(n)}
+
+def array_stats(arr):
+    import numpy as np
+    return {"mean": float(np.mean(arr)), "std": float(np.std(arr)), "min": float(np.min(arr)),
+            "max": float(np.max(arr)), "sum": float(np.sum(arr))}
+)";
+
+// 在解释器终止前由 main 释放
+std::unique_ptr<cpppy_bridge::PythonBridge> g_bridge;
+std::shared_ptr<cpppy_bridge::PythonModule> g_module;
+
+std::shared_ptr<cpppy_bridge::PythonModule> benchModule() {
+    if (!g_module) {
+        g_module = g_bridge->loadModule(kBenchModuleName);
+    }
+    return g_module;
+}
+
+// 临时丢弃 std::cout 输出（PythonBridge::initialize 每次都会打印）
+class SilenceStdout {
+public:
+    SilenceStdout() : m_saved(std::cout.rdbuf(&m_null)) {}
+    ~SilenceStdout() { std::cout.rdbuf(m_saved); }
+
+private:
+    struct NullBuffer : std::streambuf {
+        int overflow(int c) override { return traits_type::not_eof(c); }
+    };
+    NullBuffer m_null;
+    std::streambuf* m_saved;
+};
+
+void resetBridge(std::optional<cpppy_bridge::PythonBridge>& bridge) {
+    SilenceStdout silence;
+    bridge.emplace();
+    bridge->initialize();
+}
+
+// 在子进程中测量解释器启动，避免重复初始化同一进程中的解释器
+void BM_InterpreterStartup(benchmark::State& state) {
+    const std::string command = std::string("\"") + g_self_path + "\" --startup-probe";
+    for (auto _ : state) {
+        FILE* pipe = popen(command.c_str(), "r");
+        if (!pipe) {
+            state.SkipWithError("Failed to spawn startup probe");
+            return;
+        }
+
+        long long startup_ns = -1;
+        char line[256];
+        while (std::fgets(line, sizeof(line), pipe)) {
+            if (std::strncmp(line, "startup_ns=", 11) == 0) {
+                startup_ns = std::atoll(line + 11);
+            }
+        }
+        pclose(pipe);
+
+        if (startup_ns < 0) {
+            state.SkipWithError("Startup probe did not report a duration");
+            return;
+        }
+        state.SetIterationTime(static_cast<double>(startup_ns) * 1e-9);
+    }
+}
+BENCHMARK(BM_InterpreterStartup)->UseManualTime()->Unit(benchmark::kMillisecond)->Iterations(10);
+
+void BM_LoadModuleCold(benchmark::State& state) {
+    py::dict modules = py::module::import("sys").attr("modules");
+    std::optional<cpppy_bridge::PythonBridge> fresh;
+    for (auto _ : state) {
+        state.PauseTiming();
+        if (modules.contains(kBenchModuleName)) {
+            PyDict_DelItemString(modules.ptr(), kBenchModuleName);
+        }
+        resetBridge(fresh);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(fresh->loadModule(kBenchModuleName));
+    }
+}
+BENCHMARK(BM_LoadModuleCold)->Unit(benchmark::kMicrosecond);
+
+void BM_LoadModuleCached(benchmark::State& state) {
+    benchModule();
+    std::optional<cpppy_bridge::PythonBridge> fresh;
+    for (auto _ : state) {
+        state.PauseTiming();
+        resetBridge(fresh);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(fresh->loadModule(kBenchModuleName));
+    }
+}
+BENCHMARK(BM_LoadModuleCached)->Unit(benchmark::kMicrosecond);
+
+void BM_CallFunctionTyped(benchmark::State& state) {
+    auto module = benchModule();
+    double value = 0.0;
+    for (auto _ : state) {
+        value = module->callFunction<double>("add", value, 1.0);
+    }
+    benchmark::DoNotOptimize(value);
+}
+BENCHMARK(BM_CallFunctionTyped);
+
+void BM_CallFunctionVector(benchmark::State& state) {
+    auto module = benchModule();
+    std::vector<py::object> args = {py::float_(1.0), py::float_(2.0)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(module->callFunction("add", args));
+    }
+}
+BENCHMARK(BM_CallFunctionVector);
+
+void BM_PythonFunctionCall(benchmark::State& state) {
+    cpppy_bridge::PythonFunction add(benchModule(), "add");
+    double value = 0.0;
+    for (auto _ : state) {
+        value = add.call<double>(value, 1.0);
+    }
+    benchmark::DoNotOptimize(value);
+}
+BENCHMARK(BM_PythonFunctionCall);
+
+void BM_PythonFunctionCallPy(benchmark::State& state) {
+    cpppy_bridge::PythonFunction add(benchModule(), "add");
+    std::vector<py::object> args = {py::float_(1.0), py::float_(2.0)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(add.callPy(args));
+    }
+}
+BENCHMARK(BM_PythonFunctionCallPy);
+
+// 每批 range(0) 次调用；items_per_second 的倒数即单次调用开销
+void BM_CallBatch(benchmark::State& state, cpppy_bridge::BatchMode mode) {
+    cpppy_bridge::PythonFunction add(benchModule(), "add");
+    std::vector<std::tuple<double, double>> batch(static_cast<size_t>(state.range(0)), {1.0, 2.0});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(add.callBatch<double>(batch, mode));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_CallBatch, PerCall, cpppy_bridge::BatchMode::PerCall)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK_CAPTURE(BM_CallBatch, Vectorized, cpppy_bridge::BatchMode::Vectorized)->Arg(1)->Arg(64)->Arg(4096);
+
+void BM_VectorToNumpy(benchmark::State& state) {
+    std::vector<double> values(static_cast<size_t>(state.range(0)), 1.5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cpppy_bridge::NumpyConverter::vectorToNumpy(values));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * sizeof(double));
+}
+BENCHMARK(BM_VectorToNumpy)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+void BM_NumpyToVector(benchmark::State& state) {
+    auto array = cpppy_bridge::NumpyConverter::vectorToNumpy(
+        std::vector<double>(static_cast<size_t>(state.range(0)), 1.5));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cpppy_bridge::NumpyConverter::numpyToVector<double>(array));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * sizeof(double));
+}
+BENCHMARK(BM_NumpyToVector)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+void BM_Matrix2DToNumpy(benchmark::State& state) {
+    const size_t dim = static_cast<size_t>(state.range(0));
+    std::vector<std::vector<double>> matrix(dim, std::vector<double>(dim, 0.5));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cpppy_bridge::NumpyConverter::matrix2DToNumpy(matrix));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * state.range(0) * sizeof(double));
+}
+BENCHMARK(BM_Matrix2DToNumpy)->RangeMultiplier(4)->Range(4, 1024);
+
+void BM_MapFromPython(benchmark::State& state) {
+    py::object dict = benchModule()->callFunction<py::object>("make_dict", state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cpppy_bridge::ComplexTypeConverter::mapFromPython<std::string, double>(dict));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MapFromPython)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+// 2D 转换：每行一次堆分配 vs 请求级单调内存池
+void BM_NumpyToMatrix2D(benchmark::State& state) {
+    const size_t dim = static_cast<size_t>(state.range(0));
+    auto array = cpppy_bridge::NumpyConverter::matrix2DToNumpy(
+        std::vector<std::vector<double>>(dim, std::vector<double>(dim, 0.5)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cpppy_bridge::NumpyConverter::numpyToMatrix2D<double>(array));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * state.range(0) * sizeof(double));
+}
+BENCHMARK(BM_NumpyToMatrix2D)->RangeMultiplier(4)->Range(4, 1024);
+
+void BM_NumpyToMatrix2DArena(benchmark::State& state) {
+    const size_t dim = static_cast<size_t>(state.range(0));
+    auto array = cpppy_bridge::NumpyConverter::matrix2DToNumpy(
+        std::vector<std::vector<double>>(dim, std::vector<double>(dim, 0.5)));
+    cpppy_bridge::ConversionArena arena(dim * (dim + 4) * sizeof(double));
+    for (auto _ : state) {
+        {
+            auto rows = cpppy_bridge::NumpyConverter::numpyToMatrix2D<double>(array, &arena);
+            benchmark::DoNotOptimize(rows.data());
+        }
+        arena.release();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * state.range(0) * sizeof(double));
+}
+BENCHMARK(BM_NumpyToMatrix2DArena)->RangeMultiplier(4)->Range(4, 1024);
+
+void BM_MapFromPythonArena(benchmark::State& state) {
+    py::object dict = benchModule()->callFunction<py::object>("make_dict", state.range(0));
+    cpppy_bridge::ConversionArena arena;
+    for (auto _ : state) {
+        {
+            auto map = cpppy_bridge::ComplexTypeConverter::mapFromPython<std::string, double>(dict, &arena);
+            benchmark::DoNotOptimize(map.size());
+        }
+        arena.release();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MapFromPythonArena)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+// 统计量：经解释器调用 NumPy 与 C++ 内核对比
+void BM_ArrayStatsPython(benchmark::State& state) {
+    auto module = benchModule();
+    auto array = cpppy_bridge::NumpyConverter::vectorToNumpy(std::vector<double>(static_cast<size_t>(state.range(0)), 1.5));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(module->callFunction<std::map<std::string, double>>("array_stats", array));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * sizeof(double));
+}
+BENCHMARK(BM_ArrayStatsPython)->RangeMultiplier(32)->Range(32, 1 << 22);
+
+void BM_ArrayStatsKernels(benchmark::State& state) {
+    auto array = cpppy_bridge::NumpyConverter::vectorToNumpy(std::vector<double>(static_cast<size_t>(state.range(0)), 1.5));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cpppy_bridge::NumpyKernels::stats(array));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * sizeof(double));
+    state.SetLabel(cpppy_bridge::NumpyKernels::simdLevelName(cpppy_bridge::NumpyKernels::simdLevel()));
+}
+BENCHMARK(BM_ArrayStatsKernels)->RangeMultiplier(32)->Range(32, 1 << 22);
+
+// 类型检查失败路径：旧实现 obj.cast<T>() + catch 作为基线
+void BM_CanConvertMissThrowing(benchmark::State& state) {
+    py::object text = py::str("not a number");
+    for (auto _ : state) {
+        bool ok = true;
+        try {
+            text.cast<double>();
+        } catch (const py::cast_error&) {
+            ok = false;
+        }
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK(BM_CanConvertMissThrowing);
+
+void BM_CanConvertMiss(benchmark::State& state) {
+    py::object text = py::str("not a number");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cpppy_bridge::TypeConverter::canConvert<double>(text));
+    }
+}
+BENCHMARK(BM_CanConvertMiss);
+
+using BenchPayload = std::variant<std::vector<double>, std::map<std::string, double>, double, std::string>;
+
+py::list benchPayloads() {
+    py::list payloads;
+    payloads.append(py::str("label"));
+    payloads.append(py::float_(2.5));
+    payloads.append(py::dict(py::arg("a") = 1.0));
+    payloads.append(py::make_tuple(1.0, 2.0));
+    return payloads;
+}
+
+// 逐个尝试转换并捕获异常，作为 variantFromPython 的基线
+void BM_VariantTrialCast(benchmark::State& state) {
+    py::list payloads = benchPayloads();
+    for (auto _ : state) {
+        for (py::handle item : payloads) {
+            py::object obj = py::reinterpret_borrow<py::object>(item);
+            BenchPayload value;
+            try {
+                value = obj.cast<std::vector<double>>();
+            } catch (const py::cast_error&) {
+                try {
+                    value = obj.cast<std::map<std::string, double>>();
+                } catch (const py::cast_error&) {
+                    try {
+                        value = obj.cast<double>();
+                    } catch (const py::cast_error&) {
+                        value = obj.cast<std::string>();
+                    }
+                }
+            }
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 4);
+}
+BENCHMARK(BM_VariantTrialCast);
+
+void BM_VariantFromPython(benchmark::State& state) {
+    py::list payloads = benchPayloads();
+    for (auto _ : state) {
+        for (py::handle item : payloads) {
+            benchmark::DoNotOptimize(cpppy_bridge::TypeConverter::fromPython<BenchPayload>(
+                py::reinterpret_borrow<py::object>(item)));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 4);
+}
+BENCHMARK(BM_VariantFromPython);
+
+// 异常路径：Python 异常经 ErrorHandler 提取、分发并转换为 C++ 异常
+void BM_ExceptionPath(benchmark::State& state) {
+    auto module = benchModule();
+    cpppy_bridge::ErrorHandler::setErrorLogging(false);
+    for (auto _ : state) {
+        try {
+            module->callFunction<void>("fail");
+        } catch (const cpppy_bridge::PythonBridgeException& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+    cpppy_bridge::ErrorHandler::setErrorLogging(true);
+}
+BENCHMARK(BM_ExceptionPath);
+
+bool hasFlag(int argc, char** argv, const char* prefix) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], prefix, std::strlen(prefix)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--startup-probe") == 0) {
+        auto start = std::chrono::steady_clock::now();
+        cpppy_bridge::PythonInterpreter::getInstance().initialize();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "startup_ns="
+                  << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() << std::endl;
+        return 0;
+    }
+    g_self_path = argv[0];
+
+    // 默认同时写出 JSON 结果，便于跟踪历史趋势
+    std::vector<char*> args(argv, argv + argc);
+    std::string out_flag = "--benchmark_out=bridge_benchmarks.json";
+    std::string format_flag = "--benchmark_out_format=json";
+    if (!hasFlag(argc, argv, "--benchmark_out=")) {
+        args.push_back(&out_flag[0]);
+    }
+    if (!hasFlag(argc, argv, "--benchmark_out_format=")) {
+        args.push_back(&format_flag[0]);
+    }
+    int args_count = static_cast<int>(args.size());
+
+    benchmark::Initialize(&args_count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(args_count, args.data())) {
+        return 1;
+    }
+
+    {
+        std::ofstream module_file(std::string(kBenchModuleName) + ".py");
+        module_file << kBenchModuleSource;
+    }
+    g_bridge = std::make_unique<cpppy_bridge::PythonBridge>();
+    if (!g_bridge->initialize()) {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    g_module.reset();
+    g_bridge.reset();
+
+    std::remove((std::string(kBenchModuleName) + ".py").c_str());
+    return 0;
+}
@@ -1,4 +1,7 @@
 #include "cpp_library.h"
+#include <cstdio>
+#include <cstring>
+#include <mutex>
 #include <stdexcept>
 
 namespace example_lib {
@@ -13,6 +16,12 @@ double MathCalculator::divide(double a, double b) {
     return a / b;
 }
 
+void MathCalculator::add_many(const double* a, const double* b, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = a[i] + b[i];
+    }
+}
+
 std::string StringProcessor::concatenate(const std::string& a, const std::string& b) {
     return a + b;
 }
@@ -22,21 +31,66 @@ int StringProcessor::get_length(const std::string& s) {
 }
 
 void DataContainer::add_data(const std::string& key, int value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     data_[key] = value;
 }
 
+void DataContainer::add_data_many(const std::vector<std::string>& keys, const int* values, size_t count) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (size_t i = 0; i < count && i < keys.size(); ++i) {
+        data_[keys[i]] = values[i];
+    }
+}
+
 int DataContainer::get_data(const std::string& key) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     return data_.at(key);
 }
 
 std::map<std::string, int> DataContainer::get_all_data() {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     return data_;
 }
 
+size_t DataContainer::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return data_.size();
+}
+
+bool DataContainer::contains(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return data_.count(key) > 0;
+}
+
+std::optional<int> DataContainer::find(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = data_.find(key);
+    if (it == data_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::optional<std::pair<std::string, int>> DataContainer::next_entry(const std::string* previous) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = previous ? data_.upper_bound(*previous) : data_.begin();
+    if (it == data_.end()) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
 void CallbackExample::execute_callback(CallbackType callback) {
     callback("Hello from C++");
 }
 
+void CallbackExample::fill_event(EventRecord& record, uint64_t sequence) {
+    record.sequence = sequence;
+    record.value = static_cast<double>(sequence) * 0.5;
+    std::memset(record.message, 0, sizeof(record.message));
+    std::snprintf(record.message, sizeof(record.message), "event %llu", static_cast<unsigned long long>(sequence));
+}
+
 std::string global_function_example(const std::string& input) {
     return "Processed: " + input;
 }
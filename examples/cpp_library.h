@@ -4,6 +4,10 @@
 #include <vector>
 #include <functional>
 #include <map>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
 
 namespace example_lib {
 
@@ -13,6 +17,9 @@ public:
     double subtract(double a, double b);
     double multiply(double a, double b);
     double divide(double a, double b);
+
+    // Element-wise out[i] = a[i] + b[i]
+    void add_many(const double* a, const double* b, double* out, size_t count);
 };
 
 class StringProcessor {
@@ -21,21 +28,76 @@ public:
     int get_length(const std::string& s);
 };
 
+// Thread-safe: the Python bindings call into it with the GIL released
 class DataContainer {
 public:
     void add_data(const std::string& key, int value);
+    void add_data_many(const std::vector<std::string>& keys, const int* values, size_t count);
     int get_data(const std::string& key);
     std::map<std::string, int> get_all_data();
+
+    size_t size() const;
+    bool contains(const std::string& key) const;
+    std::optional<int> find(const std::string& key) const;
+
+    // Entry following previous in key order (the first entry for nullptr)
+    std::optional<std::pair<std::string, int>> next_entry(const std::string* previous) const;
+
 private:
     std::map<std::string, int> data_;
+    mutable std::shared_mutex mutex_;
+};
+
+// Fixed-size event record, delivered to batch consumers as raw memory
+struct EventRecord {
+    uint64_t sequence;
+    double value;
+    char message[48];   // NUL-padded
 };
+static_assert(sizeof(EventRecord) == 64, "EventRecord layout is part of the Python buffer format");
 
 class CallbackExample {
 public:
     using CallbackType = std::function<void(const std::string&)>;
     void execute_callback(CallbackType callback);
+
+    // Invoke callback(const char* message, size_t length) once per event
+    template<typename Callback>
+    void stream_messages(size_t count, Callback&& callback);
+
+    // Fill a reused buffer of up to batch_size records and invoke
+    // sink(const EventRecord* records, size_t count) once per batch
+    template<typename Sink>
+    void stream_events(size_t count, size_t batch_size, Sink&& sink);
+
+private:
+    static void fill_event(EventRecord& record, uint64_t sequence);
 };
 
 std::string global_function_example(const std::string& input);
 
-}
\ No newline at end of file
+template<typename Callback>
+void CallbackExample::stream_messages(size_t count, Callback&& callback) {
+    EventRecord record;
+    for (size_t i = 0; i < count; ++i) {
+        fill_event(record, i);
+        callback(static_cast<const char*>(record.message), std::char_traits<char>::length(record.message));
+    }
+}
+
+template<typename Sink>
+void CallbackExample::stream_events(size_t count, size_t batch_size, Sink&& sink) {
+    if (batch_size == 0) {
+        batch_size = 1;
+    }
+    std::vector<EventRecord> ring(batch_size < count ? batch_size : count);
+    for (size_t produced = 0; produced < count;) {
+        size_t n = 0;
+        for (; n < ring.size() && produced < count; ++n, ++produced) {
+            fill_event(ring[n], produced);
+        }
+        sink(static_cast<const EventRecord*>(ring.data()), n);
+    }
+}
+
+}
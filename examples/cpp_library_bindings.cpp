@@ -0,0 +1,265 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "cpp_library.h"
+
+namespace py = pybind11;
+using example_lib::DataContainer;
+
+namespace {
+
+using release_gil = py::call_guard<py::gil_scoped_release>;
+
+// Validate a 1-D contiguous buffer of T and return its element count
+template<typename T>
+size_t checkVector(const py::buffer_info& info, const char* name) {
+    if (info.ndim != 1) {
+        throw std::invalid_argument(std::string(name) + " must be one-dimensional");
+    }
+    if (info.format != py::format_descriptor<T>::format() || info.itemsize != static_cast<py::ssize_t>(sizeof(T))) {
+        throw std::invalid_argument(std::string(name) + " has format '" + info.format +
+                                    "', expected '" + py::format_descriptor<T>::format() + "'");
+    }
+    if (info.shape[0] > 1 && info.strides[0] != static_cast<py::ssize_t>(sizeof(T))) {
+        throw std::invalid_argument(std::string(name) + " must be contiguous");
+    }
+    return static_cast<size_t>(info.shape[0]);
+}
+
+/**
+ * @brief Python callable invoked through vectorcall
+ * Holds the callable's PyObject* and calls it directly with the GIL already
+ * held, bypassing pybind11's std::function wrapper, which reacquires the GIL
+ * and goes through generic argument casting on every invocation.
+ */
+class VectorcallCallback {
+public:
+    explicit VectorcallCallback(py::object callable) : callable_(std::move(callable)) {}
+
+    // arg is borrowed
+    void operator()(PyObject* arg) const {
+#if PY_VERSION_HEX >= 0x03090000
+        PyObject* argv[2] = {nullptr, arg};
+        PyObject* result = PyObject_Vectorcall(callable_.ptr(), argv + 1, 1 | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr);
+#else
+        PyObject* result = PyObject_CallFunctionObjArgs(callable_.ptr(), arg, nullptr);
+#endif
+        if (!result) {
+            throw py::error_already_set();
+        }
+        Py_DECREF(result);
+    }
+
+private:
+    py::object callable_;
+};
+
+// struct-module format of example_lib::EventRecord (native alignment)
+constexpr const char* kEventRecordFormat = "Qd48s";
+
+/**
+ * @brief Live read-only mapping over a DataContainer
+ * Lookups go straight to the C++ map and iteration walks it in key order one
+ * entry at a time, so nothing is copied up front. Iterators resume after the
+ * last key they returned and therefore tolerate concurrent inserts.
+ */
+class DataView {
+public:
+    enum class Kind { Keys, Values, Items };
+
+    class Iterator {
+    public:
+        Iterator(const DataContainer& container, Kind kind) : container_(&container), kind_(kind) {}
+
+        py::object next() {
+            auto entry = container_->next_entry(started_ ? &last_ : nullptr);
+            if (!entry) {
+                throw py::stop_iteration();
+            }
+            started_ = true;
+            last_ = entry->first;
+            switch (kind_) {
+                case Kind::Keys: return py::str(entry->first);
+                case Kind::Values: return py::int_(entry->second);
+                default: return py::make_tuple(entry->first, entry->second);
+            }
+        }
+
+    private:
+        const DataContainer* container_;
+        Kind kind_;
+        std::string last_;
+        bool started_ = false;
+    };
+
+    explicit DataView(const DataContainer& container) : container_(&container) {}
+
+    int getItem(const std::string& key) const {
+        auto value = container_->find(key);
+        if (!value) {
+            throw py::key_error(key);
+        }
+        return *value;
+    }
+
+    py::object get(const std::string& key, py::object fallback) const {
+        auto value = container_->find(key);
+        if (!value) {
+            return fallback;
+        }
+        return py::int_(*value);
+    }
+
+    size_t size() const { return container_->size(); }
+    bool contains(const std::string& key) const { return container_->contains(key); }
+    Iterator iterate(Kind kind) const { return Iterator(*container_, kind); }
+
+private:
+    const DataContainer* container_;
+};
+
+/**
+ * @brief Python-owned copy of one batch of EventRecord structs
+ * Exposed through the buffer protocol, so a memoryview over it (and any slice
+ * or array derived from it) keeps the batch alive on its own instead of
+ * pointing into the producer's reused buffer.
+ */
+class EventBatch {
+public:
+    EventBatch(const example_lib::EventRecord* records, size_t count) : records_(records, records + count) {}
+
+    py::buffer_info buffer() const {
+        return py::buffer_info(const_cast<example_lib::EventRecord*>(records_.data()),
+                               static_cast<py::ssize_t>(sizeof(example_lib::EventRecord)), kEventRecordFormat,
+                               1, {static_cast<py::ssize_t>(records_.size())},
+                               {static_cast<py::ssize_t>(sizeof(example_lib::EventRecord))}, true);
+    }
+
+    size_t size() const { return records_.size(); }
+
+private:
+    std::vector<example_lib::EventRecord> records_;
+};
+
+} // namespace
+
+PYBIND11_MODULE(example_cpp_lib_module, m) {
+    m.doc() = "Python bindings for the example C++ library";
+
+    // Scalar arithmetic is cheaper than a GIL handoff, so only the bulk
+    // entry points release it
+    py::class_<example_lib::MathCalculator>(m, "MathCalculator")
+        .def(py::init<>())
+        .def("add", &example_lib::MathCalculator::add)
+        .def("subtract", &example_lib::MathCalculator::subtract)
+        .def("multiply", &example_lib::MathCalculator::multiply)
+        .def("divide", &example_lib::MathCalculator::divide)
+        .def("add_many", [](example_lib::MathCalculator& self, py::buffer a, py::buffer b) {
+            py::buffer_info a_info = a.request();
+            py::buffer_info b_info = b.request();
+            const size_t count = checkVector<double>(a_info, "a");
+            if (checkVector<double>(b_info, "b") != count) {
+                throw std::invalid_argument("a and b must have the same length");
+            }
+
+            py::array_t<double> out(static_cast<py::ssize_t>(count));
+            double* out_data = out.mutable_data();
+            {
+                py::gil_scoped_release release;
+                self.add_many(static_cast<const double*>(a_info.ptr), static_cast<const double*>(b_info.ptr),
+                              out_data, count);
+            }
+            return out;
+        }, py::arg("a"), py::arg("b"), "Element-wise sum of two float64 buffers");
+
+    py::class_<example_lib::StringProcessor>(m, "StringProcessor")
+        .def(py::init<>())
+        .def("concatenate", &example_lib::StringProcessor::concatenate, release_gil())
+        .def("get_length", &example_lib::StringProcessor::get_length);
+
+    py::class_<DataView::Iterator>(m, "DataViewIterator")
+        .def("__iter__", [](DataView::Iterator& self) -> DataView::Iterator& { return self; })
+        .def("__next__", &DataView::Iterator::next);
+
+    py::class_<DataView>(m, "DataView")
+        .def("__getitem__", &DataView::getItem)
+        .def("get", &DataView::get, py::arg("key"), py::arg("default") = py::none())
+        .def("__len__", &DataView::size)
+        .def("__contains__", &DataView::contains)
+        .def("__iter__", [](const DataView& self) { return self.iterate(DataView::Kind::Keys); },
+             py::keep_alive<0, 1>())
+        .def("keys", [](const DataView& self) { return self.iterate(DataView::Kind::Keys); },
+             py::keep_alive<0, 1>())
+        .def("values", [](const DataView& self) { return self.iterate(DataView::Kind::Values); },
+             py::keep_alive<0, 1>())
+        .def("items", [](const DataView& self) { return self.iterate(DataView::Kind::Items); },
+             py::keep_alive<0, 1>());
+    py::module::import("collections.abc").attr("Mapping").attr("register")(m.attr("DataView"));
+
+    py::class_<DataContainer>(m, "DataContainer")
+        .def(py::init<>())
+        .def("add_data", &DataContainer::add_data)
+        .def("add_data_many", [](DataContainer& self, const std::vector<std::string>& keys, py::buffer values) {
+            py::buffer_info info = values.request();
+            if (checkVector<int>(info, "values") != keys.size()) {
+                throw std::invalid_argument("keys and values must have the same length");
+            }
+            // The exported buffer stays locked until info is released
+            py::gil_scoped_release release;
+            self.add_data_many(keys, static_cast<const int*>(info.ptr), keys.size());
+        }, py::arg("keys"), py::arg("values"), "Insert keys with values from an int32 buffer")
+        .def("get_data", &DataContainer::get_data)
+        .def("get_all_data", &DataContainer::get_all_data, "Copy of all entries as a dict (prefer `data`)")
+        .def_property_readonly("data",
+                               py::cpp_function([](const DataContainer& self) { return DataView(self); },
+                                                py::keep_alive<0, 1>()),
+                               "Live read-only mapping view of the entries")
+        .def("__len__", &DataContainer::size);
+
+    // The Python callback reacquires the GIL through the std::function wrapper
+    py::class_<example_lib::CallbackExample>(m, "CallbackExample")
+        .def(py::init<>())
+        .def("execute_callback", &example_lib::CallbackExample::execute_callback, release_gil())
+        .def("stream_messages", [](example_lib::CallbackExample& self, size_t count, py::object callback) {
+            // Typed per-record path: the GIL stays held for the whole stream
+            VectorcallCallback deliver(std::move(callback));
+            self.stream_messages(count, [&deliver](const char* message, size_t length) {
+                py::object text = py::reinterpret_steal<py::object>(
+                    PyUnicode_FromStringAndSize(message, static_cast<py::ssize_t>(length)));
+                if (!text) {
+                    throw py::error_already_set();
+                }
+                deliver(text.ptr());
+            });
+        }, py::arg("count"), py::arg("callback"), "Call callback(message) once per event")
+        .def("stream_events", [](example_lib::CallbackExample& self, size_t count, py::object callback,
+                                 size_t batch_size) {
+            VectorcallCallback deliver(std::move(callback));
+            // Records are produced without the GIL; it is taken once per batch
+            py::gil_scoped_release release;
+            self.stream_events(count, batch_size, [&deliver](const example_lib::EventRecord* records, size_t n) {
+                // The producer refills its buffer for the next batch, so the
+                // batch is copied (still without the GIL) and owned by Python
+                auto batch = std::make_unique<EventBatch>(records, n);
+                py::gil_scoped_acquire gil;
+                py::object owner = py::cast(std::move(batch));
+                py::object view = py::reinterpret_steal<py::object>(PyMemoryView_FromObject(owner.ptr()));
+                if (!view) {
+                    throw py::error_already_set();
+                }
+                deliver(view.ptr());
+            });
+        }, py::arg("count"), py::arg("callback"), py::arg("batch_size") = 1024,
+           "Call callback(memoryview) once per batch of EventRecord structs");
+    py::class_<EventBatch>(m, "EventBatch", py::buffer_protocol())
+        .def_buffer(&EventBatch::buffer)
+        .def("__len__", &EventBatch::size);
+    m.attr("EVENT_RECORD_FORMAT") = kEventRecordFormat;
+
+    m.def("global_function_example", &example_lib::global_function_example, release_gil());
+}
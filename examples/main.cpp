@@ -3,9 +3,12 @@
 #include <map>
 #include <string>
 #include <chrono>
+#include <algorithm>
+#include <tuple>
 #include "python_bridge.h"
 #include "type_converter.h"
 #include "error_handler.h"
+#include "typed_function.h"
 
 void demonstrateBasicFunctions() {
     std::cout << "\n=== Basic Function Call Demonstration ===" << std::endl;
@@ -99,6 +102,29 @@ void demonstrateContainerOperations() {
             std::cout << "]" << std::endl;
         }
         
+        // Contiguous Matrix<T> crosses the bridge as a zero-copy NumPy array
+        cpppy_bridge::Matrix<double> dense_a(2, 2, true);
+        cpppy_bridge::Matrix<double> dense_b(2, 2, true);
+        for (size_t i = 0; i < 2; ++i) {
+            for (size_t j = 0; j < 2; ++j) {
+                dense_a(i, j) = matrix_a[i][j];
+                dense_b(i, j) = matrix_b[i][j];
+            }
+        }
+        
+        auto dense_result = math_module->callFunction<cpppy_bridge::Matrix<double>>(
+            "matrix_multiply", dense_a, dense_b);
+        
+        std::cout << "Matrix<double> multiplication result:" << std::endl;
+        for (size_t i = 0; i < dense_result.rows(); ++i) {
+            std::cout << "[";
+            for (size_t j = 0; j < dense_result.cols(); ++j) {
+                std::cout << dense_result(i, j);
+                if (j < dense_result.cols() - 1) std::cout << ", ";
+            }
+            std::cout << "]" << std::endl;
+        }
+        
     } catch (const std::exception& e) {
         std::cerr << "Error in container operations demo: " << e.what() << std::endl;
     }
@@ -139,6 +165,19 @@ void demonstrateComplexDataStructures() {
             }
         }
         
+        // Columnar interchange: equally sized columns cross as one Arrow record batch
+        std::map<std::string, std::vector<double>> columns = {
+            {"price", {10.0, 10.5, 11.0, 10.75}},
+            {"volume", {1200.0, 900.0, 1500.0, 1100.0}}
+        };
+        py::object batch = cpppy_bridge::ColumnarConverter::mapToArrow(std::move(columns));
+        auto columnar_result = math_module->callFunction<std::map<std::string, std::map<std::string, double>>>("process_data", batch);
+        
+        std::cout << "\nColumnar batch statistics:" << std::endl;
+        for (const auto& pair : columnar_result) {
+            std::cout << "  " << pair.first << " average: " << pair.second.at("average") << std::endl;
+        }
+        
         // Get system information
         std::cout << "\nSystem Information:" << std::endl;
         py::object sys_info = math_module->callFunction<py::object>("get_system_info");
@@ -156,8 +195,8 @@ void demonstrateComplexDataStructures() {
 void demonstrateErrorHandling() {
     std::cout << "\n=== Error Handling Demonstration ===" << std::endl;
     
-    // Set up an error callback
-    cpppy_bridge::ErrorHandler::addErrorCallback([](const cpppy_bridge::PythonErrorInfo& info) {
+    // Set up an error callback for the duration of this demonstration
+    cpppy_bridge::ScopedErrorHandler error_callback([](const cpppy_bridge::PythonErrorInfo& info) {
         std::cout << "Custom error handler triggered:" << std::endl;
         std::cout << "  Type: " << info.type << std::endl;
         std::cout << "  Message: " << info.message << std::endl;
@@ -247,6 +286,41 @@ void demonstrateFunctionWrapper() {
         std::cout << "1000 function calls took: " << duration.count() << " microseconds" << std::endl;
         std::cout << "Average per call: " << duration.count() / 1000.0 << " microseconds" << std::endl;
         
+        // Fixed-signature calls through vectorcall
+        cpppy_bridge::TypedFunction<double(double, double)> typed_add(bridge.loadModule("math_operations"), "add");
+        auto typed_start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 1000; ++i) {
+            typed_add(i * 0.1, (i + 1) * 0.1);
+        }
+        auto typed_end = std::chrono::high_resolution_clock::now();
+        
+        auto typed_duration = std::chrono::duration_cast<std::chrono::microseconds>(typed_end - typed_start);
+        std::cout << "1000 TypedFunction calls took: " << typed_duration.count() << " microseconds" << std::endl;
+        
+        // Batched calls amortize GIL acquisition and argument marshalling
+        std::cout << "\nBatched call overhead:" << std::endl;
+        for (size_t batch_size : {size_t(1), size_t(64), size_t(4096)}) {
+            std::vector<std::tuple<double, double>> batch;
+            batch.reserve(batch_size);
+            for (size_t i = 0; i < batch_size; ++i) {
+                batch.emplace_back(i * 0.1, (i + 1) * 0.1);
+            }
+            
+            for (auto mode : {cpppy_bridge::BatchMode::PerCall, cpppy_bridge::BatchMode::Vectorized}) {
+                const int rounds = static_cast<int>(std::max<size_t>(1, 16384 / batch_size));
+                auto batch_start = std::chrono::high_resolution_clock::now();
+                for (int r = 0; r < rounds; ++r) {
+                    add_func.callBatch<double>(batch, mode);
+                }
+                auto batch_end = std::chrono::high_resolution_clock::now();
+                
+                double total_ns = std::chrono::duration<double, std::nano>(batch_end - batch_start).count();
+                std::cout << "  batch=" << batch_size
+                          << (mode == cpppy_bridge::BatchMode::PerCall ? " per-call:   " : " vectorized: ")
+                          << total_ns / (rounds * batch_size) << " ns/call" << std::endl;
+            }
+        }
+        
     } catch (const std::exception& e) {
         std::cerr << "Error in function wrapper demo: " << e.what() << std::endl;
     }
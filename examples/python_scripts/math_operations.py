@@ -13,6 +13,14 @@ def add(a: float, b: float) -> float:
     return a + b
 
 
+def _add_vectorized(calls: List[Tuple[float, float]]) -> List[float]:
+    """add 的批量版本，供 PythonFunction::callBatch 的 Vectorized 模式使用"""
+    return [a + b for a, b in calls]
+
+
+add.__vectorized__ = _add_vectorized
+
+
 def multiply(a: float, b: float) -> float:
     """简单乘法运算"""
     return a * b
@@ -61,6 +69,14 @@ def average_list(numbers: List[float]) -> float:
 
 def matrix_multiply(matrix_a: List[List[float]], matrix_b: List[List[float]]) -> List[List[float]]:
     """矩阵乘法"""
+    if isinstance(matrix_a, np.ndarray) and isinstance(matrix_b, np.ndarray):
+        # C++ 端的 Matrix<T> 以零拷贝 ndarray 传入，直接使用 NumPy 计算
+        if matrix_a.size == 0 or matrix_b.size == 0:
+            raise ValueError("Matrices cannot be empty")
+        if matrix_a.shape[1] != matrix_b.shape[0]:
+            raise ValueError(f"Cannot multiply matrices: {matrix_a.shape[1]} != {matrix_b.shape[0]}")
+        return matrix_a @ matrix_b
+
     if not matrix_a or not matrix_b:
         raise ValueError("Matrices cannot be empty")
     
@@ -91,11 +107,39 @@ def numpy_operations(arr: np.ndarray) -> Dict[str, float]:
     }
 
 
+def _columns_from_arrow(data):
+    """将实现 Arrow PyCapsule 协议的表转换为 列名 -> NumPy 数组（零拷贝）"""
+    try:
+        import pyarrow as pa
+        batch = pa.record_batch(data)
+        return {name: batch.column(name).to_numpy(zero_copy_only=True) for name in batch.schema.names}
+    except (ImportError, TypeError):
+        # 无 pyarrow（或版本不支持 PyCapsule 协议）时使用桥接表自带的列视图
+        return {name: data.column(name) for name in data.column_names}
+
+
 def process_data(data: Dict[str, List[float]]) -> Dict[str, Dict[str, float]]:
     """处理复杂数据结构"""
     result = {}
     
+    if hasattr(data, "__arrow_c_array__"):
+        data = _columns_from_arrow(data)
+    
     for key, values in data.items():
+        if isinstance(values, np.ndarray):
+            # 连续缓冲区直接用 NumPy 求统计量，避免逐元素装箱
+            if values.size == 0:
+                result[key] = {"error": "empty_list"}
+                continue
+            result[key] = {
+                "count": int(values.size),
+                "sum": float(values.sum()),
+                "average": float(values.mean()),
+                "min": float(values.min()),
+                "max": float(values.max())
+            }
+            continue
+
         if not values:
             result[key] = {"error": "empty_list"}
             continue
@@ -52,6 +52,11 @@ def test_math_operations(example_cpp_lib):
     
     result = calc.multiply(5, 7)
     print(f"  multiply(5, 7) = {result}")
+    
+    # Bulk entry point: reads both buffers in place and runs without the GIL
+    from array import array
+    sums = calc.add_many(array('d', [1.0, 2.0, 3.0]), array('d', [10.0, 20.0, 30.0]))
+    print(f"  add_many([1, 2, 3], [10, 20, 30]) = {list(sums)}")
 
 def test_string_processing(example_cpp_lib):
     """Tests string processing functions."""
@@ -73,6 +78,18 @@ def test_data_container(example_cpp_lib):
     
     print(f"  get_data('item1') = {container.get_data('item1')}")
     print(f"  get_all_data() = {container.get_all_data()}")
+    
+    # Live view: lookups and iteration read the C++ map directly
+    data = container.data
+    container.add_data("item3", 300)
+    print(f"  data['item3'] = {data['item3']}, len(data) = {len(data)}")
+    print(f"  items = {list(data.items())}")
+    
+    # Batch insert from an int32 buffer
+    from array import array
+    keys = [f"bulk{i}" for i in range(1000)]
+    container.add_data_many(keys, array('i', range(1000)))
+    print(f"  len after add_data_many = {len(container)}, 'bulk999' in data = {'bulk999' in data}")
 
 def test_callbacks(example_cpp_lib):
     """Tests callback functions."""
@@ -83,6 +100,28 @@ def test_callbacks(example_cpp_lib):
 
     callback_handler = example_cpp_lib.CallbackExample()
     callback_handler.execute_callback(python_callback)
+    
+    # Per-record fast path: one vectorcall per event, no GIL round trips
+    messages = []
+    callback_handler.stream_messages(5, messages.append)
+    print(f"  stream_messages(5) = {messages}")
+    
+    # Batched path: one call per batch with a memoryview over a copy of the C++ records
+    import struct
+    totals = {"records": 0, "value": 0.0}
+    heads = []
+    def on_batch(view):
+        for sequence, value, message in struct.iter_unpack(example_cpp_lib.EVENT_RECORD_FORMAT, view):
+            totals["records"] += 1
+            totals["value"] += value
+        heads.append(view[0:2])
+    callback_handler.stream_events(10000, on_batch, batch_size=1024)
+    print(f"  stream_events(10000) -> {totals['records']} records, value sum = {totals['value']}")
+
+    # Slices kept past the callback still see their own batch
+    first = [next(struct.iter_unpack(example_cpp_lib.EVENT_RECORD_FORMAT, head))[0] for head in heads]
+    assert first == list(range(0, 10000, 1024)), first
+    print(f"  retained {len(heads)} batch slices, first sequences intact")
 
 def test_global_functions(example_cpp_lib):
     """Tests global functions."""
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Preallocated small int and float objects
+ * CPython only caches the ints in [-5, 256]; this covers [kMin, kMax) for
+ * ints and for floats with an integral value, so common call arguments are
+ * not allocated. The objects belong to the main interpreter and are released
+ * by clear() when it is finalized; sub-interpreters get fresh objects.
+ * Requires the GIL.
+ */
+class SmallValueCache {
+public:
+    static constexpr long long kMin = -1024;
+    static constexpr long long kMax = 4096;
+
+    static py::object integer(long long value);
+    static py::object floating(double value);
+
+    static void clear();
+};
+
+/**
+ * @brief Reusable argument tuple for dynamic calls
+ * Reserve the slots once and refill them before each call. The tuple is
+ * written in place while nothing else references it; if a callee keeps it
+ * alive (e.g. by storing *args) the next write copies it first. Slots keep
+ * their values between calls, so only changed arguments need to be set.
+ * Requires the GIL.
+ */
+class ArgumentPack {
+public:
+    explicit ArgumentPack(size_t size = 0);
+
+    size_t size() const;
+
+    // Change the number of slots; new slots hold None
+    void resize(size_t size);
+
+    template<typename T>
+    ArgumentPack& set(size_t index, T&& value);
+
+    // Set all slots at once, resizing to the number of arguments
+    template<typename... Args>
+    ArgumentPack& assign(Args&&... args);
+
+    py::object get(size_t index) const;
+
+    // The argument tuple; only valid until the next set()
+    py::handle tuple() const;
+
+    // Call with the current arguments (Python errors propagate as py::error_already_set)
+    py::object call(py::handle callable) const;
+
+    // Number of tuples allocated so far; stays constant in the steady state
+    uint64_t allocations() const;
+
+    // Convert a C++ value the way set() does
+    template<typename T>
+    static py::object toPython(T&& value);
+
+private:
+    void setSlot(size_t index, py::object value);
+    void detach();
+
+    py::object m_tuple;
+    uint64_t m_allocations = 0;
+};
+
+// Template method implementations
+template<typename T>
+py::object ArgumentPack::toPython(T&& value) {
+    using Decayed = std::decay_t<T>;
+    if constexpr (std::is_base_of_v<py::handle, Decayed>) {
+        return py::reinterpret_borrow<py::object>(value);
+    } else if constexpr (std::is_same_v<Decayed, bool>) {
+        return py::bool_(value);
+    } else if constexpr (std::is_integral_v<Decayed>) {
+        if constexpr (std::is_unsigned_v<Decayed> && sizeof(Decayed) >= sizeof(long long)) {
+            if (value > static_cast<Decayed>(std::numeric_limits<long long>::max())) {
+                return py::int_(value);
+            }
+        }
+        return SmallValueCache::integer(static_cast<long long>(value));
+    } else if constexpr (std::is_floating_point_v<Decayed>) {
+        return SmallValueCache::floating(static_cast<double>(value));
+    } else {
+        return py::cast(std::forward<T>(value));
+    }
+}
+
+template<typename T>
+ArgumentPack& ArgumentPack::set(size_t index, T&& value) {
+    setSlot(index, toPython(std::forward<T>(value)));
+    return *this;
+}
+
+template<typename... Args>
+ArgumentPack& ArgumentPack::assign(Args&&... args) {
+    if (size() != sizeof...(Args)) {
+        resize(sizeof...(Args));
+    }
+    size_t index = 0;
+    (setSlot(index++, toPython(std::forward<Args>(args))), ...);
+    return *this;
+}
+
+} // namespace cpppy_bridge
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <pybind11/pybind11.h>
+#include "python_bridge.h"
+#include "error_handler.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define CPPPY_HAS_COROUTINES 1
+#else
+#define CPPPY_HAS_COROUTINES 0
+#endif
+
+namespace py = pybind11;
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Shared asyncio event loop
+ * A single long-lived loop runs on a dedicated thread of the main
+ * interpreter. Awaitables submitted from any thread are scheduled with
+ * asyncio.run_coroutine_threadsafe and multiplexed on it, so thousands of
+ * pending coroutines cost no C++ threads. The loop is started on first use
+ * and stopped by PythonInterpreter::finalize(), which cancels whatever is
+ * still pending.
+ */
+class AsyncLoop {
+public:
+    // Invoked with the GIL held once the scheduled awaitable finished; receives
+    // the concurrent.futures.Future
+    using Completion = std::function<void(py::handle future)>;
+
+    static AsyncLoop& getInstance();
+
+    AsyncLoop(const AsyncLoop&) = delete;
+    AsyncLoop& operator=(const AsyncLoop&) = delete;
+
+    // Start the loop thread if it is not running (the GIL is released while waiting)
+    void start();
+
+    // Stop the loop and cancel pending coroutines; must not be called from the loop thread
+    void stop();
+
+    bool isRunning() const;
+    size_t pendingCalls() const;
+
+    // The event loop object (GIL held); None while stopped
+    py::object loop() const;
+
+    // Schedule a coroutine or other awaitable (GIL held)
+    void schedule(py::object awaitable, Completion done);
+
+    static bool isAwaitable(const py::handle& object);
+
+private:
+    AsyncLoop() = default;
+    ~AsyncLoop();
+
+    void run(std::shared_ptr<std::promise<void>> started);
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::atomic<bool> m_running{false};
+    std::atomic<size_t> m_pending{0};
+
+    // Owned by the loop thread, read by schedulers; both only with the GIL held
+    py::object m_loop;
+    py::object m_run_threadsafe;
+    py::object m_await_any;
+    py::object m_drain;
+};
+
+namespace detail {
+
+// Completion state shared between the loop callback and AsyncCall
+template<typename ReturnType>
+struct AsyncState {
+    using Value = std::conditional_t<std::is_void_v<ReturnType>, bool, ReturnType>;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool done = false;
+    std::optional<Value> value;
+    std::exception_ptr error;
+    std::function<void()> continuation;
+
+    // Convert the produced result or Python error (GIL held), then complete
+    template<typename Produce>
+    void settle(Produce&& produce);
+
+    // Returns false if already done, in which case the continuation was not stored
+    bool setContinuation(std::function<void()> next);
+
+private:
+    void complete();
+};
+
+} // namespace detail
+
+/**
+ * @brief Pending result of PythonFunction::callAsync
+ * Can be waited on (wait()/get() release the GIL while blocking), chained
+ * with then(), converted to a std::future, or co_awaited in C++20. Awaiting
+ * coroutines and then() callbacks resume on the thread that completed the
+ * call, normally the loop thread, without the GIL; long-running work should
+ * be handed off rather than blocking the loop. Results are consumed once.
+ */
+template<typename ReturnType>
+class AsyncCall {
+public:
+    explicit AsyncCall(std::shared_ptr<detail::AsyncState<ReturnType>> state);
+
+    bool isReady() const;
+
+    // Block until the call finished; must not be used on the loop thread
+    void wait() const;
+
+    // Wait and return the result, rethrowing the converted Python exception
+    ReturnType get();
+
+    // Run callback once finished (immediately if it already is); one per call
+    void then(std::function<void()> callback);
+
+    // Adapt to a std::future. Release the GIL before blocking on it.
+    std::future<ReturnType> toFuture();
+
+#if CPPPY_HAS_COROUTINES
+    bool await_ready() const { return isReady(); }
+    bool await_suspend(std::coroutine_handle<> handle) {
+        return m_state->setContinuation([handle] { handle.resume(); });
+    }
+    ReturnType await_resume() { return get(); }
+#endif
+
+private:
+    std::shared_ptr<detail::AsyncState<ReturnType>> m_state;
+};
+
+// Template method implementations
+namespace detail {
+
+template<typename ReturnType>
+template<typename Produce>
+void AsyncState<ReturnType>::settle(Produce&& produce) {
+    try {
+        py::object result = produce();
+        if constexpr (std::is_void_v<ReturnType>) {
+            value.emplace(true);
+        } else {
+            value.emplace(result.template cast<ReturnType>());
+        }
+    } catch (const py::error_already_set& e) {
+        try {
+            auto error_info = ErrorHandler::handlePythonException(e);
+            ErrorHandler::convertPythonException(error_info);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        if (!error) {
+            error = std::make_exception_ptr(std::runtime_error(e.what()));
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    complete();
+}
+
+template<typename ReturnType>
+bool AsyncState<ReturnType>::setContinuation(std::function<void()> next) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (done) {
+        return false;
+    }
+    if (continuation) {
+        throw std::logic_error("AsyncCall already has a continuation");
+    }
+    continuation = std::move(next);
+    return true;
+}
+
+template<typename ReturnType>
+void AsyncState<ReturnType>::complete() {
+    std::function<void()> next;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        next = std::move(continuation);
+    }
+    ready.notify_all();
+
+    if (next) {
+        // Continuations run C++ code; don't keep the loop's GIL while they do
+        std::optional<py::gil_scoped_release> release;
+        if (PythonInterpreter::holdsGIL()) {
+            release.emplace();
+        }
+        next();
+    }
+}
+
+} // namespace detail
+
+template<typename ReturnType>
+AsyncCall<ReturnType>::AsyncCall(std::shared_ptr<detail::AsyncState<ReturnType>> state)
+    : m_state(std::move(state)) {}
+
+template<typename ReturnType>
+bool AsyncCall<ReturnType>::isReady() const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->done;
+}
+
+template<typename ReturnType>
+void AsyncCall<ReturnType>::wait() const {
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+    std::unique_lock<std::mutex> lock(m_state->mutex);
+    m_state->ready.wait(lock, [this] { return m_state->done; });
+}
+
+template<typename ReturnType>
+ReturnType AsyncCall<ReturnType>::get() {
+    wait();
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    if (m_state->error) {
+        std::rethrow_exception(m_state->error);
+    }
+    if constexpr (std::is_void_v<ReturnType>) {
+        return;
+    } else {
+        return std::move(*m_state->value);
+    }
+}
+
+template<typename ReturnType>
+void AsyncCall<ReturnType>::then(std::function<void()> callback) {
+    if (!m_state->setContinuation(callback)) {
+        callback();
+    }
+}
+
+template<typename ReturnType>
+std::future<ReturnType> AsyncCall<ReturnType>::toFuture() {
+    auto promise = std::make_shared<std::promise<ReturnType>>();
+    std::future<ReturnType> future = promise->get_future();
+    then([state = m_state, promise] {
+        try {
+            AsyncCall<ReturnType> finished(state);
+            if constexpr (std::is_void_v<ReturnType>) {
+                finished.get();
+                promise->set_value();
+            } else {
+                promise->set_value(finished.get());
+            }
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+template<typename ReturnType, typename... Args>
+AsyncCall<ReturnType> PythonFunction::callAsync(Args&&... args) {
+    if (!m_valid) {
+        throw PythonFunctionException(m_func_name, "Invalid function");
+    }
+
+    auto state = std::make_shared<detail::AsyncState<ReturnType>>();
+    py::gil_scoped_acquire gil;
+    try {
+        refreshIfStale();
+        py::object awaitable = m_function(std::forward<Args>(args)...);
+
+        // Plain functions complete immediately
+        if (!AsyncLoop::isAwaitable(awaitable)) {
+            state->settle([&awaitable] { return awaitable; });
+        } else {
+            AsyncLoop::getInstance().schedule(std::move(awaitable), [state](py::handle future) {
+                state->settle([future] { return future.attr("result")(); });
+            });
+        }
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+        throw; // Should not be reached
+    }
+    return AsyncCall<ReturnType>(std::move(state));
+}
+
+} // namespace cpppy_bridge
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Built-in CPython allocator (PyPreConfig.allocator).
+ */
+enum class PythonAllocator {
+    Default,        // pymalloc for the mem and object domains, malloc for raw memory
+    Malloc,         // malloc for every domain, so a process-wide jemalloc/tcmalloc sees all allocations
+    PyMalloc,
+    MallocDebug,    // Variants with the debug hooks (buffer overflow and API misuse checks)
+    PyMallocDebug
+};
+
+/**
+ * @brief CPython allocator setup
+ * Applied by PythonInterpreter::initialize before the interpreter is created,
+ * and only by the first initialization in the process: blocks allocated by one
+ * allocator must never be released by another, and objects can outlive
+ * Py_Finalize. Custom allocators are installed with PyMem_SetAllocator after
+ * preinitialization; their ctx must stay valid until the process exits. The raw
+ * domain is called without the GIL and must be thread-safe.
+ */
+struct AllocatorConfig {
+    PythonAllocator preset = PythonAllocator::Default;
+
+    // Custom allocators per domain; unset domains keep the preset
+    std::optional<PyMemAllocatorEx> raw;
+    std::optional<PyMemAllocatorEx> mem;
+    std::optional<PyMemAllocatorEx> object;
+
+    // Install the debug hooks on top of the custom allocators
+    bool debug_hooks = false;
+
+    bool isDefault() const;
+};
+
+/**
+ * @brief CPython allocator backed by a std::pmr::memory_resource
+ * Adapts a memory resource (e.g. a std::pmr::synchronized_pool_resource
+ * dedicated to the interpreter) to PyMemAllocatorEx. Each block carries a
+ * small header recording its size and capacity, since PyMem_Free does not pass
+ * one; realloc within the capacity (including shrinking) stays in place. The
+ * resource must be thread-safe if it serves the raw domain. Like every custom
+ * allocator it must outlive the interpreter, in practice the process.
+ */
+class ResourceAllocator {
+public:
+    explicit ResourceAllocator(std::pmr::memory_resource* resource);
+
+    ResourceAllocator(const ResourceAllocator&) = delete;
+    ResourceAllocator& operator=(const ResourceAllocator&) = delete;
+
+    // Allocator functions with this object as ctx, for AllocatorConfig
+    PyMemAllocatorEx allocator();
+
+    std::pmr::memory_resource* resource() const;
+
+    // Bytes currently requested through this allocator, excluding headers and unused capacity
+    size_t bytesInUse() const;
+    size_t allocationCount() const;
+
+private:
+    static void* allocate(void* ctx, size_t size);
+    static void* allocateZeroed(void* ctx, size_t count, size_t elem_size);
+    static void* reallocate(void* ctx, void* ptr, size_t new_size);
+    static void deallocate(void* ctx, void* ptr);
+
+    std::pmr::memory_resource* m_resource;
+    std::atomic<size_t> m_bytes_in_use{0};
+    std::atomic<size_t> m_allocations{0};
+};
+
+/**
+ * @brief Request-scoped arena for conversion outputs
+ * A monotonic buffer for the std::pmr conversion overloads: allocation is a
+ * pointer bump, deallocation is a no-op, and everything is returned at once by
+ * release(). The initial buffer is kept across release() calls, so an arena
+ * reused for similar requests stops touching the global heap once it is large
+ * enough. Not thread-safe; use one arena per request or per thread.
+ */
+class ConversionArena : public std::pmr::memory_resource {
+public:
+    explicit ConversionArena(size_t initial_size = 64 * 1024,
+                             std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+    ~ConversionArena() override;
+
+    ConversionArena(const ConversionArena&) = delete;
+    ConversionArena& operator=(const ConversionArena&) = delete;
+
+    // Free everything allocated since the last release; containers using the arena must be gone
+    void release();
+
+    // Bytes handed out since the last release
+    size_t bytesAllocated() const;
+
+    // Largest bytesAllocated() seen, for sizing initial_size
+    size_t peakBytes() const;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::pmr::memory_resource* m_upstream;
+    size_t m_initial_size;
+    void* m_initial_buffer;
+    std::pmr::monotonic_buffer_resource m_buffer;
+    size_t m_bytes = 0;
+    size_t m_peak_bytes = 0;
+};
+
+} // namespace cpppy_bridge
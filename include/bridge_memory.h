@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cpppy_bridge {
+
+namespace detail {
+
+/**
+ * @brief Live-instance counter
+ * Embedded as a member of bridge classes that hold Python objects, so
+ * BridgeMemoryStats can report how many of them are alive without a registry.
+ */
+template<typename Owner>
+class LiveCounter {
+public:
+    LiveCounter() noexcept { s_live.fetch_add(1, std::memory_order_relaxed); }
+    LiveCounter(const LiveCounter&) noexcept : LiveCounter() {}
+    LiveCounter& operator=(const LiveCounter&) noexcept { return *this; }
+    ~LiveCounter() { s_live.fetch_sub(1, std::memory_order_relaxed); }
+
+    static size_t live() { return s_live.load(std::memory_order_relaxed); }
+
+private:
+    static inline std::atomic<size_t> s_live{0};
+};
+
+// Python heap reading shared between a MemorySampler and its pending calls
+struct PythonHeapProbe;
+
+} // namespace detail
+
+/**
+ * @brief Allocation site reported by tracemalloc.
+ */
+struct PythonAllocation {
+    std::string location;    // "file:line" of the most recent frame
+    int64_t bytes = 0;       // Size, or growth since the baseline
+    int64_t blocks = 0;
+};
+
+/**
+ * @brief Top allocation sites of a tracemalloc snapshot.
+ */
+struct TracemallocSnapshot {
+    size_t traced_bytes = 0;
+    size_t peak_bytes = 0;
+    std::vector<PythonAllocation> top;   // Largest first
+};
+
+/**
+ * @brief Python heap counters.
+ */
+struct PythonHeapStats {
+    size_t allocated_blocks = 0;   // sys.getallocatedblocks()
+    size_t traced_bytes = 0;       // tracemalloc, 0 while tracing is off
+    size_t gc_counts[3] = {};      // gc.get_count() per generation
+};
+
+/**
+ * @brief Process-wide native memory.
+ * Values the platform cannot report are 0.
+ */
+struct NativeHeapStats {
+    size_t rss_bytes = 0;             // Resident set size
+    size_t peak_rss_bytes = 0;
+    size_t malloc_in_use_bytes = 0;   // Bytes in use by malloc (includes Python allocations above 512 bytes)
+};
+
+/**
+ * @brief Live bridge objects that keep Python objects or cached data alive.
+ */
+struct LiveObjectCounts {
+    size_t modules = 0;              // PythonModule
+    size_t functions = 0;            // PythonFunction
+    size_t call_handles = 0;         // CallHandle
+    size_t instances = 0;            // PythonObject
+    size_t memo_caches = 0;
+    size_t memo_entries = 0;
+    size_t memo_bytes = 0;
+    size_t code_cache_entries = 0;   // Compiled snippets held by PythonInterpreter
+    size_t error_callbacks = 0;
+    size_t custom_converters = 0;    // Converters retained by CustomTypeRegistry, including replaced ones
+};
+
+/**
+ * @brief One reading of BridgeMemoryStats::sample().
+ */
+struct MemorySample {
+    std::chrono::system_clock::time_point timestamp;
+    PythonHeapStats python;
+    NativeHeapStats native;
+    LiveObjectCounts objects;
+};
+
+/**
+ * @brief Memory instrumentation for long-running embeddings
+ * Combines Python heap counters, native process memory and counts of live
+ * bridge objects, so growth can be attributed to Python allocations, C++
+ * allocations or objects the bridge keeps alive. Allocation sites are
+ * reported by PythonInterpreter's tracemalloc methods.
+ */
+class BridgeMemoryStats {
+public:
+    // No GIL needed
+    static LiveObjectCounts liveObjects();
+    static NativeHeapStats nativeHeap();
+
+    // Acquires the GIL; all zero before the interpreter is initialized
+    static PythonHeapStats pythonHeap();
+
+    static MemorySample sample();
+
+    // Render a sample as Prometheus gauges
+    static std::string exportPrometheus(const MemorySample& sample, const std::string& prefix = "cpppy_bridge");
+};
+
+/**
+ * @brief Periodic memory sampler
+ * Takes a sample on a background thread at a fixed interval, keeps the most
+ * recent ones and passes each to an optional callback (which runs on the
+ * sampler thread without the GIL). The sampler thread never takes the GIL:
+ * native memory and live objects are read directly, and Python heap counters
+ * are only collected while tracemalloc was started through PythonInterpreter.
+ * They are then requested with Py_AddPendingCall, read by the main thread the
+ * next time it runs Python code, and reported by the following sample; while
+ * a request is outstanding, no new one is made and samples keep the previous
+ * reading (all zero until the first one arrives).
+ */
+class MemorySampler {
+public:
+    using Callback = std::function<void(const MemorySample&)>;
+
+    explicit MemorySampler(std::chrono::milliseconds interval = std::chrono::seconds(10),
+                           Callback callback = {}, size_t history = 360);
+    ~MemorySampler();
+
+    MemorySampler(const MemorySampler&) = delete;
+    MemorySampler& operator=(const MemorySampler&) = delete;
+
+    void stop();
+
+    // Retained samples, oldest first
+    std::vector<MemorySample> history() const;
+    std::optional<MemorySample> latest() const;
+
+private:
+    void run();
+    MemorySample takeSample();
+
+    std::chrono::milliseconds m_interval;
+    Callback m_callback;
+    size_t m_history_size;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::deque<MemorySample> m_history;
+    std::shared_ptr<detail::PythonHeapProbe> m_probe;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+} // namespace cpppy_bridge
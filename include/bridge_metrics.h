@@ -0,0 +1,211 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Stage of a bridge call that a timing is attributed to.
+ */
+enum class MetricPhase : uint8_t {
+    Python = 0,         // Wall time spent inside the Python callable
+    GilWait,            // Time spent waiting to acquire the GIL
+    ArgConversion,      // C++ -> Python argument conversion
+    ResultConversion    // Python -> C++ result conversion
+};
+
+constexpr size_t kMetricPhaseCount = 4;
+
+// Lower-case phase name as used in exported metric names
+const char* metricPhaseName(MetricPhase phase);
+
+/**
+ * @brief Merged latency histogram
+ * Log-linear buckets in nanoseconds: every power of two is split into 8
+ * linear sub-buckets, so reported percentiles are within 12.5% of the
+ * recorded value. Durations above ~18 minutes share the last bucket.
+ */
+struct LatencyHistogram {
+    static constexpr size_t kSubBucketBits = 3;
+    static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+    static constexpr size_t kMaxExponent = 40;
+    static constexpr size_t kBuckets = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t min_ns = 0;
+    uint64_t max_ns = 0;
+    std::vector<uint64_t> buckets;   // kBuckets entries, empty while count == 0
+
+    double meanNanos() const;
+
+    // Upper bound of the bucket holding the q-th quantile (0 <= q <= 1)
+    uint64_t percentileNanos(double q) const;
+
+    static size_t bucketIndex(uint64_t ns);
+    static uint64_t bucketUpperBound(size_t index);
+};
+
+/**
+ * @brief Aggregated metrics of one instrumented function.
+ */
+struct FunctionMetrics {
+    std::string name;           // "module.function", or "TypeConverter.toPython" etc.
+    uint64_t calls = 0;
+    uint64_t exceptions = 0;
+    LatencyHistogram phases[kMetricPhaseCount];
+
+    const LatencyHistogram& phase(MetricPhase p) const { return phases[static_cast<size_t>(p)]; }
+};
+
+/**
+ * @brief Point-in-time view of all metrics, merged across threads.
+ */
+struct MetricsSnapshot {
+    std::chrono::system_clock::time_point timestamp;
+    std::vector<FunctionMetrics> functions;   // Sorted by name
+
+    // nullptr if the function has not been recorded
+    const FunctionMetrics* find(const std::string& name) const;
+};
+
+/**
+ * @brief Opt-in call profiler
+ * When enabled, PythonModule::callFunction, PythonFunction::call/callPy,
+ * PythonExecutor tasks and TypeConverter record per-function call counts,
+ * exception counts and per-phase latency histograms. Each thread records
+ * into its own shard without synchronization; shards are merged when a
+ * snapshot is taken. When disabled an instrumented call only pays for one
+ * relaxed atomic load.
+ */
+class BridgeMetrics {
+public:
+    static void setEnabled(bool enable);
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // Merge all thread shards
+    static MetricsSnapshot snapshot();
+
+    // Discard everything recorded so far (racing recordings may survive)
+    static void reset();
+
+    // Render metrics in the Prometheus text exposition format
+    static std::string exportPrometheus(const std::string& prefix = "cpppy_bridge");
+    static std::string exportPrometheus(const MetricsSnapshot& snapshot, const std::string& prefix = "cpppy_bridge");
+
+private:
+    friend class CallTimer;
+    friend class ConversionTimer;
+
+    struct FunctionShard;
+
+    // Shard of the calling thread for "scope.name"
+    static FunctionShard& shardFor(std::string_view scope, std::string_view name);
+    static void record(FunctionShard& shard, MetricPhase phase, uint64_t ns);
+    static void finish(FunctionShard& shard, bool failed);
+
+    static bool enterConversion();
+    static void leaveConversion();
+
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @brief Scoped timer for one instrumented call
+ * lap() attributes the time since construction or the previous lap to a
+ * phase. The call is counted on destruction, as an exception if the scope is
+ * left by an exception. Inactive, with no clock reads, while metrics are
+ * disabled.
+ */
+class CallTimer {
+public:
+    CallTimer(std::string_view scope, std::string_view name);
+    ~CallTimer();
+
+    CallTimer(const CallTimer&) = delete;
+    CallTimer& operator=(const CallTimer&) = delete;
+
+    void lap(MetricPhase phase);
+
+private:
+    BridgeMetrics::FunctionShard* m_shard = nullptr;
+    std::chrono::steady_clock::time_point m_last;
+    int m_exceptions = 0;
+};
+
+/**
+ * @brief Scoped timer for a top-level TypeConverter conversion
+ * Nested conversions (container elements) are not timed separately.
+ */
+class ConversionTimer {
+public:
+    explicit ConversionTimer(MetricPhase phase);
+    ~ConversionTimer();
+
+    ConversionTimer(const ConversionTimer&) = delete;
+    ConversionTimer& operator=(const ConversionTimer&) = delete;
+
+private:
+    BridgeMetrics::FunctionShard* m_shard = nullptr;
+    MetricPhase m_phase;
+    bool m_nested = false;
+    std::chrono::steady_clock::time_point m_start;
+    int m_exceptions = 0;
+};
+
+// Inline method implementations
+inline CallTimer::CallTimer(std::string_view scope, std::string_view name) {
+    if (BridgeMetrics::isEnabled()) {
+        m_shard = &BridgeMetrics::shardFor(scope, name);
+        m_exceptions = std::uncaught_exceptions();
+        m_last = std::chrono::steady_clock::now();
+    }
+}
+
+inline CallTimer::~CallTimer() {
+    if (m_shard) {
+        BridgeMetrics::finish(*m_shard, std::uncaught_exceptions() > m_exceptions);
+    }
+}
+
+inline void CallTimer::lap(MetricPhase phase) {
+    if (m_shard) {
+        auto now = std::chrono::steady_clock::now();
+        BridgeMetrics::record(*m_shard, phase, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last).count()));
+        m_last = now;
+    }
+}
+
+inline ConversionTimer::ConversionTimer(MetricPhase phase) : m_phase(phase) {
+    if (BridgeMetrics::isEnabled()) {
+        m_nested = !BridgeMetrics::enterConversion();
+        if (!m_nested) {
+            m_shard = &BridgeMetrics::shardFor("TypeConverter",
+                                               phase == MetricPhase::ArgConversion ? "toPython" : "fromPython");
+            m_exceptions = std::uncaught_exceptions();
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+}
+
+inline ConversionTimer::~ConversionTimer() {
+    if (m_shard) {
+        auto elapsed = std::chrono::steady_clock::now() - m_start;
+        BridgeMetrics::record(*m_shard, m_phase, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        BridgeMetrics::finish(*m_shard, std::uncaught_exceptions() > m_exceptions);
+    }
+    if (m_shard || m_nested) {
+        BridgeMetrics::leaveConversion();
+    }
+}
+
+} // namespace cpppy_bridge
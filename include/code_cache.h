@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Compilation mode of cached source code.
+ */
+enum class CodeMode {
+    Eval,   // A single expression; executing it returns its value
+    Exec    // Statements; executing it returns None
+};
+
+/**
+ * @brief Cache statistics.
+ */
+struct CodeCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;   // File entries recompiled after their source changed
+    size_t size = 0;
+    size_t capacity = 0;
+};
+
+/**
+ * @brief Bounded LRU cache of compiled code objects
+ * Source strings are keyed by their hash and compilation mode (the source is
+ * compared on a hit, so hash collisions only cost a recompilation). Files are
+ * keyed by path and recompiled when their modification time or size changes.
+ * All methods except getStats() require the GIL; code objects belong to the
+ * main interpreter, so callers in sub-interpreters bypass the cache.
+ */
+class CodeCache {
+public:
+    explicit CodeCache(size_t capacity = 256);
+    ~CodeCache();
+
+    CodeCache(const CodeCache&) = delete;
+    CodeCache& operator=(const CodeCache&) = delete;
+
+    // Compiled code for source, compiling it on a miss
+    py::object get(const std::string& source, CodeMode mode, const char* filename = "<string>");
+
+    // Compiled code (exec mode) for a source file
+    py::object getFile(const std::string& path);
+
+    // Shrinking evicts the least recently used entries; 0 disables caching
+    void setCapacity(size_t capacity);
+    size_t capacity() const;
+
+    void clear();
+
+    CodeCacheStats getStats() const;
+
+    // Compile without caching
+    static py::object compile(const std::string& source, CodeMode mode, const char* filename);
+
+private:
+    struct Entry {
+        uint64_t key;
+        CodeMode mode;
+        std::string text;   // Source, or the path of a file entry
+        py::object code;
+        bool is_file = false;
+        std::filesystem::file_time_type mtime{};
+        uintmax_t file_size = 0;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    static uint64_t makeKey(const std::string& text, CodeMode mode, bool is_file);
+    static bool cacheableInterpreter();
+
+    EntryList::iterator find(uint64_t key);
+    py::object insert(Entry entry);
+    void evictToCapacity();
+
+    std::atomic<size_t> m_capacity;
+    EntryList m_entries;   // Most recently used first
+    std::unordered_map<uint64_t, EntryList::iterator> m_index;
+
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_evictions{0};
+    std::atomic<uint64_t> m_invalidations{0};
+    std::atomic<size_t> m_size{0};
+};
+
+} // namespace cpppy_bridge
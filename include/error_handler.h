@@ -9,12 +9,16 @@
 #include <map>
 #include <typeindex>
 #include <chrono>
+#include <atomic>
+#include <cstdint>
 #include <pybind11/pybind11.h>
 
 namespace py = pybind11;
 
 namespace cpppy_bridge {
 
+class ErrorLogSink;
+
 /**
  * @brief Base class for Python bridge exceptions.
  */
@@ -75,14 +79,27 @@ private:
 
 /**
  * @brief Structure to hold Python error information.
+ * Type and message are captured eagerly. The traceback and the location of
+ * the failing frame are formatted on first access and cached; all copies of
+ * one PythonErrorInfo share that cache.
  */
 struct PythonErrorInfo {
     std::string type;           // Exception type
     std::string message;        // Error message
-    std::string traceback;      // Stack trace
-    std::string file;           // File name
-    int line = -1;              // Line number
-    std::string function;       // Function name
+    
+    // Formatted on demand from the captured traceback (acquires the GIL if needed)
+    const std::string& traceback() const;   // Stack trace
+    const std::string& file() const;        // File name
+    int line() const;                       // Line number, -1 if unknown
+    const std::string& function() const;    // Function name
+    
+private:
+    friend class ErrorHandler;
+    
+    struct LazyDetails;
+    const LazyDetails* details() const;
+    
+    std::shared_ptr<LazyDetails> m_details;
 };
 
 /**
@@ -94,21 +111,33 @@ public:
     // Type for error callback functions
     using ErrorCallback = std::function<void(const PythonErrorInfo&)>;
     
-    // Set a global error callback
-    static void setGlobalErrorCallback(ErrorCallback callback);
+    // Handle identifying one registered callback (0 is never issued)
+    using CallbackToken = uint64_t;
+    
+    // Set a global error callback (replaces all registered callbacks)
+    static CallbackToken setGlobalErrorCallback(ErrorCallback callback);
     
     // Add an error callback (supports multiple callbacks)
-    static void addErrorCallback(ErrorCallback callback);
+    static CallbackToken addErrorCallback(ErrorCallback callback);
+    
+    // Remove the callback registered under token; false if it is no longer registered
+    static bool removeErrorCallback(CallbackToken token);
     
     // Clear all error callbacks
     static void clearErrorCallbacks();
     
+    // Number of currently registered callbacks
+    static size_t errorCallbackCount();
+    
     // Handle a Python exception
     static PythonErrorInfo handlePythonException(const py::error_already_set& e);
     
     // Convert a Python exception to a C++ exception
     static void convertPythonException(const py::error_already_set& e);
     
+    // Convert already extracted error information (avoids a second extraction)
+    static void convertPythonException(const PythonErrorInfo& info);
+    
     // Safely execute Python code (with exception handling)
     template<typename Func>
     static auto safeExecute(Func&& func) -> decltype(func());
@@ -122,31 +151,67 @@ public:
     
     // Format error information into a string
     static std::string formatErrorInfo(const PythonErrorInfo& info);
+    static std::string formatErrorInfo(const PythonErrorInfo& info, bool verbose);
     
-    // Log an error
+    // Log an error (hands a record to the log sink, subject to rate limiting)
     static void logError(const PythonErrorInfo& info);
     
-    // Enable/disable verbose error messages
+    // Enable/disable verbose error messages (preset: location and traceback in messages and logs)
     static void setVerboseErrors(bool verbose);
     
-    // Enable/disable error logging
+    // Enable/disable error logging (preset: whether records reach the log sink)
     static void setErrorLogging(bool enable);
     
+    // Replace the log sink; nullptr discards all records. The default sink is
+    // an AsyncLogSink writing text to std::cerr from a background thread.
+    static void setLogSink(std::shared_ptr<ErrorLogSink> sink);
+    static std::shared_ptr<ErrorLogSink> getLogSink();
+    
+    // Limit logged records per exception type and second (0 = unlimited)
+    static void setErrorRateLimit(uint32_t max_per_second);
+    
+    // Run error callbacks on a background thread instead of the erroring thread
+    static void setAsyncCallbacks(bool enable);
+    
+    // Wait until queued log records and callbacks have been processed
+    static void flushErrorLog();
+    
+    // Drop cached Python objects; called by PythonInterpreter::finalize
+    static void resetInterpreterState();
+    
 private:
-    static std::vector<ErrorCallback> s_error_callbacks;
-    static bool s_verbose_errors;
-    static bool s_error_logging;
+    struct CallbackEntry {
+        CallbackToken token;
+        ErrorCallback callback;
+    };
+    using CallbackList = std::vector<CallbackEntry>;
     
-    // Trigger error callbacks
+    // Copy-on-write callback list: readers only load the pointer, writers
+    // publish a new list and retire the old one once no reader is active
+    static std::atomic<const CallbackList*> s_error_callbacks;
+    static std::atomic<uint32_t> s_callback_readers;
+    static std::atomic<CallbackToken> s_next_callback_token;
+    static std::atomic<bool> s_verbose_errors;
+    static std::atomic<bool> s_error_logging;
+    
+    // Replace the callback list (caller holds the writer lock); returns the
+    // retired lists that can now be destroyed, to be released after unlocking
+    static std::vector<std::shared_ptr<const void>> publishCallbacks(std::unique_ptr<const CallbackList> list);
+    
+    // Trigger error callbacks on the calling thread
     static void triggerErrorCallbacks(const PythonErrorInfo& info);
     
+    // Trigger error callbacks inline or on the callback thread
+    static void dispatchErrorCallbacks(const PythonErrorInfo& info);
+    
     // Parse a Python traceback object
     static std::string parsePythonTraceback(const py::object& traceback_obj);
 };
 
 /**
  * @brief RAII-style Error Handler
- * Automatically handles exceptions within its scope.
+ * Registers a callback for the lifetime of the object and removes exactly
+ * that callback on destruction.
  */
 class ScopedErrorHandler {
 public:
@@ -159,9 +224,10 @@ public:
     ScopedErrorHandler(ScopedErrorHandler&&) = delete;
     ScopedErrorHandler& operator=(ScopedErrorHandler&&) = delete;
     
+    ErrorHandler::CallbackToken token() const { return m_token; }
+    
 private:
-    ErrorHandler::ErrorCallback m_callback;
-    bool m_registered = false;
+    ErrorHandler::CallbackToken m_token = 0;
 };
 
 /**
@@ -200,7 +266,7 @@ private:
     do { \
         auto error_info = ErrorHandler::handlePythonException(e); \
         ErrorHandler::logError(error_info); \
-        ErrorHandler::convertPythonException(e); \
+        ErrorHandler::convertPythonException(error_info); \
     } while(0)
 
 // Template method implementations
@@ -210,14 +276,13 @@ auto ErrorHandler::safeExecute(Func&& func) -> decltype(func()) {
         return func();
     } catch (const py::error_already_set& e) {
         auto error_info = handlePythonException(e);
-        triggerErrorCallbacks(error_info);
-        convertPythonException(e);
+        convertPythonException(error_info);
         throw; // This line won't be reached as convertPythonException throws
     } catch (const std::exception& e) {
         PythonErrorInfo info;
         info.type = "C++ Exception";
         info.message = e.what();
-        triggerErrorCallbacks(info);
+        dispatchErrorCallbacks(info);
         throw;
     }
 }
@@ -227,14 +292,13 @@ auto ErrorHandler::safeExecuteOptional(Func&& func) -> std::optional<decltype(fu
     try {
         return func();
     } catch (const py::error_already_set& e) {
-        auto error_info = handlePythonException(e);
-        triggerErrorCallbacks(error_info);
+        handlePythonException(e);
         return std::nullopt;
     } catch (const std::exception& e) {
         PythonErrorInfo info;
         info.type = "C++ Exception";
         info.message = e.what();
-        triggerErrorCallbacks(info);
+        dispatchErrorCallbacks(info);
         return std::nullopt;
     }
 }
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include "error_handler.h"
+
+namespace cpppy_bridge {
+
+/**
+ * @brief One error event handed to a log sink.
+ * The record is rendered by the sink, not by the thread that raised the
+ * error; only AsyncLogSink formats the Python traceback up front.
+ */
+struct ErrorLogRecord {
+    std::chrono::system_clock::time_point timestamp;
+    PythonErrorInfo info;
+    bool verbose = true;        // Include location and traceback
+    uint64_t suppressed = 0;    // Records of this type dropped by rate limiting since the last one
+};
+
+/**
+ * @brief Output format of the built-in sinks.
+ */
+enum class LogFormat {
+    Text,       // "[YYYY-MM-DD HH:MM:SS] Python Error: ..." as before
+    JsonLines   // One JSON object per line
+};
+
+/**
+ * @brief Destination for error log records.
+ * write() may be called concurrently from any thread.
+ */
+class ErrorLogSink {
+public:
+    virtual ~ErrorLogSink() = default;
+    virtual void write(const ErrorLogRecord& record) = 0;
+    virtual void flush() {}
+
+    // Render a record in the given format (no trailing newline)
+    static std::string format(const ErrorLogRecord& record, LogFormat format);
+};
+
+/**
+ * @brief Synchronous sink writing formatted records to a stream or file.
+ */
+class StreamLogSink : public ErrorLogSink {
+public:
+    explicit StreamLogSink(std::ostream& stream, LogFormat format = LogFormat::Text);
+
+    // Append to a file
+    explicit StreamLogSink(const std::string& path, LogFormat format = LogFormat::JsonLines);
+
+    void write(const ErrorLogRecord& record) override;
+    void flush() override;
+
+private:
+    std::unique_ptr<std::ofstream> m_file;
+    std::ostream* m_stream;
+    LogFormat m_format;
+    std::mutex m_mutex;
+};
+
+/**
+ * @brief Sink forwarding records to a user function.
+ */
+class FunctionLogSink : public ErrorLogSink {
+public:
+    explicit FunctionLogSink(std::function<void(const ErrorLogRecord&)> function);
+    void write(const ErrorLogRecord& record) override;
+
+private:
+    std::function<void(const ErrorLogRecord&)> m_function;
+};
+
+/**
+ * @brief Bounded lock-free multi-producer / single-consumer ring buffer.
+ * Producers never block: tryPush fails when the ring is full. Capacity is
+ * rounded up to a power of two.
+ */
+template<typename T>
+class MpscRing {
+public:
+    explicit MpscRing(size_t capacity);
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    bool tryPush(T&& value);
+
+    // Claim a slot, then fill it in place with fill(T&), so the work of
+    // building an element is skipped when the ring is full. If fill throws
+    // the slot is published holding T{} and the exception propagates.
+    template<typename Fill>
+    bool tryEmplace(Fill&& fill);
+
+    // Only one thread may pop
+    bool tryPop(T& value);
+
+    size_t capacity() const { return m_mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) size_t m_tail = 0;
+};
+
+/**
+ * @brief Asynchronous sink
+ * Queues records in an MpscRing and hands them to the target sink on a
+ * background thread. The erroring thread still pays for claiming a slot,
+ * copying the record into it and, for verbose records (the default), for
+ * formatting the traceback, which acquires the GIL if the thread does not
+ * hold it. Records are queued without Python references, so the background
+ * thread never needs the GIL. When the ring is full records are dropped and
+ * counted before any of that work is done.
+ */
+class AsyncLogSink : public ErrorLogSink {
+public:
+    explicit AsyncLogSink(std::shared_ptr<ErrorLogSink> target, size_t capacity = 1024);
+    ~AsyncLogSink() override;
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    void write(const ErrorLogRecord& record) override;
+
+    // Wait until every queued record has been written (releases the GIL while waiting)
+    void flush() override;
+
+    uint64_t droppedRecords() const;
+
+private:
+    void run();
+
+    std::shared_ptr<ErrorLogSink> m_target;
+    MpscRing<ErrorLogRecord> m_ring;
+    std::atomic<uint64_t> m_enqueued{0};
+    std::atomic<uint64_t> m_processed{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<bool> m_sleeping{false};
+    std::atomic<bool> m_stopping{false};
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_drained;
+    std::thread m_thread;
+};
+
+/**
+ * @brief Per-error-type rate limiter
+ * Allows at most N records per second for each exception type (0 disables
+ * limiting). Types are hashed into a fixed table of lock-free counters, so
+ * rare hash collisions share one budget.
+ */
+class ErrorRateLimiter {
+public:
+    explicit ErrorRateLimiter(uint32_t max_per_second = 0);
+
+    void setLimit(uint32_t max_per_second);
+    uint32_t limit() const;
+
+    // True if a record of this type may be emitted; suppressed receives the
+    // number of records of this type dropped since the last emitted one
+    bool allow(const std::string& type, uint64_t& suppressed);
+
+private:
+    static constexpr size_t kBuckets = 64;
+
+    struct Bucket {
+        std::atomic<int64_t> window{-1};
+        std::atomic<uint32_t> count{0};
+        std::atomic<uint64_t> suppressed{0};
+    };
+
+    std::atomic<uint32_t> m_limit;
+    Bucket m_buckets[kBuckets];
+};
+
+// Template method implementations
+template<typename T>
+MpscRing<T>::MpscRing(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    m_cells = std::make_unique<Cell[]>(size);
+    m_mask = size - 1;
+    for (size_t i = 0; i < size; ++i) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+bool MpscRing<T>::tryPush(T&& value) {
+    return tryEmplace([&value](T& slot) { slot = std::move(value); });
+}
+
+template<typename T>
+template<typename Fill>
+bool MpscRing<T>::tryEmplace(Fill&& fill) {
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;) {
+        cell = &m_cells[pos & m_mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = m_head.load(std::memory_order_relaxed);
+        }
+    }
+    try {
+        fill(cell->value);
+    } catch (...) {
+        // The consumer waits on this slot, so it must be published either way
+        cell->value = T{};
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        throw;
+    }
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+bool MpscRing<T>::tryPop(T& value) {
+    Cell* cell = &m_cells[m_tail & m_mask];
+    const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    if (sequence != m_tail + 1) {
+        return false;
+    }
+    value = std::move(cell->value);
+    cell->value = T{};
+    cell->sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+    ++m_tail;
+    return true;
+}
+
+} // namespace cpppy_bridge
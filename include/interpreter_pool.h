@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include "python_bridge.h"
+
+namespace py = pybind11;
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Occupancy statistics for one interpreter in an InterpreterPool.
+ */
+struct InterpreterStats {
+    size_t index = 0;              // Slot index in the pool
+    bool own_gil = false;          // Runs under its own GIL (PEP 684)
+    bool busy = false;             // Currently executing a call
+    uint64_t calls = 0;            // Completed calls
+    uint64_t busy_time_us = 0;     // Accumulated time spent executing calls
+    size_t cached_modules = 0;     // Modules imported into this interpreter
+};
+
+/**
+ * @brief Sub-interpreter Pool
+ * Runs calls on N sub-interpreters that each own their GIL (Python 3.12+),
+ * so CPU-bound Python code can use several cores. Every interpreter has its
+ * own sys.path and PythonModule cache, and each call is pinned to an idle
+ * interpreter for its whole duration.
+ *
+ * On older Pythons the pool falls back to a single slot backed by the main
+ * interpreter. Only plain C++ values should cross the pool boundary; Python
+ * objects belong to the interpreter that created them. Extension modules must
+ * support multi-phase initialization to be importable in a sub-interpreter.
+ *
+ * The pool must be created from a thread holding the main interpreter's GIL
+ * and destroyed before the main interpreter is finalized.
+ */
+class InterpreterPool {
+public:
+    explicit InterpreterPool(size_t num_interpreters, const std::vector<std::string>& module_paths = {});
+    ~InterpreterPool();
+
+    // Disable copy and move operations
+    InterpreterPool(const InterpreterPool&) = delete;
+    InterpreterPool& operator=(const InterpreterPool&) = delete;
+    InterpreterPool(InterpreterPool&&) = delete;
+    InterpreterPool& operator=(InterpreterPool&&) = delete;
+
+    // Check whether this Python build supports a per-interpreter GIL
+    static bool subInterpretersSupported();
+
+    bool usesSubInterpreters() const;
+    size_t size() const;
+
+    // Run a callable on an idle interpreter with its GIL held
+    template<typename Func>
+    auto run(Func&& func) -> decltype(func());
+
+    // Call a module-level function on an idle interpreter
+    template<typename ReturnType, typename... Args>
+    ReturnType callFunction(const std::string& module_name, const std::string& func_name, Args&&... args);
+
+    // Per-interpreter occupancy snapshot
+    std::vector<InterpreterStats> getStats() const;
+
+private:
+    struct Slot {
+        PyInterpreterState* interp = nullptr;
+        PyThreadState* home_tstate = nullptr;
+        std::unordered_map<std::string, std::shared_ptr<PythonModule>> modules;
+        bool busy = false;
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> busy_time_us{0};
+        std::atomic<size_t> cached_modules{0};
+    };
+
+    /**
+     * @brief Occupies one idle slot and attaches the calling thread to it.
+     */
+    class Lease {
+    public:
+        explicit Lease(InterpreterPool& pool);
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        std::shared_ptr<PythonModule> loadModule(const std::string& module_name);
+
+    private:
+        InterpreterPool& m_pool;
+        Slot& m_slot;
+        PyThreadState* m_tstate = nullptr;
+        PyThreadState* m_saved_tstate = nullptr;
+        PyGILState_STATE m_gil_state{};
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    Slot& acquireSlot();
+    void releaseSlot(Slot& slot);
+
+    // End every sub-interpreter in m_slots; the calling thread's state is restored afterwards
+    void endSubInterpreters();
+
+    std::vector<std::unique_ptr<Slot>> m_slots;
+    std::vector<std::string> m_module_paths;
+    bool m_sub_interpreters = false;
+    size_t m_next_slot = 0;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_slot_available;
+};
+
+// Template method implementations
+template<typename Func>
+auto InterpreterPool::run(Func&& func) -> decltype(func()) {
+    Lease lease(*this);
+    return func();
+}
+
+template<typename ReturnType, typename... Args>
+ReturnType InterpreterPool::callFunction(const std::string& module_name, const std::string& func_name, Args&&... args) {
+    Lease lease(*this);
+    auto module = lease.loadModule(module_name);
+    return module->template callFunction<ReturnType>(func_name, std::forward<Args>(args)...);
+}
+
+} // namespace cpppy_bridge
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Row-major Dense Matrix
+ * Two-dimensional matrix backed by a single allocation with explicit strides,
+ * so it converts to and from NumPy without copying. Strides are expressed in
+ * elements. Storage can optionally be aligned to a 64-byte cache line.
+ *
+ * Copies share the underlying buffer (like a NumPy view); use clone() for an
+ * independent deep copy.
+ */
+template<typename T>
+class Matrix {
+    static_assert(std::is_trivially_copyable_v<T>, "Matrix<T> requires a trivially copyable element type");
+
+public:
+    static constexpr size_t kCacheLineAlignment = 64;
+
+    Matrix() = default;
+
+    // Allocate a zero-initialized rows x cols matrix
+    Matrix(size_t rows, size_t cols, bool aligned = false);
+
+    // Allocate a rows x cols matrix filled with value
+    Matrix(size_t rows, size_t cols, const T& value, bool aligned = false);
+
+    // Wrap existing storage; owner keeps the buffer alive
+    static Matrix view(T* data, size_t rows, size_t cols,
+                       std::ptrdiff_t row_stride, std::ptrdiff_t col_stride,
+                       std::shared_ptr<void> owner);
+
+    size_t rows() const { return m_rows; }
+    size_t cols() const { return m_cols; }
+    size_t size() const { return m_rows * m_cols; }
+    bool empty() const { return size() == 0; }
+
+    std::ptrdiff_t rowStride() const { return m_row_stride; }
+    std::ptrdiff_t colStride() const { return m_col_stride; }
+
+    // True when the matrix is densely packed in row-major order
+    bool isContiguous() const;
+
+    T* data() { return m_data; }
+    const T* data() const { return m_data; }
+
+    T& operator()(size_t row, size_t col) { return m_data[offset(row, col)]; }
+    const T& operator()(size_t row, size_t col) const { return m_data[offset(row, col)]; }
+
+    // Bounds-checked element access
+    T& at(size_t row, size_t col);
+    const T& at(size_t row, size_t col) const;
+
+    // Deep copy into a new contiguous matrix
+    Matrix clone(bool aligned = false) const;
+
+    // Object that owns the storage (allocation or foreign buffer)
+    const std::shared_ptr<void>& owner() const { return m_owner; }
+
+private:
+    static std::shared_ptr<void> allocate(size_t count, bool aligned);
+
+    std::ptrdiff_t offset(size_t row, size_t col) const {
+        return static_cast<std::ptrdiff_t>(row) * m_row_stride + static_cast<std::ptrdiff_t>(col) * m_col_stride;
+    }
+
+    std::shared_ptr<void> m_owner;
+    T* m_data = nullptr;
+    size_t m_rows = 0;
+    size_t m_cols = 0;
+    std::ptrdiff_t m_row_stride = 0;
+    std::ptrdiff_t m_col_stride = 1;
+};
+
+// Template method implementations
+template<typename T>
+Matrix<T>::Matrix(size_t rows, size_t cols, bool aligned)
+    : Matrix(rows, cols, T{}, aligned) {}
+
+template<typename T>
+Matrix<T>::Matrix(size_t rows, size_t cols, const T& value, bool aligned)
+    : m_owner(allocate(rows * cols, aligned)),
+      m_rows(rows),
+      m_cols(cols),
+      m_row_stride(static_cast<std::ptrdiff_t>(cols)),
+      m_col_stride(1) {
+    m_data = static_cast<T*>(m_owner.get());
+    std::fill(m_data, m_data + rows * cols, value);
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::view(T* data, size_t rows, size_t cols,
+                          std::ptrdiff_t row_stride, std::ptrdiff_t col_stride,
+                          std::shared_ptr<void> owner) {
+    Matrix result;
+    result.m_owner = std::move(owner);
+    result.m_data = data;
+    result.m_rows = rows;
+    result.m_cols = cols;
+    result.m_row_stride = row_stride;
+    result.m_col_stride = col_stride;
+    return result;
+}
+
+template<typename T>
+bool Matrix<T>::isContiguous() const {
+    return (m_cols <= 1 || m_col_stride == 1) &&
+           (m_rows <= 1 || m_row_stride == static_cast<std::ptrdiff_t>(m_cols));
+}
+
+template<typename T>
+T& Matrix<T>::at(size_t row, size_t col) {
+    if (row >= m_rows || col >= m_cols) {
+        throw std::out_of_range("Matrix index out of range");
+    }
+    return (*this)(row, col);
+}
+
+template<typename T>
+const T& Matrix<T>::at(size_t row, size_t col) const {
+    if (row >= m_rows || col >= m_cols) {
+        throw std::out_of_range("Matrix index out of range");
+    }
+    return (*this)(row, col);
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::clone(bool aligned) const {
+    Matrix result(m_rows, m_cols, aligned);
+    if (isContiguous()) {
+        std::copy(m_data, m_data + size(), result.m_data);
+        return result;
+    }
+    for (size_t i = 0; i < m_rows; ++i) {
+        for (size_t j = 0; j < m_cols; ++j) {
+            result(i, j) = (*this)(i, j);
+        }
+    }
+    return result;
+}
+
+template<typename T>
+std::shared_ptr<void> Matrix<T>::allocate(size_t count, bool aligned) {
+    const size_t bytes = std::max<size_t>(count, 1) * sizeof(T);
+    if (aligned) {
+        const std::align_val_t alignment{std::max(kCacheLineAlignment, alignof(T))};
+        void* ptr = ::operator new(bytes, alignment);
+        return std::shared_ptr<void>(ptr, [alignment](void* p) { ::operator delete(p, alignment); });
+    }
+    void* ptr = ::operator new(bytes);
+    return std::shared_ptr<void>(ptr, [](void* p) { ::operator delete(p); });
+}
+
+} // namespace cpppy_bridge
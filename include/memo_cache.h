@@ -0,0 +1,336 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Limits of a memoization cache.
+ */
+struct MemoCachePolicy {
+    size_t max_entries = 4096;
+    size_t max_bytes = 16 << 20;                 // Approximate footprint of keys and values
+    std::chrono::milliseconds ttl{0};            // 0 keeps entries until evicted
+    size_t shards = 16;                          // Independently locked partitions
+};
+
+/**
+ * @brief Cache statistics.
+ */
+struct MemoCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t expirations = 0;
+    uint64_t invalidations = 0;   // Clears caused by a module reload or attribute change
+    size_t entries = 0;
+    size_t bytes = 0;
+
+    double hitRate() const {
+        const uint64_t lookups = hits + misses;
+        return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+/**
+ * @brief Sharded LRU cache of C++ call results
+ * Keys are the C++ arguments serialized before any conversion to Python, so
+ * a hit involves neither the GIL nor the interpreter. Each shard holds an
+ * equal part of the entry and byte budget behind its own mutex. Entries are
+ * tagged with the owning module's generation; the first lookup after a
+ * reload clears the cache. Thread-safe.
+ */
+class MemoCache {
+public:
+    explicit MemoCache(const MemoCachePolicy& policy = {});
+    ~MemoCache();
+
+    MemoCache(const MemoCache&) = delete;
+    MemoCache& operator=(const MemoCache&) = delete;
+
+    // Cached value for key if present, unexpired and stored as R
+    template<typename R>
+    std::optional<R> find(const std::string& key, uint64_t generation);
+
+    // Store a value computed at generation (dropped if the module changed since)
+    template<typename R>
+    void insert(std::string key, const R& value, uint64_t generation);
+
+    void clear();
+
+    MemoCacheStats getStats() const;
+    const MemoCachePolicy& getPolicy() const;
+
+    // Totals over all live caches in the process
+    static size_t liveCaches();
+    static size_t totalEntries();
+    static size_t totalBytes();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string key;
+        std::type_index type;
+        std::shared_ptr<const void> value;
+        size_t bytes;
+        Clock::time_point stored;
+        uint64_t generation;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    struct Shard {
+        std::mutex mutex;
+        EntryList entries;   // Most recently used first
+        std::unordered_map<std::string_view, EntryList::iterator> index;
+        size_t bytes = 0;
+    };
+
+    std::shared_ptr<const void> lookup(const std::string& key, std::type_index type, uint64_t generation);
+    void store(std::string key, std::type_index type, std::shared_ptr<const void> value, size_t bytes,
+               uint64_t generation);
+
+    // Clear everything if generation is newer than the cached one; false if it is older
+    bool syncGeneration(uint64_t generation);
+    Shard& shardFor(std::string_view key);
+    void erase(Shard& shard, EntryList::iterator it);
+
+    MemoCachePolicy m_policy;
+    size_t m_shard_entries;
+    size_t m_shard_bytes;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+
+    std::atomic<uint64_t> m_generation{0};
+    std::mutex m_generation_mutex;
+
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_evictions{0};
+    std::atomic<uint64_t> m_expirations{0};
+    std::atomic<uint64_t> m_invalidations{0};
+    std::atomic<size_t> m_entries{0};
+    std::atomic<size_t> m_bytes{0};
+
+    static std::atomic<size_t> s_live_caches;
+    static std::atomic<size_t> s_total_entries;
+    static std::atomic<size_t> s_total_bytes;
+};
+
+namespace detail {
+
+template<typename T, typename = void>
+struct MemoKeyable : std::false_type {};
+
+// Wide character types become str through conversions the key cannot mirror
+template<typename T>
+struct MemoKeyable<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, wchar_t> &&
+                                       !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>>>
+    : std::true_type {};
+
+template<>
+struct MemoKeyable<std::string> : std::true_type {};
+
+template<>
+struct MemoKeyable<std::string_view> : std::true_type {};
+
+template<>
+struct MemoKeyable<const char*> : std::true_type {};
+
+template<>
+struct MemoKeyable<char*> : std::true_type {};
+
+template<>
+struct MemoKeyable<std::nullptr_t> : std::true_type {};
+
+template<typename T, typename A>
+struct MemoKeyable<std::vector<T, A>> : MemoKeyable<T> {};
+
+template<typename K, typename V, typename C, typename A>
+struct MemoKeyable<std::map<K, V, C, A>> : std::bool_constant<MemoKeyable<K>::value && MemoKeyable<V>::value> {};
+
+template<typename A, typename B>
+struct MemoKeyable<std::pair<A, B>> : std::bool_constant<MemoKeyable<A>::value && MemoKeyable<B>::value> {};
+
+template<typename... T>
+struct MemoKeyable<std::tuple<T...>> : std::bool_constant<(MemoKeyable<T>::value && ...)> {};
+
+template<typename T>
+struct MemoKeyable<std::optional<T>> : MemoKeyable<T> {};
+
+template<typename T>
+struct IsMemoVector : std::false_type {};
+
+template<typename T, typename A>
+struct IsMemoVector<std::vector<T, A>> : std::true_type {};
+
+template<typename T>
+struct IsMemoMap : std::false_type {};
+
+template<typename K, typename V, typename C, typename A>
+struct IsMemoMap<std::map<K, V, C, A>> : std::true_type {};
+
+template<typename T>
+struct IsMemoOptional : std::false_type {};
+
+template<typename T>
+struct IsMemoOptional<std::optional<T>> : std::true_type {};
+
+// Every argument can be serialized into a cache key
+template<typename... Args>
+constexpr bool kMemoKeyable = (MemoKeyable<std::decay_t<Args>>::value && ...);
+
+/**
+ * @brief Serializes C++ arguments into a cache key
+ * Values that convert to equal Python objects produce equal keys (every
+ * integer type maps to one tag, std::vector and std::tuple to lists and
+ * tuples), so memoization follows Python semantics rather than C++ types.
+ */
+class MemoKeyWriter {
+public:
+    template<typename T>
+    void append(const T& value);
+
+    std::string take() { return std::move(m_key); }
+
+private:
+    template<typename T>
+    void raw(const T& value) {
+        m_key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void text(std::string_view value) {
+        raw<uint64_t>(value.size());
+        m_key.append(value.data(), value.size());
+    }
+
+    std::string m_key;
+};
+
+template<typename T>
+void MemoKeyWriter::append(const T& value) {
+    using Value = std::decay_t<T>;
+
+    if constexpr (std::is_same_v<Value, bool>) {
+        m_key.push_back('b');
+        m_key.push_back(value ? 1 : 0);
+    } else if constexpr (std::is_same_v<Value, char>) {
+        // char arrives in Python as a one-character str
+        m_key.push_back('s');
+        text(std::string_view(&value, 1));
+    } else if constexpr (std::is_integral_v<Value>) {
+        if constexpr (std::is_unsigned_v<Value> && sizeof(Value) >= sizeof(int64_t)) {
+            if (value > static_cast<Value>(std::numeric_limits<int64_t>::max())) {
+                m_key.push_back('u');
+                raw<uint64_t>(value);
+                return;
+            }
+        }
+        m_key.push_back('i');
+        raw<int64_t>(static_cast<int64_t>(value));
+    } else if constexpr (std::is_floating_point_v<Value>) {
+        m_key.push_back('f');
+        raw<double>(static_cast<double>(value));
+    } else if constexpr (std::is_same_v<Value, std::nullptr_t>) {
+        m_key.push_back('n');
+    } else if constexpr (std::is_convertible_v<const Value&, std::string_view>) {
+        m_key.push_back('s');
+        text(std::string_view(value));
+    } else if constexpr (IsMemoOptional<Value>::value) {
+        if (value) {
+            append(*value);
+        } else {
+            m_key.push_back('n');
+        }
+    } else if constexpr (IsMemoVector<Value>::value) {
+        m_key.push_back('l');
+        raw<uint64_t>(value.size());
+        for (const auto& item : value) {
+            append(item);
+        }
+    } else if constexpr (IsMemoMap<Value>::value) {
+        m_key.push_back('m');
+        raw<uint64_t>(value.size());
+        for (const auto& [key, item] : value) {
+            append(key);
+            append(item);
+        }
+    } else {
+        // std::pair and std::tuple
+        m_key.push_back('t');
+        raw<uint64_t>(std::tuple_size_v<Value>);
+        std::apply([this](const auto&... items) { (append(items), ...); }, value);
+    }
+}
+
+template<typename... Args>
+std::string memoKey(const Args&... args) {
+    MemoKeyWriter writer;
+    (writer.append(args), ...);
+    return writer.take();
+}
+
+// Approximate heap footprint of a cached value
+template<typename T>
+size_t memoFootprint(const T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return sizeof(T) + value.capacity();
+    } else if constexpr (IsMemoVector<T>::value) {
+        size_t bytes = sizeof(T);
+        if constexpr (std::is_arithmetic_v<typename T::value_type>) {
+            bytes += value.capacity() * sizeof(typename T::value_type);
+        } else {
+            for (const auto& item : value) {
+                bytes += memoFootprint(item);
+            }
+        }
+        return bytes;
+    } else if constexpr (IsMemoMap<T>::value) {
+        // Red-black tree node overhead
+        size_t bytes = sizeof(T) + value.size() * 4 * sizeof(void*);
+        for (const auto& [key, item] : value) {
+            bytes += memoFootprint(key) + memoFootprint(item);
+        }
+        return bytes;
+    } else {
+        return sizeof(T);
+    }
+}
+
+} // namespace detail
+
+// Template method implementations
+template<typename R>
+std::optional<R> MemoCache::find(const std::string& key, uint64_t generation) {
+    std::shared_ptr<const void> value = lookup(key, typeid(R), generation);
+    if (!value) {
+        return std::nullopt;
+    }
+    // Copied outside the shard lock; the entry may be evicted meanwhile
+    return *static_cast<const R*>(value.get());
+}
+
+template<typename R>
+void MemoCache::insert(std::string key, const R& value, uint64_t generation) {
+    const size_t bytes = key.size() + sizeof(Entry) + detail::memoFootprint(value);
+    store(std::move(key), typeid(R), std::make_shared<const R>(value), bytes, generation);
+}
+
+} // namespace cpppy_bridge
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+namespace py = pybind11;
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Instruction set used by NumpyKernels.
+ */
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512,
+    NEON
+};
+
+/**
+ * @brief Result of NumpyKernels::stats, matching numpy_operations().
+ */
+struct ArrayStats {
+    size_t count = 0;
+    double sum = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0; // Population standard deviation (ddof = 0), like np.std
+    double min = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * @brief Options for NumpyKernels reductions.
+ */
+struct KernelOptions {
+    // Arrays with at least this many elements are split across threads
+    size_t parallel_threshold = 1 << 18;
+
+    // Upper bound on worker threads; 0 uses std::thread::hardware_concurrency()
+    size_t max_threads = 0;
+
+    // Release the GIL while reducing a py::array (the array must not be resized meanwhile)
+    bool release_gil = true;
+};
+
+/**
+ * @brief Native reductions over NumPy buffers
+ * Computes the statistics of numpy_operations() in C++ without calling into
+ * the interpreter. Arrays are dispatched at runtime on their dtype (float32,
+ * float64, int32, int64; non-contiguous arrays are made contiguous first) and
+ * the kernels on the best instruction set the CPU supports. Values are
+ * accumulated in double precision; the standard deviation uses the two-pass
+ * formula per chunk, and chunks of large arrays are reduced on separate
+ * threads and merged pairwise. NaN propagates to every statistic, as in NumPy.
+ */
+class NumpyKernels {
+public:
+    // Reductions over a py::array (GIL held on entry)
+    static ArrayStats stats(const py::array& arr, const KernelOptions& options = {});
+    static double sum(const py::array& arr, const KernelOptions& options = {});
+    static double mean(const py::array& arr, const KernelOptions& options = {});
+    static double min(const py::array& arr, const KernelOptions& options = {});
+    static double max(const py::array& arr, const KernelOptions& options = {});
+    static double stddev(const py::array& arr, const KernelOptions& options = {});
+
+    // Reductions over contiguous C++ buffers (no Python involvement)
+    static ArrayStats stats(const float* data, size_t count, const KernelOptions& options = {});
+    static ArrayStats stats(const double* data, size_t count, const KernelOptions& options = {});
+    static ArrayStats stats(const int32_t* data, size_t count, const KernelOptions& options = {});
+    static ArrayStats stats(const int64_t* data, size_t count, const KernelOptions& options = {});
+
+    // Best instruction set supported by this CPU
+    static SimdLevel detectedSimdLevel();
+
+    // Active instruction set (defaults to the detected one)
+    static SimdLevel simdLevel();
+
+    // Restrict kernels to a lower instruction set, e.g. for benchmarks; unsupported levels fall back to Scalar
+    static void setSimdLevel(SimdLevel level);
+
+    static const char* simdLevelName(SimdLevel level);
+};
+
+} // namespace cpppy_bridge
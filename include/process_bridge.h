@@ -0,0 +1,515 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
+#include "error_handler.h"
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Settings for a ProcessBridge.
+ */
+struct ProcessBridgeConfig {
+    size_t num_workers = 4;                          // Worker processes
+    size_t ring_bytes = 1 << 20;                     // Capacity of each request/response ring
+    std::string python_executable = "python3";      // Interpreter run by the workers (PATH lookup)
+    std::vector<std::string> module_paths;           // Appended to each worker's sys.path
+};
+
+/**
+ * @brief Occupancy statistics for one ProcessBridge worker.
+ */
+struct WorkerStats {
+    size_t index = 0;          // Slot index in the bridge
+    pid_t pid = -1;            // Current worker process
+    bool alive = false;        // Accepting calls
+    size_t in_flight = 0;      // Calls dispatched and not yet answered
+    uint64_t calls = 0;        // Completed calls
+    uint64_t restarts = 0;     // Times the worker was respawned after exiting
+};
+
+/**
+ * @brief Named POSIX shared-memory segment
+ * Owning segments unlink their name on destruction; attached segments only
+ * unmap. Move-only.
+ */
+class SharedSegment {
+public:
+    SharedSegment() = default;
+    ~SharedSegment();
+
+    SharedSegment(SharedSegment&& other) noexcept;
+    SharedSegment& operator=(SharedSegment&& other) noexcept;
+    SharedSegment(const SharedSegment&) = delete;
+    SharedSegment& operator=(const SharedSegment&) = delete;
+
+    // Create a new segment with a process-unique name
+    static SharedSegment create(size_t bytes);
+
+    // Map an existing segment; with take_ownership the name is unlinked right away
+    static SharedSegment attach(const std::string& name, size_t bytes, bool take_ownership);
+
+    void* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    const std::string& name() const { return m_name; }
+
+private:
+    void reset();
+
+    std::string m_name;
+    void* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_mapped = 0;    // Mapping length (at least one byte)
+    bool m_owner = false;
+};
+
+/**
+ * @brief Typed array stored in shared memory
+ * Passed to and returned from ProcessBridge workers by segment name, so the
+ * payload is never serialized or copied; workers see it as a NumPy array.
+ */
+template<typename T>
+class SharedArray {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "SharedArray requires a numeric type");
+
+public:
+    SharedArray() = default;
+    explicit SharedArray(std::vector<int64_t> shape);
+    SharedArray(SharedSegment segment, std::vector<int64_t> shape);
+
+    T* data() { return static_cast<T*>(m_segment.data()); }
+    const T* data() const { return static_cast<const T*>(m_segment.data()); }
+    size_t size() const { return m_size; }
+    const std::vector<int64_t>& shape() const { return m_shape; }
+    const SharedSegment& segment() const { return m_segment; }
+
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+
+private:
+    SharedSegment m_segment;
+    std::vector<int64_t> m_shape;
+    size_t m_size = 0;
+};
+
+namespace detail {
+
+// Value tags of the worker wire format
+enum class WireTag : uint8_t {
+    None = 0,
+    Bool = 1,
+    Int = 2,
+    Float = 3,
+    Str = 4,
+    Bytes = 5,
+    List = 6,
+    Array = 7,
+};
+
+// Native-endian, unpadded encoding of call arguments
+class WireWriter {
+public:
+    template<typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable_v<T>, "WireWriter::put requires a trivially copyable type");
+        const size_t offset = m_bytes.size();
+        m_bytes.resize(offset + sizeof(T));
+        std::memcpy(m_bytes.data() + offset, &value, sizeof(T));
+    }
+
+    void putTag(WireTag tag) { put(static_cast<uint8_t>(tag)); }
+    void putString(std::string_view text);
+
+    std::vector<char>& bytes() { return m_bytes; }
+
+private:
+    std::vector<char> m_bytes;
+};
+
+// Bounds-checked reader over a reply payload
+class WireReader {
+public:
+    explicit WireReader(const std::vector<char>& bytes) : m_bytes(bytes) {}
+
+    template<typename T>
+    T get() {
+        static_assert(std::is_trivially_copyable_v<T>, "WireReader::get requires a trivially copyable type");
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    WireTag getTag() { return static_cast<WireTag>(get<uint8_t>()); }
+    std::string getString();
+    const char* take(size_t bytes);
+
+private:
+    const std::vector<char>& m_bytes;
+    size_t m_offset = 0;
+};
+
+// struct-module format character of an array element type
+template<typename T>
+constexpr char wireFormat() {
+    if constexpr (std::is_floating_point_v<T>) {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Unsupported floating point width");
+        return sizeof(T) == 4 ? 'f' : 'd';
+    } else {
+        static_assert(sizeof(T) <= 8, "Unsupported integer width");
+        constexpr char kSigned[] = {'b', 'h', 0, 'i', 0, 0, 0, 'q'};
+        constexpr char kUnsigned[] = {'B', 'H', 0, 'I', 0, 0, 0, 'Q'};
+        return std::is_signed_v<T> ? kSigned[sizeof(T) - 1] : kUnsigned[sizeof(T) - 1];
+    }
+}
+
+template<typename T>
+struct IsSharedArray : std::false_type {};
+
+template<typename T>
+struct IsSharedArray<SharedArray<T>> : std::true_type {};
+
+template<typename T>
+struct IsStdVector : std::false_type {};
+
+template<typename T, typename A>
+struct IsStdVector<std::vector<T, A>> : std::true_type {};
+
+void encodeArray(WireWriter& out, char format, const std::vector<int64_t>& shape, const SharedSegment& segment);
+
+/**
+ * @brief Array segments of one worker reply
+ * Arrays come back as segments created by the worker. All of them are
+ * attached (and unlinked) before the reply is decoded, so none stays in
+ * /dev/shm when the result is discarded (call<void>) or rejected.
+ */
+class ReplyArrays {
+public:
+    explicit ReplyArrays(const std::vector<char>& payload);
+
+    // Next segment in stream order
+    SharedSegment take();
+
+private:
+    struct Claimed {
+        SharedSegment segment;
+        std::string error;   // Set when the segment could not be attached
+    };
+
+    std::vector<Claimed> m_claimed;
+    size_t m_next = 0;
+};
+
+SharedSegment decodeArray(WireReader& in, char format, std::vector<int64_t>& shape, ReplyArrays& arrays);
+
+// Segments created for std::vector arguments live in temps until the reply arrives
+template<typename T>
+void encodeValue(WireWriter& out, const T& value, std::vector<SharedSegment>& temps);
+
+template<typename T>
+T decodeValue(WireReader& in, ReplyArrays& arrays);
+
+} // namespace detail
+
+class ProcessBridge;
+
+/**
+ * @brief Module loaded into every ProcessBridge worker.
+ */
+class ProcessModule {
+public:
+    ProcessModule(ProcessBridge& bridge, std::string module_name);
+
+    const std::string& getName() const { return m_module_name; }
+
+    template<typename ReturnType, typename... Args>
+    ReturnType callFunction(const std::string& func_name, Args&&... args);
+
+private:
+    ProcessBridge& m_bridge;
+    std::string m_module_name;
+};
+
+/**
+ * @brief Module-level function called through a ProcessBridge.
+ */
+class ProcessFunction {
+public:
+    ProcessFunction(ProcessBridge& bridge, std::string module_name, std::string func_name);
+
+    template<typename ReturnType, typename... Args>
+    ReturnType call(Args&&... args);
+
+private:
+    ProcessBridge& m_bridge;
+    std::string m_module_name;
+    std::string m_func_name;
+};
+
+/**
+ * @brief Out-of-process worker pool (POSIX)
+ * Runs N Python worker processes for CPU-bound code that cannot use
+ * sub-interpreters. Each worker is forked and exec'd into the configured
+ * interpreter and shares one memory region with the bridge holding a request
+ * and a response ring; a socketpair only carries wake-ups and signals worker
+ * exit. Scalars, strings and lists use a compact binary framing, while
+ * numeric arrays (std::vector<T> and SharedArray<T>) travel as shared-memory
+ * segments that workers map as NumPy arrays.
+ *
+ * Calls go to the worker with the fewest calls in flight. A worker that
+ * exits is respawned and its loaded modules are imported again; calls that
+ * were in flight on it fail with PythonInterpreterException and are not
+ * retried. The bridge does not need the in-process interpreter, and calls
+ * release the GIL while they wait if the caller holds it.
+ */
+class ProcessBridge {
+public:
+    explicit ProcessBridge(ProcessBridgeConfig config = {});
+    ~ProcessBridge();
+
+    // Disable copy and move operations
+    ProcessBridge(const ProcessBridge&) = delete;
+    ProcessBridge& operator=(const ProcessBridge&) = delete;
+    ProcessBridge(ProcessBridge&&) = delete;
+    ProcessBridge& operator=(ProcessBridge&&) = delete;
+
+    // Import a module in every worker (and again in respawned workers)
+    std::shared_ptr<ProcessModule> loadModule(const std::string& module_name);
+
+    // Create a function wrapper
+    std::shared_ptr<ProcessFunction> createFunction(const std::string& module_name,
+                                                    const std::string& func_name);
+
+    // Call a module-level function on the least-loaded worker
+    template<typename ReturnType, typename... Args>
+    ReturnType call(const std::string& module_name, const std::string& func_name, Args&&... args);
+
+    size_t size() const;
+    std::vector<WorkerStats> getStats() const;
+
+    // Stop all workers (called by the destructor)
+    void shutdown();
+
+private:
+    // Message kinds shared with the worker script
+    enum MessageKind : uint32_t {
+        kLoad = 1,
+        kCall = 2,
+        kResult = 3,
+        kError = 4,
+    };
+
+    struct Reply {
+        uint32_t kind = 0;
+        std::vector<char> payload;
+    };
+
+    struct Worker {
+        size_t index = 0;
+        pid_t pid = -1;
+        int socket = -1;
+        void* region = nullptr;
+        size_t region_size = 0;
+        std::atomic<bool> alive{false};
+        std::atomic<size_t> in_flight{0};
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> restarts{0};
+        std::mutex write_mutex;
+        std::mutex pending_mutex;
+        std::unordered_map<uint64_t, std::shared_ptr<std::promise<Reply>>> pending;
+        std::thread reader;
+    };
+
+    Reply dispatch(uint32_t kind, std::vector<char> body);
+    Worker& pickWorker();
+    std::future<Reply> send(Worker& worker, uint32_t kind, const std::vector<char>& body);
+
+    void spawn(Worker& worker);
+    void readLoop(Worker& worker);
+    bool drainReplies(Worker& worker);
+    void reap(Worker& worker);
+
+    [[noreturn]] static void throwRemoteError(const std::string& func_name, const Reply& reply);
+
+    ProcessBridgeConfig m_config;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<uint64_t> m_next_id{1};
+    std::atomic<size_t> m_next_worker{0};
+    std::atomic<bool> m_stopping{false};
+
+    std::vector<std::string> m_modules;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_worker_ready;
+};
+
+// Template method implementations
+template<typename T>
+SharedArray<T>::SharedArray(std::vector<int64_t> shape) : m_shape(std::move(shape)), m_size(1) {
+    for (int64_t dim : m_shape) {
+        m_size *= static_cast<size_t>(dim);
+    }
+    m_segment = SharedSegment::create(m_size * sizeof(T));
+}
+
+template<typename T>
+SharedArray<T>::SharedArray(SharedSegment segment, std::vector<int64_t> shape)
+    : m_segment(std::move(segment)), m_shape(std::move(shape)), m_size(1) {
+    for (int64_t dim : m_shape) {
+        m_size *= static_cast<size_t>(dim);
+    }
+}
+
+namespace detail {
+
+template<typename T>
+void encodeValue(WireWriter& out, const T& value, std::vector<SharedSegment>& temps) {
+    using Value = std::decay_t<T>;
+
+    if constexpr (std::is_same_v<Value, std::nullptr_t>) {
+        out.putTag(WireTag::None);
+    } else if constexpr (std::is_same_v<Value, bool>) {
+        out.putTag(WireTag::Bool);
+        out.put<uint8_t>(value ? 1 : 0);
+    } else if constexpr (std::is_integral_v<Value>) {
+        out.putTag(WireTag::Int);
+        out.put<int64_t>(static_cast<int64_t>(value));
+    } else if constexpr (std::is_floating_point_v<Value>) {
+        out.putTag(WireTag::Float);
+        out.put<double>(static_cast<double>(value));
+    } else if constexpr (std::is_convertible_v<const Value&, std::string_view>) {
+        out.putTag(WireTag::Str);
+        out.putString(std::string_view(value));
+    } else if constexpr (IsSharedArray<Value>::value) {
+        using Element = std::remove_cv_t<std::remove_pointer_t<decltype(value.data())>>;
+        out.putTag(WireTag::Array);
+        encodeArray(out, wireFormat<Element>(), value.shape(), value.segment());
+    } else if constexpr (IsStdVector<Value>::value) {
+        using Element = typename Value::value_type;
+        if constexpr (std::is_arithmetic_v<Element> && !std::is_same_v<Element, bool>) {
+            // One copy into shared memory instead of per-element framing
+            SharedSegment segment = SharedSegment::create(value.size() * sizeof(Element));
+            if (!value.empty()) {
+                std::memcpy(segment.data(), value.data(), value.size() * sizeof(Element));
+            }
+            out.putTag(WireTag::Array);
+            encodeArray(out, wireFormat<Element>(), {static_cast<int64_t>(value.size())}, segment);
+            temps.push_back(std::move(segment));
+        } else {
+            out.putTag(WireTag::List);
+            out.put<uint32_t>(static_cast<uint32_t>(value.size()));
+            for (const auto& item : value) {
+                encodeValue(out, item, temps);
+            }
+        }
+    } else {
+        static_assert(std::is_same_v<Value, void>, "Type cannot be sent to a ProcessBridge worker");
+    }
+}
+
+template<typename T>
+T decodeValue(WireReader& in, ReplyArrays& arrays) {
+    const WireTag tag = in.getTag();
+
+    if constexpr (std::is_void_v<T>) {
+        (void)tag;
+        return;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        if (tag != WireTag::Bool) {
+            throw TypeConversionException("worker result", "bool", "Expected a bool");
+        }
+        return in.get<uint8_t>() != 0;
+    } else if constexpr (std::is_integral_v<T>) {
+        if (tag != WireTag::Int) {
+            throw TypeConversionException("worker result", "integer", "Expected an int");
+        }
+        return static_cast<T>(in.get<int64_t>());
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (tag == WireTag::Int) {
+            return static_cast<T>(in.get<int64_t>());
+        }
+        if (tag != WireTag::Float) {
+            throw TypeConversionException("worker result", "floating point", "Expected a float");
+        }
+        return static_cast<T>(in.get<double>());
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        if (tag != WireTag::Str && tag != WireTag::Bytes) {
+            throw TypeConversionException("worker result", "std::string", "Expected str or bytes");
+        }
+        return in.getString();
+    } else if constexpr (IsSharedArray<T>::value) {
+        using Element = std::remove_cv_t<std::remove_pointer_t<decltype(std::declval<const T&>().data())>>;
+        if (tag != WireTag::Array) {
+            throw TypeConversionException("worker result", "SharedArray", "Expected an array");
+        }
+        std::vector<int64_t> shape;
+        SharedSegment segment = decodeArray(in, wireFormat<Element>(), shape, arrays);
+        return T(std::move(segment), std::move(shape));
+    } else if constexpr (IsStdVector<T>::value) {
+        using Element = typename T::value_type;
+        if constexpr (std::is_arithmetic_v<Element> && !std::is_same_v<Element, bool>) {
+            if (tag == WireTag::Array) {
+                std::vector<int64_t> shape;
+                SharedSegment segment = decodeArray(in, wireFormat<Element>(), shape, arrays);
+                const Element* first = static_cast<const Element*>(segment.data());
+                return T(first, first + segment.size() / sizeof(Element));
+            }
+        }
+        if (tag != WireTag::List) {
+            throw TypeConversionException("worker result", "std::vector", "Expected a list or array");
+        }
+        T result;
+        const uint32_t count = in.get<uint32_t>();
+        result.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            result.push_back(decodeValue<Element>(in, arrays));
+        }
+        return result;
+    } else {
+        static_assert(std::is_same_v<T, void>, "Type cannot be returned by a ProcessBridge worker");
+    }
+}
+
+} // namespace detail
+
+template<typename ReturnType, typename... Args>
+ReturnType ProcessBridge::call(const std::string& module_name, const std::string& func_name, Args&&... args) {
+    detail::WireWriter request;
+    std::vector<SharedSegment> temps;
+    request.putString(module_name);
+    request.putString(func_name);
+    request.put<uint32_t>(static_cast<uint32_t>(sizeof...(Args)));
+    (detail::encodeValue(request, args, temps), ...);
+
+    Reply reply = dispatch(kCall, std::move(request.bytes()));
+    if (reply.kind != kResult) {
+        throwRemoteError(func_name, reply);
+    }
+
+    detail::ReplyArrays arrays(reply.payload);
+    detail::WireReader in(reply.payload);
+    return detail::decodeValue<ReturnType>(in, arrays);
+}
+
+template<typename ReturnType, typename... Args>
+ReturnType ProcessModule::callFunction(const std::string& func_name, Args&&... args) {
+    return m_bridge.call<ReturnType>(m_module_name, func_name, std::forward<Args>(args)...);
+}
+
+template<typename ReturnType, typename... Args>
+ReturnType ProcessFunction::call(Args&&... args) {
+    return m_bridge.call<ReturnType>(m_module_name, m_func_name, std::forward<Args>(args)...);
+}
+
+} // namespace cpppy_bridge
@@ -5,16 +5,97 @@
 #include <map>
 #include <unordered_map>
 #include <memory>
+#include <variant>
 #include <functional>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <utility>
 #include <pybind11/pybind11.h>
 #include <pybind11/embed.h>
 #include <pybind11/stl.h>
+#include "argument_pack.h"
+#include "bridge_allocator.h"
+#include "bridge_memory.h"
+#include "bridge_metrics.h"
+#include "code_cache.h"
+#include "memo_cache.h"
 #include "error_handler.h"
+#include "type_converter.h"
 
 namespace py = pybind11;
 
 namespace cpppy_bridge {
 
+class InterpreterPool;
+
+template<typename ReturnType>
+class AsyncCall;
+
+template<typename T>
+class PythonStream;
+
+class PythonClass;
+class PythonObject;
+class InstancePool;
+
+/**
+ * @brief Interpreter Startup Profile
+ * Settings applied when the interpreter is created. Interpreter options are
+ * passed through PyConfig and only take effect on the first initialization.
+ */
+struct StartupProfile {
+    StartupProfile();
+    
+    // Isolated mode: ignore PYTHON* environment variables and the user site directory
+    bool isolated = false;
+    
+    // Do not import the site module at startup
+    bool no_site = false;
+    
+    // Complete precomputed sys.path (including the standard library); empty keeps
+    // the default path computation
+    std::vector<std::string> module_search_paths;
+    
+    // Additional module directories, appended like PythonBridge::initialize(paths)
+    std::vector<std::string> module_paths;
+    
+    // Zip archives of precompiled .pyc files, searched before all other entries
+    std::vector<std::string> bytecode_archives;
+    
+    // Frozen module table (zero-terminated); installed as PyImport_FrozenModules.
+    // Before Python 3.11 it replaces the built-in table and must include it.
+    const struct _frozen* frozen_modules = nullptr;
+    
+    // Modules imported eagerly after the interpreter starts
+    std::vector<std::string> preload_modules;
+    
+    // Import preload_modules on a background thread while the caller continues.
+    // initialize() then returns without the GIL; call waitUntilReady() before
+    // using pybind11 or the converters directly (bridge entry points do it implicitly).
+    bool async_preload = false;
+    
+    // CPython memory allocators, installed before the interpreter is created
+    AllocatorConfig allocator;
+};
+
+/**
+ * @brief Startup timings reported by PythonInterpreter.
+ */
+struct StartupStats {
+    std::chrono::microseconds interpreter_init{0};   // Interpreter creation and sys.path setup
+    std::chrono::microseconds preload{0};            // Importing preload_modules
+    std::vector<std::string> preloaded;
+    std::vector<std::string> failed_preloads;
+};
+
 /**
  * @brief Python Interpreter Manager
  * Manages the initialization, finalization, and lifecycle of the Python interpreter.
@@ -27,18 +108,78 @@ public:
     void finalize();
     bool isInitialized() const;
     
+    // Initialize with a startup profile. With async_preload the GIL is handed to
+    // a background import thread; the initializing thread gets it back in
+    // waitUntilReady(), which bridge calls perform implicitly.
+    void initialize(const StartupProfile& profile);
+    
+    // Block until background preloading has finished
+    void waitUntilReady();
+    bool isReady() const;
+    
+    StartupStats getStartupStats() const;
+    
     // Add a search path for Python modules
     void addModulePath(const std::string& path);
     
-    // Execute Python code
+    // Evaluate a Python expression. Compiled code is cached, so repeated
+    // snippets skip parsing and compilation.
     py::object execute(const std::string& code);
     
+    // Exec mode runs statements in __main__ and returns None
+    py::object execute(const std::string& code, CodeMode mode);
+    
+    // Run with a caller-owned locals dict, e.g. to pass parameters; the dict can
+    // be refilled and reused across calls. Names assigned in exec mode end up in locals.
+    py::object execute(const std::string& code, const py::dict& locals, CodeMode mode = CodeMode::Eval);
+    
+    // Run a script file in __main__; recompiled only when the file changes
+    void executeFile(const std::string& file_path);
+    
+    CodeCache& getCodeCache();
+    
+    // Trace Python allocations with tracemalloc, recording up to `frames` frames each
+    void startTracemalloc(int frames = 1);
+    void stopTracemalloc();
+    bool isTracemallocActive();
+    
+    // No GIL; only reflects startTracemalloc()/stopTracemalloc(), not tracing started from Python
+    bool tracemallocStarted() const;
+    
+    // Largest allocation sites, grouped by source line
+    TracemallocSnapshot takeTracemallocSnapshot(size_t top_n = 10);
+    
+    // Allocation sites that grew most since the previous call; the first call
+    // only records the baseline
+    TracemallocSnapshot tracemallocGrowth(size_t top_n = 10);
+    
+    // Check whether the calling thread currently holds a GIL
+    static bool holdsGIL();
+    
 private:
     PythonInterpreter() = default;
     ~PythonInterpreter();
     
+    void startPreload(const std::vector<std::string>& modules, bool async);
+    void preloadModules(const std::vector<std::string>& modules);
+    
+    static py::object evalCode(const py::object& code, const py::object& globals, const py::object& locals);
+    
     bool m_initialized = false;
+    bool m_allocators_installed = false;
     std::unique_ptr<py::scoped_interpreter> m_interpreter;
+    CodeCache m_code_cache;
+    py::object m_tracemalloc_baseline;
+    std::atomic<bool> m_tracemalloc_started{false};
+    
+    StartupStats m_startup_stats;
+    std::thread m_preload_thread;
+    std::thread::id m_owner_thread;
+    PyThreadState* m_suspended_tstate = nullptr;
+    std::atomic<bool> m_preloading{false};
+    bool m_preload_finished = false;
+    mutable std::mutex m_preload_mutex;
+    std::condition_variable m_preload_done;
 };
 
 /**
@@ -63,16 +204,101 @@ public:
     // Call a Python function (returns py::object)
     py::object callFunction(const std::string& func_name, const std::vector<py::object>& args = {});
     
+    // Call with a reusable argument pack
+    py::object callFunction(const std::string& func_name, const ArgumentPack& args);
+    
+    // Call a generator function and stream its items in chunks instead of
+    // materializing the result. Defined in <python_stream.h>.
+    template<typename T, typename... Args>
+    PythonStream<T> callStream(const std::string& func_name, Args&&... args);
+    
     // Get a module attribute
     py::object getAttribute(const std::string& attr_name);
     
-    // Set a module attribute
+    // Set a module attribute (invalidates resolved call handles)
     void setAttribute(const std::string& attr_name, const py::object& value);
     
+    // Re-import the module from source into a fresh module object and swap it
+    // in (invalidates resolved call handles). Calls already running keep the
+    // previous version; on failure the previous version stays active.
+    bool reload();
+    
+    // Counter bumped whenever attributes may have changed identity
+    uint64_t getGeneration() const;
+    
+    const std::string& getName() const;
+    
+    // Underlying module object
+    const py::module& getModuleObject() const;
+    
+    // Source file of the module (empty for built-in modules)
+    std::string getFilePath() const;
+    
+    // True if the source file changed since it was last imported (no GIL needed)
+    bool isSourceModified() const;
+    
 private:
+    void recordSource();
+    
     std::string m_module_name;
     py::module m_module;
     bool m_loaded = false;
+    std::atomic<uint64_t> m_generation{0};
+    
+    std::mutex m_reload_mutex;
+    mutable std::mutex m_source_mutex;
+    std::string m_file_path;
+    std::filesystem::file_time_type m_file_mtime;
+    
+    detail::LiveCounter<PythonModule> m_live;
+};
+
+/**
+ * @brief Pre-resolved Call Handle
+ * Holds a module attribute resolved once through PythonBridge::resolve, so
+ * later calls skip the string-to-attribute lookup. The handle records the
+ * module generation it was resolved at and re-resolves transparently (using
+ * an interned name) after the module is reloaded or the attribute is
+ * reassigned through PythonModule::setAttribute.
+ */
+class CallHandle {
+public:
+    CallHandle() = default;
+    CallHandle(std::shared_ptr<PythonModule> module, const std::string& attr_name);
+    
+    bool isValid() const;
+    
+    // Generation of the module this handle was resolved at
+    uint64_t getGeneration() const;
+    
+    // Borrowed pointer to the callable, refreshed if the module changed
+    PyObject* get();
+    
+    template<typename ReturnType, typename... Args>
+    ReturnType call(Args&&... args);
+    
+    // Call with a reusable argument pack; with a resolved handle the steady
+    // state performs no bridge-side allocations
+    py::object callPy(const ArgumentPack& args);
+    
+private:
+    void refresh();
+    
+    std::shared_ptr<PythonModule> m_module;
+    std::string m_attr_name;
+    py::object m_interned_name;
+    py::object m_callable;
+    uint64_t m_generation = 0;
+    
+    detail::LiveCounter<CallHandle> m_live;
+};
+
+/**
+ * @brief Batch invocation strategy for PythonFunction::callBatch.
+ */
+enum class BatchMode {
+    PerCall,     // One C-level call per element, reusing the argument tuple
+    Vectorized   // Hand the whole batch to Python in a single call
 };
 
 /**
@@ -95,12 +321,51 @@ public:
     ReturnType call(Args&&... args);
 
     py::object callPy(const std::vector<py::object>& args = {});
+    py::object callPy(const ArgumentPack& args);
+    
+    // Call an `async def` function on the shared AsyncLoop without blocking the
+    // caller; non-awaitable results complete immediately. Defined in <async_bridge.h>.
+    template<typename ReturnType, typename... Args>
+    AsyncCall<ReturnType> callAsync(Args&&... args);
+    
+    // Call the function once per argument tuple, acquiring the GIL only once.
+    // In Vectorized mode the batch is passed as a list of tuples to the
+    // function's `__vectorized__` attribute if present, otherwise it is
+    // mapped with itertools.starmap inside the interpreter.
+    template<typename ReturnType, typename... Args>
+    std::vector<ReturnType> callBatch(const std::vector<std::tuple<Args...>>& batch,
+                                      BatchMode mode = BatchMode::PerCall);
+    
+    // Module generation the function was resolved at
+    uint64_t getGeneration() const;
+    
+    // Memoize call() results keyed on the C++ arguments, for pure functions.
+    // Hits skip argument conversion and the GIL; misses acquire the GIL, so
+    // cached functions may be called from threads that do not hold it. The
+    // cache is cleared when the module is reloaded. Configure before sharing
+    // the function between threads; calls with arguments that cannot be
+    // keyed (e.g. py::object) or results that may hold Python objects
+    // (py::object, types with custom converters) bypass the cache.
+    PythonFunction& withCache(const MemoCachePolicy& policy = {});
+    void clearCache();
+    MemoCacheStats getCacheStats() const;
     
 private:
+    template<typename Tuple, size_t... I>
+    static void fillArgumentTuple(PyObject* args, const Tuple& values, std::index_sequence<I...>);
+    
+    // Re-resolve the function after the module was reloaded (GIL held)
+    void refreshIfStale();
+    void refresh();
+    
     std::shared_ptr<PythonModule> m_module;
     std::string m_func_name;
     py::object m_function;
+    uint64_t m_generation = 0;
     bool m_valid = false;
+    std::shared_ptr<MemoCache> m_cache;
+    
+    detail::LiveCounter<PythonFunction> m_live;
 };
 
 /**
@@ -115,6 +380,9 @@ public:
     // Initialize the bridge
     bool initialize(const std::vector<std::string>& module_paths = {});
     
+    // Initialize with a startup profile (preloading may continue in the background)
+    bool initialize(const StartupProfile& profile);
+    
     // Load a Python module
     std::shared_ptr<PythonModule> loadModule(const std::string& module_name);
     
@@ -122,21 +390,130 @@ public:
     std::shared_ptr<PythonFunction> createFunction(const std::string& module_name, 
                                                    const std::string& func_name);
     
+    // Resolve a class once; cached per module version, so reloads yield a new class
+    std::shared_ptr<PythonClass> getClass(const std::string& module_name, const std::string& class_name);
+    
+    // Instantiate a class whose methods are called without bound-method lookups.
+    // Defined in <python_object.h>.
+    template<typename... Args>
+    std::shared_ptr<PythonObject> createInstance(const std::string& module_name, const std::string& class_name,
+                                                 Args&&... args);
+    
+    // Pool of instances constructed from the same arguments, for per-thread or
+    // leased use. Defined in <python_object.h>.
+    template<typename... Args>
+    std::shared_ptr<InstancePool> createInstancePool(const std::string& module_name, const std::string& class_name,
+                                                     Args&&... args);
+    
     // Execute a Python script file
     py::object executeFile(const std::string& file_path);
     
     // Execute a string of Python code
     py::object executeCode(const std::string& code);
     
+    // Execute in eval or exec mode, optionally with parameters bound as locals
+    py::object executeCode(const std::string& code, CodeMode mode);
+    py::object executeCode(const std::string& code, const py::dict& locals, CodeMode mode = CodeMode::Eval);
+    
     // Get a previously loaded module
     std::shared_ptr<PythonModule> getModule(const std::string& module_name);
     
+    // Resolve a module attribute once into a reusable call handle
+    CallHandle resolve(const std::string& module_name, const std::string& attr_name);
+    
+    // Create a pool of sub-interpreters sharing this bridge's module paths
+    std::shared_ptr<InterpreterPool> createInterpreterPool(size_t num_interpreters);
+    
+    // Re-import a loaded module; existing handles move to the new version on
+    // their next call while in-flight calls finish on the old one
+    bool reloadModule(const std::string& module_name);
+    
+    // Reload on a detached background thread that takes the GIL. The future
+    // can be dropped without blocking; release the GIL before waiting on it.
+    // The interpreter must not be finalized while a reload is pending.
+    std::future<bool> reloadModuleAsync(const std::string& module_name);
+    
+    // Poll the source files of loaded modules and reload the ones that changed.
+    // The watcher needs the GIL only while reloading.
+    void watchModules(std::chrono::milliseconds interval = std::chrono::milliseconds(500));
+    void stopWatching();
+    
 private:
-    std::map<std::string, std::shared_ptr<PythonModule>> m_modules;
+    void watchLoop(std::chrono::milliseconds interval);
+    
+    std::unordered_map<std::string, std::shared_ptr<PythonModule>> m_modules;
+    mutable std::mutex m_modules_mutex;
+    
+    struct ClassEntry {
+        uint64_t generation;
+        std::shared_ptr<PythonClass> cls;
+    };
+    std::unordered_map<std::string, ClassEntry> m_classes;
+    std::vector<std::string> m_module_paths;
     bool m_initialized = false;
+    
+    std::thread m_watch_thread;
+    std::mutex m_watch_mutex;
+    std::condition_variable m_watch_wakeup;
+    bool m_watch_stop = false;
 };
 
 // Template method implementations
+namespace detail {
+
+// Results that may own Python references; caching them would share one
+// mutable object between callers and copy or release it without the GIL.
+// Types a custom converter may produce are assumed to hold references.
+template<typename T, typename = void>
+struct HoldsPythonObject
+    : std::bool_constant<std::is_base_of_v<py::handle, T> || CustomConvertible<T>::value> {};
+
+template<typename T, typename A>
+struct HoldsPythonObject<std::vector<T, A>> : HoldsPythonObject<T> {};
+
+template<typename K, typename V, typename C, typename A>
+struct HoldsPythonObject<std::map<K, V, C, A>>
+    : std::bool_constant<HoldsPythonObject<K>::value || HoldsPythonObject<V>::value> {};
+
+template<typename K, typename V, typename H, typename E, typename A>
+struct HoldsPythonObject<std::unordered_map<K, V, H, E, A>>
+    : std::bool_constant<HoldsPythonObject<K>::value || HoldsPythonObject<V>::value> {};
+
+template<typename A, typename B>
+struct HoldsPythonObject<std::pair<A, B>>
+    : std::bool_constant<HoldsPythonObject<A>::value || HoldsPythonObject<B>::value> {};
+
+template<typename... T>
+struct HoldsPythonObject<std::tuple<T...>> : std::bool_constant<(HoldsPythonObject<T>::value || ...)> {};
+
+template<typename... T>
+struct HoldsPythonObject<std::variant<T...>> : std::bool_constant<(HoldsPythonObject<T>::value || ...)> {};
+
+template<typename T>
+struct HoldsPythonObject<std::optional<T>> : HoldsPythonObject<T> {};
+
+template<typename ReturnType>
+constexpr bool kMemoizableResult = !std::is_void_v<ReturnType> && !HoldsPythonObject<std::decay_t<ReturnType>>::value;
+
+// Call with pybind11's argument collection, attributing each step to the timer
+template<typename ReturnType, typename... Args>
+ReturnType timedCall(const py::handle& callable, CallTimer& timer, Args&&... args) {
+    auto collected = py::detail::collect_arguments<py::return_value_policy::automatic_reference>(
+        std::forward<Args>(args)...);
+    timer.lap(MetricPhase::ArgConversion);
+    py::object result = collected.call(callable.ptr());
+    timer.lap(MetricPhase::Python);
+    if constexpr (std::is_void_v<ReturnType>) {
+        return;
+    } else {
+        ReturnType value = result.cast<ReturnType>();
+        timer.lap(MetricPhase::ResultConversion);
+        return value;
+    }
+}
+
+} // namespace detail
+
 template<typename ReturnType, typename... Args>
 ReturnType PythonModule::callFunction(const std::string& func_name, Args&&... args) {
     if (!m_loaded) {
@@ -144,58 +521,179 @@ ReturnType PythonModule::callFunction(const std::string& func_name, Args&&... ar
     }
     
     try {
+        CallTimer timer(m_module_name, func_name);
         py::object func = m_module.attr(func_name.c_str());
-        py::object result = func(std::forward<Args>(args)...);
+        return detail::timedCall<ReturnType>(func, timer, std::forward<Args>(args)...);
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+        throw; // Should not be reached
+    }
+}
+
+inline PyObject* CallHandle::get() {
+    if (m_generation != m_module->getGeneration()) {
+        refresh();
+    }
+    return m_callable.ptr();
+}
+
+template<typename ReturnType, typename... Args>
+ReturnType CallHandle::call(Args&&... args) {
+    if (!m_module) {
+        throw PythonFunctionException(m_attr_name, "Invalid call handle");
+    }
+    
+    try {
+        py::object result = py::handle(get())(std::forward<Args>(args)...);
         if constexpr (std::is_void_v<ReturnType>) {
             return;
         } else {
             return result.cast<ReturnType>();
         }
     } catch (const py::error_already_set& e) {
-        ErrorHandler::handlePythonException(e);
-        ErrorHandler::convertPythonException(e);
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
         throw; // Should not be reached
     }
 }
 
 template<typename ReturnType, typename... Args>
 ReturnType PythonFunction::operator()(Args&&... args) {
+    return call<ReturnType>(std::forward<Args>(args)...);
+}
+
+template<typename ReturnType, typename... Args>
+ReturnType PythonFunction::call(Args&&... args) {
     if (!m_valid) {
         throw PythonFunctionException(m_func_name, "Invalid function");
     }
     
-    try {
-        py::object result = m_function(std::forward<Args>(args)...);
-        if constexpr (std::is_void_v<ReturnType>) {
-            return;
-        } else {
-            return result.cast<ReturnType>();
+    if constexpr (detail::kMemoizableResult<ReturnType> && detail::kMemoKeyable<Args...>) {
+        if (m_cache) {
+            std::string key = detail::memoKey(args...);
+            const uint64_t generation = m_module->getGeneration();
+            if (auto cached = m_cache->find<ReturnType>(key, generation)) {
+                return std::move(*cached);
+            }
+            
+            // Hits never touch the GIL; misses acquire it
+            py::gil_scoped_acquire gil;
+            std::optional<ReturnType> result;
+            try {
+                refreshIfStale();
+                CallTimer timer(m_module->getName(), m_func_name);
+                result.emplace(detail::timedCall<ReturnType>(m_function, timer, std::forward<Args>(args)...));
+            } catch (const py::error_already_set& e) {
+                auto error_info = ErrorHandler::handlePythonException(e);
+                ErrorHandler::convertPythonException(error_info);
+                throw; // Should not be reached
+            }
+            m_cache->insert(std::move(key), *result, generation);
+            return std::move(*result);
         }
+    }
+    
+    try {
+        refreshIfStale();
+        CallTimer timer(m_module->getName(), m_func_name);
+        return detail::timedCall<ReturnType>(m_function, timer, std::forward<Args>(args)...);
     } catch (const py::error_already_set& e) {
-        ErrorHandler::handlePythonException(e);
-        ErrorHandler::convertPythonException(e);
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
         throw; // Should not be reached
     }
 }
 
 template<typename ReturnType, typename... Args>
-ReturnType PythonFunction::call(Args&&... args) {
+std::vector<ReturnType> PythonFunction::callBatch(const std::vector<std::tuple<Args...>>& batch, BatchMode mode) {
+    static_assert(!std::is_void_v<ReturnType>, "callBatch requires a non-void return type");
+    
     if (!m_valid) {
         throw PythonFunctionException(m_func_name, "Invalid function");
     }
     
+    std::vector<ReturnType> results;
+    results.reserve(batch.size());
+    if (batch.empty()) {
+        return results;
+    }
+    
+    CallTimer timer(m_module->getName(), m_func_name);
+    py::gil_scoped_acquire gil;
+    timer.lap(MetricPhase::GilWait);
     try {
-        py::object result = m_function(std::forward<Args>(args)...);
-        if constexpr (std::is_void_v<ReturnType>) {
-            return;
-        } else {
-            return result.cast<ReturnType>();
+        refreshIfStale();
+        if (mode == BatchMode::Vectorized) {
+            py::list calls(batch.size());
+            for (size_t i = 0; i < batch.size(); ++i) {
+                calls[i] = py::cast(batch[i]);
+            }
+            
+            py::object output;
+            if (py::hasattr(m_function, "__vectorized__")) {
+                output = m_function.attr("__vectorized__")(calls);
+            } else {
+                py::object starmap = py::module::import("itertools").attr("starmap");
+                output = py::list(starmap(m_function, calls));
+            }
+            
+            for (auto item : output) {
+                results.push_back(item.template cast<ReturnType>());
+            }
+            if (results.size() != batch.size()) {
+                throw PythonFunctionException(m_func_name, "Vectorized call returned " +
+                    std::to_string(results.size()) + " results for " + std::to_string(batch.size()) + " inputs");
+            }
+            timer.lap(MetricPhase::Python);
+            return results;
+        }
+        
+        constexpr size_t arity = sizeof...(Args);
+        py::object args = py::reinterpret_steal<py::object>(PyTuple_New(arity));
+        if (!args) {
+            throw py::error_already_set();
         }
+        
+        for (const auto& entry : batch) {
+            // The tuple may only be refilled while nobody else references it
+            if (Py_REFCNT(args.ptr()) != 1) {
+                args = py::reinterpret_steal<py::object>(PyTuple_New(arity));
+                if (!args) {
+                    throw py::error_already_set();
+                }
+            }
+            fillArgumentTuple(args.ptr(), entry, std::index_sequence_for<Args...>{});
+            
+            PyObject* raw = PyObject_Call(m_function.ptr(), args.ptr(), nullptr);
+            if (!raw) {
+                throw py::error_already_set();
+            }
+            results.push_back(py::reinterpret_steal<py::object>(raw).template cast<ReturnType>());
+        }
+        timer.lap(MetricPhase::Python);
+        return results;
     } catch (const py::error_already_set& e) {
-        ErrorHandler::handlePythonException(e);
-        ErrorHandler::convertPythonException(e);
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
         throw; // Should not be reached
     }
 }
 
+inline void PythonFunction::refreshIfStale() {
+    if (m_generation != m_module->getGeneration()) {
+        refresh();
+    }
+}
+
+template<typename Tuple, size_t... I>
+void PythonFunction::fillArgumentTuple(PyObject* args, const Tuple& values, std::index_sequence<I...>) {
+    auto replace = [args](size_t index, py::object value) {
+        PyObject* previous = PyTuple_GET_ITEM(args, static_cast<Py_ssize_t>(index));
+        PyTuple_SET_ITEM(args, static_cast<Py_ssize_t>(index), value.release().ptr());
+        Py_XDECREF(previous);
+    };
+    (replace(I, py::cast(std::get<I>(values))), ...);
+}
+
 } // namespace cpppy_bridge
\ No newline at end of file
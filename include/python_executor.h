@@ -0,0 +1,130 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include "python_bridge.h"
+
+namespace py = pybind11;
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Python Call Executor
+ * Runs PythonFunction calls submitted from any number of C++ threads on a
+ * fixed set of dispatch threads fed by a bounded queue. The GIL is held only
+ * while the interpreter runs the call; submitters block when the queue is full.
+ *
+ * Workers need the GIL to make progress, so the thread that owns the
+ * interpreter must release it (e.g. with py::gil_scoped_release) while
+ * futures are outstanding.
+ */
+class PythonExecutor {
+public:
+    explicit PythonExecutor(size_t num_threads = 4, size_t queue_capacity = 256);
+    ~PythonExecutor();
+
+    // Disable copy operations
+    PythonExecutor(const PythonExecutor&) = delete;
+    PythonExecutor& operator=(const PythonExecutor&) = delete;
+
+    // Queue a call to a function wrapper (blocks while the queue is full)
+    template<typename ReturnType, typename... Args>
+    std::future<ReturnType> submit(std::shared_ptr<PythonFunction> func, Args&&... args);
+
+    // Queue an arbitrary callable that is run with the GIL held
+    template<typename Func>
+    auto submitTask(Func&& func) -> std::future<decltype(func())>;
+
+    // Finish all queued work and stop the dispatch threads
+    void shutdown();
+
+    bool isRunning() const;
+    size_t threadCount() const;
+    size_t queueCapacity() const;
+    size_t pendingTasks() const;
+
+private:
+    using Task = std::function<void()>;
+
+    void enqueue(Task task);
+    void workerLoop();
+
+    size_t m_capacity;
+    std::deque<Task> m_queue;
+    std::vector<std::thread> m_workers;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+    bool m_stopping = false;
+};
+
+// Template method implementations
+template<typename Func>
+auto PythonExecutor::submitTask(Func&& func) -> std::future<decltype(func())> {
+    using ResultType = decltype(func());
+
+    auto promise = std::make_shared<std::promise<ResultType>>();
+    std::future<ResultType> future = promise->get_future();
+
+    enqueue([promise, func = std::forward<Func>(func)]() mutable {
+        try {
+            if constexpr (std::is_void_v<ResultType>) {
+                {
+                    CallTimer timer("PythonExecutor", "task");
+                    py::gil_scoped_acquire gil;
+                    timer.lap(MetricPhase::GilWait);
+                    // Captured Python objects are destroyed before the GIL is released
+                    auto task = std::move(func);
+                    task();
+                    timer.lap(MetricPhase::Python);
+                }
+                promise->set_value();
+            } else {
+                std::optional<ResultType> result;
+                {
+                    CallTimer timer("PythonExecutor", "task");
+                    py::gil_scoped_acquire gil;
+                    timer.lap(MetricPhase::GilWait);
+                    auto task = std::move(func);
+                    result.emplace(task());
+                    timer.lap(MetricPhase::Python);
+                }
+                // Waking the waiter happens after the GIL is released
+                promise->set_value(std::move(*result));
+            }
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+
+    return future;
+}
+
+template<typename ReturnType, typename... Args>
+std::future<ReturnType> PythonExecutor::submit(std::shared_ptr<PythonFunction> func, Args&&... args) {
+    if (!func) {
+        throw std::invalid_argument("PythonExecutor::submit called with a null function");
+    }
+
+    // Arguments are captured by value on the submitting thread, without the GIL;
+    // submitTask destroys them, and the wrapper reference, while the GIL is held
+    return submitTask([func = std::move(func),
+                       packed = std::make_tuple(std::decay_t<Args>(std::forward<Args>(args))...)]() mutable -> ReturnType {
+        return std::apply([&func](auto&... unpacked) -> ReturnType {
+            return func->template call<ReturnType>(unpacked...);
+        }, packed);
+    });
+}
+
+} // namespace cpppy_bridge
@@ -0,0 +1,344 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include "python_bridge.h"
+#include "type_converter.h"
+#include "typed_function.h"
+
+namespace py = pybind11;
+
+namespace cpppy_bridge {
+
+namespace detail {
+
+template<size_t... I, typename... Args>
+PyObject* vectorcallWith(std::index_sequence<I...>, PyObject* callable, PyObject* self, const Args&... args) {
+    constexpr size_t nargs = sizeof...(Args);
+    PyObject* argv[nargs + 2] = {nullptr, self};
+
+    // Convert in order and stop at the first failure, so no conversion runs with an error pending
+    const bool converted = ((argv[I + 2] = detail::toOwnedPyObject(args)) != nullptr && ...);
+
+    PyObject* result = nullptr;
+    if (converted) {
+        // Without self, slot 1 becomes the scratch slot in front of the arguments
+        result = self ? vectorcall(callable, argv, nargs + 1) : vectorcall(callable, argv + 1, nargs);
+    }
+
+    for (size_t i = 2; i < nargs + 2; ++i) {
+        Py_XDECREF(argv[i]);
+    }
+    return result;
+}
+
+// Vectorcall with converted arguments and an optional leading self; new reference or nullptr with an error set
+template<typename... Args>
+PyObject* vectorcallWith(PyObject* callable, PyObject* self, const Args&... args) {
+    return vectorcallWith(std::index_sequence_for<Args...>{}, callable, self, args...);
+}
+
+template<typename ReturnType>
+ReturnType unpackResult(PyObject* result) {
+    if (!result) {
+        throw py::error_already_set();
+    }
+    py::object owned = py::reinterpret_steal<py::object>(result);
+    if constexpr (std::is_void_v<ReturnType>) {
+        return;
+    } else if constexpr (std::is_same_v<ReturnType, py::object>) {
+        return owned;
+    } else {
+        return TypeConverter::fromPython<ReturnType>(owned);
+    }
+}
+
+} // namespace detail
+
+class PythonObject;
+
+/**
+ * @brief Python Class Wrapper
+ * Resolves each method once per class instead of once per call: plain
+ * functions and method descriptors are cached unbound and invoked with the
+ * instance as the first vectorcall argument, so no bound-method object is
+ * created; static and class methods are cached as-is. Anything else
+ * (properties, callables stored on the instance, __getattr__ results) is
+ * looked up on the instance at each call. Methods are resolved on the class,
+ * so instance attributes do not shadow them. A PythonClass is bound to one
+ * version of the class object; PythonBridge::getClass returns a fresh one
+ * after a module reload while existing instances keep theirs. Must be owned
+ * by a std::shared_ptr. Use with the GIL held.
+ */
+class PythonClass : public std::enable_shared_from_this<PythonClass> {
+public:
+    enum class MethodKind {
+        Unbound,     // Called with self prepended
+        Static,      // staticmethod or classmethod, called without self
+        Attribute    // Looked up on the instance at each call
+    };
+
+    struct Method {
+        std::string name;
+        MethodKind kind;
+        py::object callable;
+    };
+
+    explicit PythonClass(py::object type);
+    PythonClass(const std::shared_ptr<PythonModule>& module, const std::string& class_name);
+
+    PythonClass(const PythonClass&) = delete;
+    PythonClass& operator=(const PythonClass&) = delete;
+
+    // Create an instance by calling the class through vectorcall
+    template<typename... Args>
+    std::shared_ptr<PythonObject> instantiate(Args&&... args);
+
+    // Create an instance from pre-converted positional arguments
+    std::shared_ptr<PythonObject> instantiateWith(const py::tuple& args);
+
+    // Resolve a method, caching the result for the lifetime of this class
+    const Method& method(const std::string& name);
+
+    // Call a resolved method on an instance of this class
+    template<typename ReturnType, typename... Args>
+    static ReturnType invoke(const Method& method, const py::object& self, const Args&... args);
+
+    const std::string& getName() const;
+
+    // Underlying type object
+    const py::object& type() const;
+
+private:
+    Method resolve(const std::string& name) const;
+
+    py::object m_type;
+    std::string m_name;
+
+    std::mutex m_methods_mutex;
+    std::unordered_map<std::string, std::unique_ptr<Method>> m_methods;   // Stable addresses for PythonMethod
+};
+
+/**
+ * @brief Method of a specific instance resolved into a reusable call handle
+ * Skips even the per-class name lookup of PythonObject::call.
+ */
+class PythonMethod {
+public:
+    PythonMethod() = default;
+
+    bool isValid() const;
+
+    template<typename ReturnType = py::object, typename... Args>
+    ReturnType call(Args&&... args) const;
+
+private:
+    friend class PythonObject;
+    PythonMethod(py::object self, std::shared_ptr<PythonClass> cls, const PythonClass::Method* method);
+
+    py::object m_self;
+    std::shared_ptr<PythonClass> m_class;
+    const PythonClass::Method* m_method = nullptr;
+};
+
+/**
+ * @brief Python Instance Wrapper
+ * Holds a Python object together with the method table of its class.
+ * Construct, call and destroy with the GIL held.
+ */
+class PythonObject {
+public:
+    // Wrap an existing instance (its class is resolved from type(instance))
+    explicit PythonObject(py::object instance);
+    PythonObject(py::object instance, std::shared_ptr<PythonClass> cls);
+
+    template<typename ReturnType = py::object, typename... Args>
+    ReturnType call(const std::string& method_name, Args&&... args);
+
+    // Resolve a method once for repeated calls
+    PythonMethod method(const std::string& method_name);
+
+    bool hasAttribute(const std::string& attr_name) const;
+
+    template<typename T = py::object>
+    T getAttribute(const std::string& attr_name) const;
+
+    template<typename T>
+    void setAttribute(const std::string& attr_name, const T& value);
+
+    const std::shared_ptr<PythonClass>& getClass() const;
+
+    // Underlying instance
+    const py::object& object() const;
+
+private:
+    py::object m_instance;
+    std::shared_ptr<PythonClass> m_class;
+
+    detail::LiveCounter<PythonObject> m_live;
+};
+
+/**
+ * @brief Pool of instances of one class for multi-threaded callers
+ * Stateful Python components are rarely safe to share between threads, so
+ * each caller either owns an instance for the lifetime of its thread or
+ * leases one exclusively for a unit of work. Instances are created on
+ * demand from the same constructor arguments and reused afterwards; the pool
+ * never shrinks. Instances stay on the class version the pool was created
+ * with. Use with the GIL held; leases must not outlive the pool.
+ */
+class InstancePool {
+public:
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&&) = delete;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        PythonObject& operator*() const { return *m_instance; }
+        PythonObject* operator->() const { return m_instance.get(); }
+
+    private:
+        friend class InstancePool;
+        Lease(InstancePool* pool, std::shared_ptr<PythonObject> instance);
+
+        InstancePool* m_pool;
+        std::shared_ptr<PythonObject> m_instance;
+    };
+
+    InstancePool(std::shared_ptr<PythonClass> cls, py::tuple args);
+    ~InstancePool();
+
+    InstancePool(const InstancePool&) = delete;
+    InstancePool& operator=(const InstancePool&) = delete;
+
+    // Instance owned by the calling thread, created on first use
+    std::shared_ptr<PythonObject> local();
+
+    // Drop the calling thread's instance, e.g. before the thread exits
+    void releaseLocal();
+
+    // Exclusive instance until the lease is destroyed
+    Lease acquire();
+
+    // Instances created so far
+    size_t size() const;
+
+    // Instances waiting in the lease free list
+    size_t available() const;
+
+    const std::shared_ptr<PythonClass>& getClass() const;
+
+private:
+    void giveBack(std::shared_ptr<PythonObject> instance);
+
+    std::shared_ptr<PythonClass> m_class;
+    py::tuple m_args;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::thread::id, std::shared_ptr<PythonObject>> m_local;
+    std::vector<std::shared_ptr<PythonObject>> m_idle;
+    size_t m_created = 0;
+};
+
+// Template method implementations
+template<typename... Args>
+std::shared_ptr<PythonObject> PythonClass::instantiate(Args&&... args) {
+    try {
+        py::object instance = detail::unpackResult<py::object>(detail::vectorcallWith(m_type.ptr(), nullptr, args...));
+        return std::make_shared<PythonObject>(std::move(instance), shared_from_this());
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+        throw; // Should not be reached
+    }
+}
+
+template<typename ReturnType, typename... Args>
+ReturnType PythonClass::invoke(const Method& method, const py::object& self, const Args&... args) {
+    try {
+        if (method.kind == MethodKind::Attribute) {
+            py::object bound = self.attr(method.name.c_str());
+            return detail::unpackResult<ReturnType>(detail::vectorcallWith(bound.ptr(), nullptr, args...));
+        }
+        PyObject* first = method.kind == MethodKind::Unbound ? self.ptr() : nullptr;
+        return detail::unpackResult<ReturnType>(detail::vectorcallWith(method.callable.ptr(), first, args...));
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+        throw; // Should not be reached
+    }
+}
+
+template<typename ReturnType, typename... Args>
+ReturnType PythonMethod::call(Args&&... args) const {
+    if (!m_method) {
+        throw PythonFunctionException("<unresolved method>", "Invalid method");
+    }
+    return PythonClass::invoke<ReturnType>(*m_method, m_self, args...);
+}
+
+template<typename ReturnType, typename... Args>
+ReturnType PythonObject::call(const std::string& method_name, Args&&... args) {
+    return PythonClass::invoke<ReturnType>(m_class->method(method_name), m_instance, args...);
+}
+
+template<typename T>
+T PythonObject::getAttribute(const std::string& attr_name) const {
+    try {
+        py::object value = m_instance.attr(attr_name.c_str());
+        if constexpr (std::is_same_v<T, py::object>) {
+            return value;
+        } else {
+            return TypeConverter::fromPython<T>(value);
+        }
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+        throw; // Should not be reached
+    }
+}
+
+template<typename T>
+void PythonObject::setAttribute(const std::string& attr_name, const T& value) {
+    try {
+        if constexpr (std::is_base_of_v<py::handle, T>) {
+            m_instance.attr(attr_name.c_str()) = value;
+        } else {
+            m_instance.attr(attr_name.c_str()) = TypeConverter::toPython(value);
+        }
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+        throw; // Should not be reached
+    }
+}
+
+template<typename... Args>
+std::shared_ptr<PythonObject> PythonBridge::createInstance(const std::string& module_name,
+                                                           const std::string& class_name,
+                                                           Args&&... args) {
+    return getClass(module_name, class_name)->instantiate(std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+std::shared_ptr<InstancePool> PythonBridge::createInstancePool(const std::string& module_name,
+                                                               const std::string& class_name,
+                                                               Args&&... args) {
+    auto cls = getClass(module_name, class_name);
+    py::tuple ctor_args = py::make_tuple(TypeConverter::toPython(args)...);
+    return std::make_shared<InstancePool>(std::move(cls), std::move(ctor_args));
+}
+
+} // namespace cpppy_bridge
@@ -0,0 +1,343 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include "python_bridge.h"
+#include "type_converter.h"
+
+namespace py = pybind11;
+
+namespace cpppy_bridge {
+
+/**
+ * @brief Options for PythonStream.
+ */
+struct StreamOptions {
+    // Elements pulled from the Python iterator per chunk
+    size_t chunk_size = 4096;
+
+    // Pull the next chunk on a background thread while the current one is consumed
+    bool prefetch = true;
+};
+
+/**
+ * @brief Python iterator exposed as a C++ input range
+ * Elements are pulled in chunks and converted in bulk: scalars are unpacked
+ * directly from the C API and, for arithmetic T, items supporting the buffer
+ * protocol (NumPy arrays, array.array, bytes) are copied whole, so generators
+ * can yield pre-batched arrays. With prefetching at most two chunks are alive
+ * at once, independent of the length of the stream. Python exceptions raised
+ * by the iterator are rethrown when the consumer reaches them. Construct and
+ * destroy with the GIL held; iteration releases it while waiting.
+ */
+template<typename T>
+class PythonStream {
+public:
+    class iterator;
+
+    PythonStream(py::object iterable, StreamOptions options = {});
+    ~PythonStream();
+
+    PythonStream(PythonStream&&) noexcept = default;
+    PythonStream& operator=(PythonStream&&) = delete;
+    PythonStream(const PythonStream&) = delete;
+    PythonStream& operator=(const PythonStream&) = delete;
+
+    // Replace chunk with the next chunk; false once the stream is exhausted
+    bool nextChunk(std::vector<T>& chunk);
+
+    iterator begin();
+    iterator end();
+
+    size_t chunksRead() const;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() = default;
+
+        reference operator*() const { return m_stream->m_current[m_index]; }
+        pointer operator->() const { return &m_stream->m_current[m_index]; }
+        iterator& operator++();
+        void operator++(int) { ++*this; }
+
+        bool operator==(const iterator& other) const { return m_stream == other.m_stream; }
+        bool operator!=(const iterator& other) const { return m_stream != other.m_stream; }
+
+    private:
+        friend class PythonStream;
+        explicit iterator(PythonStream* stream);
+
+        PythonStream* m_stream = nullptr;
+        size_t m_index = 0;
+    };
+
+private:
+    struct State {
+        py::object iterator;
+        StreamOptions options;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::optional<std::vector<T>> ready;   // Prefetched chunk
+        bool exhausted = false;
+        bool stopping = false;
+        std::exception_ptr error;
+        std::thread producer;
+        std::atomic<size_t> chunks{0};
+
+        // Read one chunk from the iterator (GIL held); false at the end
+        bool pull(std::vector<T>& chunk);
+        void produce();
+    };
+
+    std::unique_ptr<State> m_state;
+    std::vector<T> m_current;
+};
+
+// Template method implementations
+template<typename T>
+PythonStream<T>::PythonStream(py::object iterable, StreamOptions options)
+    : m_state(std::make_unique<State>()) {
+    if (options.chunk_size == 0) {
+        options.chunk_size = 1;
+    }
+    m_state->options = options;
+
+    PyObject* iterator = PyObject_GetIter(iterable.ptr());
+    if (!iterator) {
+        throw py::error_already_set();
+    }
+    m_state->iterator = py::reinterpret_steal<py::object>(iterator);
+}
+
+template<typename T>
+PythonStream<T>::~PythonStream() {
+    if (!m_state) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->stopping = true;
+    }
+    m_state->changed.notify_all();
+
+    if (m_state->producer.joinable()) {
+        // The producer needs the GIL to finish its current pull
+        std::optional<py::gil_scoped_release> release;
+        if (PythonInterpreter::holdsGIL()) {
+            release.emplace();
+        }
+        m_state->producer.join();
+    }
+
+    // Closing a generator runs Python code
+    if (Py_IsInitialized()) {
+        py::gil_scoped_acquire gil;
+        m_state->iterator = py::object();
+        m_state->ready.reset();
+        m_current.clear();
+    }
+}
+
+template<typename T>
+bool PythonStream<T>::State::pull(std::vector<T>& chunk) {
+    chunk.clear();
+    if (!iterator) {
+        return false;
+    }
+    if (chunk.capacity() < options.chunk_size) {
+        chunk.reserve(options.chunk_size);
+    }
+
+    std::vector<T> buffered;
+    while (chunk.size() < options.chunk_size) {
+        PyObject* raw = PyIter_Next(iterator.ptr());
+        if (!raw) {
+            if (PyErr_Occurred()) {
+                throw py::error_already_set();
+            }
+            // Release the generator as soon as it is done
+            iterator = py::object();
+            break;
+        }
+        py::object item = py::reinterpret_steal<py::object>(raw);
+
+        // Pre-batched items are copied whole through the buffer protocol
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            if (detail::copyFromBuffer<T>(item, buffered)) {
+                chunk.insert(chunk.end(), buffered.begin(), buffered.end());
+                continue;
+            }
+        }
+        if constexpr (detail::kIsBulkScalar<T>) {
+            chunk.push_back(detail::scalarFromBorrowed<T>(item.ptr()));
+        } else {
+            chunk.push_back(TypeConverter::fromPython<T>(item));
+        }
+    }
+
+    if (chunk.empty()) {
+        return false;
+    }
+    chunks.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template<typename T>
+void PythonStream<T>::State::produce() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return stopping || !ready; });
+            if (stopping) {
+                return;
+            }
+        }
+
+        std::vector<T> chunk;
+        bool more = false;
+        std::exception_ptr failure;
+        {
+            py::gil_scoped_acquire gil;
+            try {
+                more = pull(chunk);
+            } catch (const py::error_already_set& e) {
+                try {
+                    auto error_info = ErrorHandler::handlePythonException(e);
+                    ErrorHandler::convertPythonException(error_info);
+                } catch (...) {
+                    failure = std::current_exception();
+                }
+            } catch (...) {
+                failure = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (failure) {
+                error = failure;
+            } else if (more) {
+                ready = std::move(chunk);
+            }
+            if (failure || !more) {
+                exhausted = true;
+            }
+        }
+        changed.notify_all();
+        if (failure || !more) {
+            return;
+        }
+    }
+}
+
+template<typename T>
+bool PythonStream<T>::nextChunk(std::vector<T>& chunk) {
+    State& state = *m_state;
+
+    if (!state.options.prefetch) {
+        py::gil_scoped_acquire gil;
+        try {
+            return state.pull(chunk);
+        } catch (const py::error_already_set& e) {
+            auto error_info = ErrorHandler::handlePythonException(e);
+            ErrorHandler::convertPythonException(error_info);
+            throw; // Should not be reached
+        }
+    }
+
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    if (!state.producer.joinable() && !state.exhausted) {
+        state.producer = std::thread(&State::produce, &state);
+    }
+    state.changed.wait(lock, [&state] { return state.ready || state.exhausted; });
+
+    if (state.ready) {
+        chunk = std::move(*state.ready);
+        state.ready.reset();
+        lock.unlock();
+        state.changed.notify_all();
+        return true;
+    }
+    if (state.error) {
+        std::exception_ptr error = state.error;
+        state.error = nullptr;
+        std::rethrow_exception(error);
+    }
+    chunk.clear();
+    return false;
+}
+
+template<typename T>
+typename PythonStream<T>::iterator PythonStream<T>::begin() {
+    return iterator(this);
+}
+
+template<typename T>
+typename PythonStream<T>::iterator PythonStream<T>::end() {
+    return iterator();
+}
+
+template<typename T>
+size_t PythonStream<T>::chunksRead() const {
+    return m_state->chunks.load(std::memory_order_relaxed);
+}
+
+template<typename T>
+PythonStream<T>::iterator::iterator(PythonStream* stream) : m_stream(stream) {
+    if (!m_stream->nextChunk(m_stream->m_current)) {
+        m_stream = nullptr;
+    }
+}
+
+template<typename T>
+typename PythonStream<T>::iterator& PythonStream<T>::iterator::operator++() {
+    if (++m_index < m_stream->m_current.size()) {
+        return *this;
+    }
+    m_index = 0;
+    if (!m_stream->nextChunk(m_stream->m_current)) {
+        m_stream = nullptr;
+    }
+    return *this;
+}
+
+template<typename T, typename... Args>
+PythonStream<T> PythonModule::callStream(const std::string& func_name, Args&&... args) {
+    if (!m_loaded) {
+        throw PythonModuleException(m_module_name, "Module not loaded");
+    }
+
+    py::gil_scoped_acquire gil;
+    try {
+        py::object result = m_module.attr(func_name.c_str())(std::forward<Args>(args)...);
+        return PythonStream<T>(std::move(result));
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+        throw; // Should not be reached
+    }
+}
+
+} // namespace cpppy_bridge
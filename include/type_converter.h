@@ -9,12 +9,68 @@
 #include <tuple>
 #include <optional>
 #include <variant>
+#include <memory>
+#include <memory_resource>
+#include <iterator>
+#include <atomic>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
+#include "bridge_metrics.h"
+#include "matrix.h"
 
 namespace py = pybind11;
 
+// Apache Arrow C Data Interface (https://arrow.apache.org/docs/format/CDataInterface.html)
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
 namespace cpppy_bridge {
 
 /**
@@ -53,6 +109,8 @@ private:
     static bool isPythonDict(const py::object& obj);
     static bool isPythonTuple(const py::object& obj);
     static bool isPythonSet(const py::object& obj);
+    
+    friend class ComplexTypeConverter;
 };
 
 /**
@@ -74,6 +132,12 @@ public:
     template<typename K, typename V>
     static std::map<K, V> mapFromPython(const py::object& obj);
     
+    template<typename K, typename V>
+    static py::object mapToPython(const std::unordered_map<K, V>& map);
+    
+    template<typename K, typename V>
+    static std::unordered_map<K, V> unorderedMapFromPython(const py::object& obj);
+    
     // Tuple conversion
     template<typename... Args>
     static py::object tupleToPython(const std::tuple<Args...>& tuple);
@@ -94,6 +158,117 @@ public:
     
     template<typename... Types>
     static std::variant<Types...> variantFromPython(const py::object& obj);
+    
+    // Matrix conversion (nested lists for pure-Python consumers)
+    template<typename T>
+    static py::object matrixToPython(const Matrix<T>& matrix);
+    
+    // Accepts NumPy arrays (zero-copy) or nested sequences (single allocation)
+    template<typename T>
+    static Matrix<T> matrixFromPython(const py::object& obj);
+    
+    // Output containers allocated from a memory resource, e.g. a ConversionArena.
+    // Only the container storage comes from the resource; elements that allocate
+    // themselves (std::string) keep their own allocator.
+    template<typename T>
+    static std::pmr::vector<T> vectorFromPython(const py::object& obj, std::pmr::memory_resource* resource);
+    
+    template<typename K, typename V>
+    static std::pmr::map<K, V> mapFromPython(const py::object& obj, std::pmr::memory_resource* resource);
+    
+    template<typename K, typename V>
+    static std::pmr::unordered_map<K, V> unorderedMapFromPython(const py::object& obj,
+                                                                std::pmr::memory_resource* resource);
+    
+private:
+    // Shared sequence -> vector conversion for any allocator
+    template<typename T, typename Alloc>
+    static void vectorFromPythonInto(const py::object& obj, std::vector<T, Alloc>& result);
+    
+    // Shared dict <-> map-like container conversion
+    template<typename Map>
+    static py::object mapLikeToPython(const Map& map);
+    
+    template<typename Map>
+    static Map mapLikeFromPython(const py::object& obj, Map result = Map());
+};
+
+/**
+ * @brief Read-only NumPy View
+ * Span-style accessor over the buffer of a NumPy array. Holds a reference to
+ * the array so the buffer stays alive, and honours arbitrary strides, so
+ * slices, transposes and other non-contiguous arrays are read without a copy.
+ * Like any py::object holder it must be copied and destroyed with the GIL held.
+ */
+template<typename T>
+class NumpyView {
+public:
+    /**
+     * @brief Iterator over the elements of a 1D view.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        const_iterator() = default;
+        const_iterator(const char* ptr, py::ssize_t stride) : m_ptr(ptr), m_stride(stride) {}
+        
+        reference operator*() const { return *reinterpret_cast<const T*>(m_ptr); }
+        reference operator[](difference_type n) const { return *reinterpret_cast<const T*>(m_ptr + n * m_stride); }
+        const_iterator& operator++() { m_ptr += m_stride; return *this; }
+        const_iterator operator++(int) { const_iterator tmp = *this; m_ptr += m_stride; return tmp; }
+        const_iterator& operator--() { m_ptr -= m_stride; return *this; }
+        const_iterator operator--(int) { const_iterator tmp = *this; m_ptr -= m_stride; return tmp; }
+        const_iterator& operator+=(difference_type n) { m_ptr += n * m_stride; return *this; }
+        const_iterator& operator-=(difference_type n) { m_ptr -= n * m_stride; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(m_ptr + n * m_stride, m_stride); }
+        const_iterator operator-(difference_type n) const { return const_iterator(m_ptr - n * m_stride, m_stride); }
+        difference_type operator-(const const_iterator& other) const { return m_stride ? (m_ptr - other.m_ptr) / m_stride : 0; }
+        bool operator==(const const_iterator& other) const { return m_ptr == other.m_ptr; }
+        bool operator!=(const const_iterator& other) const { return m_ptr != other.m_ptr; }
+        bool operator<(const const_iterator& other) const { return (other - *this) > 0; }
+        bool operator>(const const_iterator& other) const { return other < *this; }
+        bool operator<=(const const_iterator& other) const { return !(other < *this); }
+        bool operator>=(const const_iterator& other) const { return !(*this < other); }
+        
+    private:
+        const char* m_ptr = nullptr;
+        py::ssize_t m_stride = 0;
+    };
+    
+    explicit NumpyView(const py::array& arr);
+    
+    size_t ndim() const;
+    size_t size() const;
+    size_t shape(size_t dim) const;
+    py::ssize_t stride(size_t dim) const;   // In bytes
+    bool isContiguous() const;              // C-contiguous layout
+    bool empty() const;
+    
+    // Pointer to the first element (only dense when isContiguous())
+    const T* data() const;
+    
+    // Element access for 1D and 2D views
+    const T& operator[](size_t i) const;
+    const T& operator()(size_t i, size_t j) const;
+    
+    // Iteration over 1D views
+    const_iterator begin() const;
+    const_iterator end() const;
+    
+    // The array that owns the buffer
+    const py::array& array() const;
+    
+private:
+    py::array m_array;
+    const char* m_data = nullptr;
+    std::vector<py::ssize_t> m_shape;
+    std::vector<py::ssize_t> m_strides;
+    size_t m_size = 0;
 };
 
 /**
@@ -106,6 +281,18 @@ public:
     template<typename T>
     static py::array_t<T> vectorToNumpy(const std::vector<T>& vec);
     
+    // Zero-copy: the array takes ownership of the moved-in vector
+    template<typename T>
+    static py::array_t<T> vectorToNumpy(std::vector<T>&& vec);
+    
+    // Zero-copy: the array shares ownership of the buffer
+    template<typename T>
+    static py::array_t<T> sharedToNumpy(std::shared_ptr<T[]> data, size_t size);
+    
+    // Zero-copy read-only access to any (possibly strided) array
+    template<typename T>
+    static NumpyView<T> view(const py::array& arr);
+    
     template<typename T>
     static std::vector<T> numpyToVector(const py::array_t<T>& arr);
     
@@ -116,24 +303,153 @@ public:
     template<typename T>
     static std::vector<std::vector<T>> numpyToMatrix2D(const py::array_t<T>& arr);
     
+    // Outputs allocated from a memory resource; every row of the 2D result shares it
+    template<typename T>
+    static std::pmr::vector<T> numpyToVector(const py::array_t<T>& arr, std::pmr::memory_resource* resource);
+    
+    template<typename T>
+    static std::pmr::vector<std::pmr::vector<T>> numpyToMatrix2D(const py::array_t<T>& arr,
+                                                                 std::pmr::memory_resource* resource);
+    
+    // Zero-copy Matrix conversion; the array and the matrix share one buffer
+    template<typename T>
+    static py::array_t<T> matrixToNumpy(const Matrix<T>& matrix);
+    
+    template<typename T>
+    static Matrix<T> numpyToMatrix(const py::array_t<T>& arr);
+    
     // Get general array information
     static std::vector<size_t> getArrayShape(const py::array& arr);
     static std::string getArrayDtype(const py::array& arr);
     static size_t getArraySize(const py::array& arr);
 };
 
+/**
+ * @brief Arrow format string for a primitive column element type.
+ */
+template<typename T>
+struct ArrowFormat;
+
+template<> struct ArrowFormat<double> { static constexpr const char* value = "g"; };
+template<> struct ArrowFormat<float> { static constexpr const char* value = "f"; };
+template<> struct ArrowFormat<int64_t> { static constexpr const char* value = "l"; };
+template<> struct ArrowFormat<int32_t> { static constexpr const char* value = "i"; };
+
+/**
+ * @brief Columnar Table
+ * Named, equally sized columns of contiguous primitive values (double, float,
+ * int64_t, int32_t). Every column shares ownership of its buffer, so moving a
+ * vector in, exporting to Arrow or importing from Arrow never copies values.
+ * Copies of a table share the same buffers.
+ */
+class ColumnarTable {
+public:
+    struct Column {
+        std::string name;
+        const char* format = nullptr;       // One of the ArrowFormat<T>::value strings
+        const void* data = nullptr;
+        std::shared_ptr<const void> owner;  // Keeps the buffer alive
+    };
+    
+    // Take ownership of a vector without copying it
+    template<typename T>
+    void addColumn(const std::string& name, std::vector<T>&& values);
+    
+    // Wrap existing storage; owner keeps the buffer alive
+    template<typename T>
+    void addColumn(const std::string& name, const T* data, size_t length, std::shared_ptr<const void> owner);
+    
+    size_t numRows() const;
+    size_t numColumns() const;
+    bool hasColumn(const std::string& name) const;
+    std::vector<std::string> columnNames() const;
+    const std::vector<Column>& columns() const;
+    
+    // Typed access to a column; throws if it is missing or has another element type
+    template<typename T>
+    const T* column(const std::string& name) const;
+    
+    template<typename T>
+    std::vector<T> columnToVector(const std::string& name) const;
+    
+private:
+    friend class ColumnarConverter;
+    
+    const Column& findColumn(const std::string& name) const;
+    void appendColumn(Column column, size_t length);
+    
+    std::vector<Column> m_columns;
+    size_t m_rows = 0;
+};
+
+/**
+ * @brief Columnar Interchange Converter
+ * Moves tables across the bridge through the Arrow C Data Interface. Exported
+ * tables are Python objects implementing the Arrow PyCapsule protocol
+ * (__arrow_c_array__), which pyarrow, pandas and polars consume without
+ * copying; any object exposing __arrow_c_array__ with a struct of primitive,
+ * null-free columns (e.g. pyarrow.RecordBatch) can be imported.
+ *
+ * The exported ColumnarBatch type is created on first use in the calling
+ * interpreter and is available as the _cpppy_columnar module.
+ */
+class ColumnarConverter {
+public:
+    // C++ -> Python: object implementing __arrow_c_array__ / __arrow_c_schema__
+    static py::object toArrow(const ColumnarTable& table);
+    
+    // Convenience for the column name -> values shape; the vectors are moved, not copied
+    static py::object mapToArrow(std::map<std::string, std::vector<double>>&& columns);
+    
+    // Python -> C++: import any __arrow_c_array__ producer without copying
+    static ColumnarTable fromArrow(const py::object& obj);
+    
+    // Copy every column into the column name -> values shape
+    static std::map<std::string, std::vector<double>> toColumnMap(const ColumnarTable& table);
+    
+    // Low-level C Data Interface access. exportTable fills caller-provided
+    // structs that the consumer must release; importTable takes ownership of
+    // array and releases schema.
+    static void exportTable(const ColumnarTable& table, ArrowSchema* schema, ArrowArray* array);
+    static ColumnarTable importTable(ArrowSchema* schema, ArrowArray* array);
+};
+
+/**
+ * @brief Whether a custom converter may be registered for a type
+ * Arithmetic types, std::string and pybind11 object wrappers always use the
+ * built-in conversions, so the registry lookup is removed at compile time.
+ * Specialize to std::false_type to opt other hot types out as well.
+ */
+template<typename T, typename = void>
+struct CustomConvertible : std::true_type {};
+
+template<typename T>
+struct CustomConvertible<T, std::enable_if_t<std::is_arithmetic_v<T> ||
+                                             std::is_same_v<T, std::string> ||
+                                             std::is_base_of_v<py::handle, T>>> : std::false_type {};
+
 /**
  * @brief Custom Type Registry
  * Allows users to register custom type conversion functions.
+ *
+ * Every C++ type gets its own statically allocated slot, so a lookup is a
+ * single atomic load with no hashing and no locking. Converters are stored
+ * with their real signature and return results by value.
  */
 class CustomTypeRegistry {
 public:
-    // Register custom conversion functions
     template<typename CppType>
-    static void registerToPython(std::function<py::object(const CppType&)> converter);
+    using ToPythonFunc = std::function<py::object(const CppType&)>;
+    
+    template<typename CppType>
+    using FromPythonFunc = std::function<CppType(const py::object&)>;
     
+    // Register custom conversion functions (replaces any previous converter)
     template<typename CppType>
-    static void registerFromPython(std::function<CppType(const py::object&)> converter);
+    static void registerToPython(ToPythonFunc<CppType> converter);
+    
+    template<typename CppType>
+    static void registerFromPython(FromPythonFunc<CppType> converter);
     
     // Check if a converter is registered
     template<typename CppType>
@@ -142,6 +458,13 @@ public:
     template<typename CppType>
     static bool hasFromPythonConverter();
     
+    // Registered converter, or nullptr
+    template<typename CppType>
+    static const ToPythonFunc<CppType>* findToPython();
+    
+    template<typename CppType>
+    static const FromPythonFunc<CppType>* findFromPython();
+    
     // Use a registered converter
     template<typename CppType>
     static py::object convertToPython(const CppType& value);
@@ -149,9 +472,19 @@ public:
     template<typename CppType>
     static CppType convertFromPython(const py::object& obj);
     
+    // Converters kept alive by the registry, including replaced ones
+    static size_t retainedCount();
+    
 private:
-    static std::unordered_map<std::string, std::function<py::object(const void*)>> s_to_python_converters;
-    static std::unordered_map<std::string, std::function<void*(const py::object&)>> s_from_python_converters;
+    template<typename CppType>
+    struct Slot {
+        static inline std::atomic<const ToPythonFunc<CppType>*> to_python{nullptr};
+        static inline std::atomic<const FromPythonFunc<CppType>*> from_python{nullptr};
+    };
+    
+    // Keeps converters alive for the lifetime of the program; a replaced
+    // converter may still be running on another thread
+    static void retain(std::shared_ptr<const void> converter);
 };
 
 // Convenience macro
@@ -178,4 +511,37 @@ template<> long TypeConverter::fromPython<long>(const py::object& obj);
 
 } // namespace cpppy_bridge
 
+namespace pybind11 {
+namespace detail {
+
+/**
+ * @brief pybind11 caster for cpppy_bridge::Matrix
+ * Lets Matrix<T> be passed to and returned from bridge calls directly:
+ * C++ -> Python produces a zero-copy NumPy array, Python -> C++ accepts
+ * arrays (zero-copy) or nested sequences.
+ */
+template<typename T>
+struct type_caster<cpppy_bridge::Matrix<T>> {
+    PYBIND11_TYPE_CASTER(cpppy_bridge::Matrix<T>, _("numpy.ndarray"));
+    
+    bool load(handle src, bool convert) {
+        if (!convert && !array_t<T>::check_(src)) {
+            return false;
+        }
+        try {
+            value = cpppy_bridge::ComplexTypeConverter::matrixFromPython<T>(reinterpret_borrow<object>(src));
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    
+    static handle cast(const cpppy_bridge::Matrix<T>& src, return_value_policy, handle) {
+        return cpppy_bridge::NumpyConverter::matrixToNumpy(src).release();
+    }
+};
+
+} // namespace detail
+} // namespace pybind11
+
 #include "type_converter.inl"
\ No newline at end of file
@@ -4,41 +4,397 @@
 #include <iostream>
 #include <typeinfo>
 #include <typeindex>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
 
 namespace cpppy_bridge {
 
+namespace detail {
+
+// Standard containers routed through the ComplexTypeConverter bulk paths
+template<typename T>
+struct IsStdVector : std::false_type {};
+
+template<typename T>
+struct IsStdVector<std::vector<T>> : std::true_type {};
+
+template<typename T>
+struct IsStdMap : std::false_type {};
+
+template<typename K, typename V>
+struct IsStdMap<std::map<K, V>> : std::true_type {};
+
+template<typename T>
+struct IsStdUnorderedMap : std::false_type {};
+
+template<typename K, typename V>
+struct IsStdUnorderedMap<std::unordered_map<K, V>> : std::true_type {};
+
+template<typename T>
+struct IsStdVariant : std::false_type {};
+
+template<typename... Types>
+struct IsStdVariant<std::variant<Types...>> : std::true_type {};
+
+// Character types, which pybind11 converts to and from one-character str rather than int
+template<typename T>
+constexpr bool kIsCharType = py::detail::is_std_char_type<T>::value;
+
+// Scalars converted directly through the C API in bulk paths
+template<typename T>
+constexpr bool kIsBulkScalar = (std::is_arithmetic_v<T> && !kIsCharType<T>) || std::is_same_v<T, std::string>;
+
+// Containers that can preallocate, e.g. unordered maps with any allocator
+template<typename T, typename = void>
+struct HasReserve : std::false_type {};
+
+template<typename T>
+struct HasReserve<T, std::void_t<decltype(std::declval<T&>().reserve(size_t{}))>> : std::true_type {};
+
+// Convert a C++ value straight to a new reference, without py::object temporaries for scalars
+template<typename T>
+PyObject* toOwnedPyObject(const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        PyObject* result = value ? Py_True : Py_False;
+        Py_INCREF(result);
+        return result;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return PyFloat_FromDouble(static_cast<double>(value));
+    } else if constexpr (std::is_integral_v<T> && !kIsCharType<T> && std::is_signed_v<T>) {
+        return PyLong_FromLongLong(static_cast<long long>(value));
+    } else if constexpr (std::is_integral_v<T> && !kIsCharType<T>) {
+        return PyLong_FromUnsignedLongLong(static_cast<unsigned long long>(value));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return PyUnicode_FromStringAndSize(value.data(), static_cast<Py_ssize_t>(value.size()));
+    } else {
+        // Report conversion failures as a pending Python error, like the C API does
+        try {
+            return TypeConverter::toPython(value).release().ptr();
+        } catch (py::error_already_set& e) {
+            e.restore();
+        } catch (const std::exception& e) {
+            PyErr_SetString(PyExc_TypeError, e.what());
+        }
+        return nullptr;
+    }
+}
+
+// Load through the pybind11 caster without raising; nullopt if the object does not convert
+template<typename T>
+std::optional<T> loadWithCaster(const py::object& obj) {
+    py::detail::make_caster<T> caster;
+    if (!caster.load(obj, true)) {
+        PyErr_Clear();
+        return std::nullopt;
+    }
+    return py::detail::cast_op<T&&>(std::move(caster));
+}
+
+// Slow path of scalarFromBorrowed for numpy scalars, subclasses and other convertible objects
+template<typename T>
+T scalarFromCaster(PyObject* item, const char* error) {
+    if (auto value = loadWithCaster<T>(py::reinterpret_borrow<py::object>(item))) {
+        return std::move(*value);
+    }
+    throw std::runtime_error(error);
+}
+
+// Convert a borrowed scalar with the same acceptance rules as TypeConverter::fromPython
+template<typename T>
+T scalarFromBorrowed(PyObject* item) {
+    static_assert(kIsBulkScalar<T>, "scalarFromBorrowed requires a non-character arithmetic type or std::string");
+    
+    if constexpr (std::is_same_v<T, bool>) {
+        if (!PyBool_Check(item)) {
+            return scalarFromCaster<T>(item, "Cannot convert Python object to bool");
+        }
+        return item == Py_True;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (!PyFloat_Check(item) && !PyLong_Check(item)) {
+            return scalarFromCaster<T>(item, "Cannot convert Python object to floating point");
+        }
+        double value = PyFloat_AsDouble(item);
+        if (value == -1.0 && PyErr_Occurred()) {
+            throw py::error_already_set();
+        }
+        return static_cast<T>(value);
+    } else if constexpr (std::is_integral_v<T>) {
+        if (!PyLong_Check(item)) {
+            return scalarFromCaster<T>(item, "Cannot convert Python object to integer");
+        }
+        if constexpr (std::is_signed_v<T>) {
+            long long value = PyLong_AsLongLong(item);
+            if (value == -1 && PyErr_Occurred()) {
+                throw py::error_already_set();
+            }
+            if (value < static_cast<long long>(std::numeric_limits<T>::min()) ||
+                value > static_cast<long long>(std::numeric_limits<T>::max())) {
+                throw std::runtime_error("Python integer out of range");
+            }
+            return static_cast<T>(value);
+        } else {
+            unsigned long long value = PyLong_AsUnsignedLongLong(item);
+            if (value == static_cast<unsigned long long>(-1) && PyErr_Occurred()) {
+                throw py::error_already_set();
+            }
+            if (value > static_cast<unsigned long long>(std::numeric_limits<T>::max())) {
+                throw std::runtime_error("Python integer out of range");
+            }
+            return static_cast<T>(value);
+        }
+    } else {
+        if (!PyUnicode_Check(item)) {
+            return scalarFromCaster<T>(item, "Cannot convert Python object to std::string");
+        }
+        Py_ssize_t size = 0;
+        const char* data = PyUnicode_AsUTF8AndSize(item, &size);
+        if (!data) {
+            throw py::error_already_set();
+        }
+        return std::string(data, static_cast<size_t>(size));
+    }
+}
+
+// Copy a 1D buffer-protocol object whose format matches T; false if it does not apply
+template<typename T, typename Alloc>
+bool copyFromBuffer(const py::object& obj, std::vector<T, Alloc>& out) {
+    if (!PyObject_CheckBuffer(obj.ptr())) {
+        return false;
+    }
+    
+    py::buffer_info info = py::reinterpret_borrow<py::buffer>(obj).request();
+    if (info.ndim != 1 || !py::detail::compare_buffer_info<T>::compare(info)) {
+        return false;
+    }
+    
+    const size_t count = static_cast<size_t>(info.shape[0]);
+    const char* src = static_cast<const char*>(info.ptr);
+    out.resize(count);
+    if (info.strides[0] == static_cast<py::ssize_t>(sizeof(T))) {
+        std::memcpy(out.data(), src, count * sizeof(T));
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(&out[i], src + static_cast<py::ssize_t>(i) * info.strides[0], sizeof(T));
+        }
+    }
+    return true;
+}
+
+// Copy a 1D array into a vector with any allocator, following its strides
+template<typename T, typename Alloc>
+void assignFromNumpy(const py::array_t<T>& arr, std::vector<T, Alloc>& out) {
+    NumpyView<T> view(arr);
+    
+    if (view.ndim() != 1) {
+        throw std::runtime_error("Expected 1D array for vector conversion");
+    }
+    
+    if (view.isContiguous()) {
+        out.assign(view.data(), view.data() + view.size());
+    } else {
+        out.assign(view.begin(), view.end());
+    }
+}
+
+template<typename T>
+NumpyView<T> matrix2DView(const py::array_t<T>& arr) {
+    NumpyView<T> view(arr);
+    if (view.ndim() != 2) {
+        throw std::runtime_error("Expected 2D array for matrix conversion");
+    }
+    return view;
+}
+
+// Copy a 2D view into preallocated rows
+template<typename T, typename Rows>
+void copyRows(const NumpyView<T>& view, Rows& rows) {
+    const size_t cols = view.shape(1);
+    
+    if (view.isContiguous()) {
+        const T* ptr = view.data();
+        for (size_t i = 0; i < rows.size(); ++i) {
+            std::copy(ptr + i * cols, ptr + (i + 1) * cols, rows[i].begin());
+        }
+        return;
+    }
+    
+    for (size_t i = 0; i < rows.size(); ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            rows[i][j] = view(i, j);
+        }
+    }
+}
+
+// Exact Python type check for a C++ alternative, used to route variants without trial conversions
+template<typename T, typename = void>
+struct PyTypeTag {
+    static constexpr bool kKnown = false;
+    static bool matches(PyObject*) { return false; }
+};
+
+template<>
+struct PyTypeTag<bool> {
+    static constexpr bool kKnown = true;
+    static bool matches(PyObject* obj) { return PyBool_Check(obj); }
+};
+
+template<typename T>
+struct PyTypeTag<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+    static constexpr bool kKnown = true;
+    static bool matches(PyObject* obj) { return PyLong_Check(obj) && !PyBool_Check(obj); }
+};
+
+template<typename T>
+struct PyTypeTag<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static constexpr bool kKnown = true;
+    static bool matches(PyObject* obj) { return PyFloat_Check(obj); }
+};
+
+template<>
+struct PyTypeTag<std::string> {
+    static constexpr bool kKnown = true;
+    static bool matches(PyObject* obj) { return PyUnicode_Check(obj); }
+};
+
+template<>
+struct PyTypeTag<std::monostate> {
+    static constexpr bool kKnown = true;
+    static bool matches(PyObject* obj) { return obj == Py_None; }
+};
+
+template<>
+struct PyTypeTag<std::nullptr_t> : PyTypeTag<std::monostate> {};
+
+template<typename T>
+struct PyTypeTag<std::optional<T>> {
+    static constexpr bool kKnown = true;
+    static bool matches(PyObject* obj) { return obj == Py_None || PyTypeTag<T>::matches(obj); }
+};
+
+// Containers also check their first element, so variants of several vector types route correctly
+template<typename T>
+struct PyTypeTag<std::vector<T>> {
+    static constexpr bool kKnown = true;
+    static bool matches(PyObject* obj) {
+        if (PyList_Check(obj)) {
+            return PyList_GET_SIZE(obj) == 0 || !PyTypeTag<T>::kKnown || PyTypeTag<T>::matches(PyList_GET_ITEM(obj, 0));
+        }
+        if (PyTuple_Check(obj)) {
+            return PyTuple_GET_SIZE(obj) == 0 || !PyTypeTag<T>::kKnown || PyTypeTag<T>::matches(PyTuple_GET_ITEM(obj, 0));
+        }
+        return false;
+    }
+};
+
+template<typename K, typename V>
+struct PyTypeTag<std::map<K, V>> {
+    static constexpr bool kKnown = true;
+    static bool matches(PyObject* obj) {
+        if (!PyDict_Check(obj)) {
+            return false;
+        }
+        Py_ssize_t pos = 0;
+        PyObject* key = nullptr;
+        PyObject* value = nullptr;
+        if (!PyDict_Next(obj, &pos, &key, &value)) {
+            return true;
+        }
+        return (!PyTypeTag<K>::kKnown || PyTypeTag<K>::matches(key)) &&
+               (!PyTypeTag<V>::kKnown || PyTypeTag<V>::matches(value));
+    }
+};
+
+template<typename K, typename V>
+struct PyTypeTag<std::unordered_map<K, V>> : PyTypeTag<std::map<K, V>> {};
+
+template<typename... T>
+struct PyTypeTag<std::tuple<T...>> {
+    static constexpr bool kKnown = true;
+    static bool matches(PyObject* obj) {
+        return PyTuple_Check(obj) && PyTuple_GET_SIZE(obj) == static_cast<Py_ssize_t>(sizeof...(T));
+    }
+};
+
+template<typename A, typename B>
+struct PyTypeTag<std::pair<A, B>> : PyTypeTag<std::tuple<A, B>> {};
+
+// Short-circuiting f(integral_constant<I>) over an index sequence, in order
+template<typename F, size_t... I>
+bool anyIndex(F&& f, std::index_sequence<I...>) {
+    return (f(std::integral_constant<size_t, I>{}) || ...);
+}
+
+// Deduce the alternatives of a variant type for ComplexTypeConverter::variantFromPython
+template<typename... Types>
+std::variant<Types...> variantFromPython(const py::object& obj, std::variant<Types...>*) {
+    return ComplexTypeConverter::variantFromPython<Types...>(obj);
+}
+
+} // namespace detail
+
 // TypeConverter implementation
 
 template<typename T>
 py::object TypeConverter::toPython(const T& value) {
+    ConversionTimer timer(MetricPhase::ArgConversion);
+    
     // Check for a custom converter
-    if (CustomTypeRegistry::hasToPythonConverter<T>()) {
-        return CustomTypeRegistry::convertToPython<T>(value);
+    if constexpr (CustomConvertible<T>::value) {
+        if (const auto* converter = CustomTypeRegistry::findToPython<T>()) {
+            return (*converter)(value);
+        }
     }
     
-    // Use pybind11's default conversion
-    return py::cast(value);
+    // Bulk paths for standard containers
+    if constexpr (detail::IsStdVector<T>::value) {
+        return ComplexTypeConverter::vectorToPython(value);
+    } else if constexpr (detail::IsStdMap<T>::value || detail::IsStdUnorderedMap<T>::value) {
+        return ComplexTypeConverter::mapToPython(value);
+    } else {
+        // Use pybind11's default conversion
+        return py::cast(value);
+    }
 }
 
 template<typename T>
 T TypeConverter::fromPython(const py::object& obj) {
+    ConversionTimer timer(MetricPhase::ResultConversion);
+    
     // Check for a custom converter
-    if (CustomTypeRegistry::hasFromPythonConverter<T>()) {
-        return CustomTypeRegistry::convertFromPython<T>(obj);
+    if constexpr (CustomConvertible<T>::value) {
+        if (const auto* converter = CustomTypeRegistry::findFromPython<T>()) {
+            return (*converter)(obj);
+        }
     }
     
-    // Use pybind11's default conversion
-    return obj.cast<T>();
+    // Bulk paths for standard containers
+    if constexpr (detail::IsStdVector<T>::value) {
+        return ComplexTypeConverter::vectorFromPython<typename T::value_type>(obj);
+    } else if constexpr (detail::IsStdMap<T>::value) {
+        return ComplexTypeConverter::mapFromPython<typename T::key_type, typename T::mapped_type>(obj);
+    } else if constexpr (detail::IsStdUnorderedMap<T>::value) {
+        return ComplexTypeConverter::unorderedMapFromPython<typename T::key_type, typename T::mapped_type>(obj);
+    } else if constexpr (detail::IsStdVariant<T>::value) {
+        return detail::variantFromPython(obj, static_cast<T*>(nullptr));
+    } else {
+        // Use pybind11's default conversion
+        return obj.cast<T>();
+    }
 }
 
 template<typename T>
 bool TypeConverter::canConvert(const py::object& obj) {
-    try {
-        obj.cast<T>();
+    // Same acceptance rules as obj.cast<T>(), but a mismatch is reported without throwing
+    py::detail::make_caster<T> caster;
+    if (caster.load(obj, true)) {
         return true;
-    } catch (const py::cast_error&) {
-        return false;
     }
+    PyErr_Clear();
+    return false;
 }
 
 template<typename T>
@@ -54,58 +410,154 @@ std::optional<T> TypeConverter::safeCast(const py::object& obj) {
 
 template<typename T>
 py::object ComplexTypeConverter::vectorToPython(const std::vector<T>& vec) {
-    py::list result;
-    for (const auto& item : vec) {
-        result.append(TypeConverter::toPython(item));
+    // Preallocate the list and fill its slots directly
+    py::list result(vec.size());
+    PyObject* list = result.ptr();
+    
+    for (size_t i = 0; i < vec.size(); ++i) {
+        if constexpr (detail::kIsBulkScalar<T>) {
+            PyObject* item = detail::toOwnedPyObject<T>(vec[i]);
+            if (!item) {
+                throw py::error_already_set();
+            }
+            PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i), item);
+        } else {
+            PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i), TypeConverter::toPython(vec[i]).release().ptr());
+        }
     }
     return result;
 }
 
 template<typename T>
 std::vector<T> ComplexTypeConverter::vectorFromPython(const py::object& obj) {
-    if (!TypeConverter::isPythonList(obj)) {
-        throw std::runtime_error("Expected Python list for vector conversion");
+    std::vector<T> result;
+    vectorFromPythonInto(obj, result);
+    return result;
+}
+
+template<typename T>
+std::pmr::vector<T> ComplexTypeConverter::vectorFromPython(const py::object& obj, std::pmr::memory_resource* resource) {
+    std::pmr::vector<T> result(resource);
+    vectorFromPythonInto(obj, result);
+    return result;
+}
+
+template<typename T, typename Alloc>
+void ComplexTypeConverter::vectorFromPythonInto(const py::object& obj, std::vector<T, Alloc>& result) {
+    // Arithmetic vectors accept any buffer-protocol object (array.array, NumPy, memoryview)
+    if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+        if (detail::copyFromBuffer<T>(obj, result)) {
+            return;
+        }
+        if (PyObject_HasAttrString(obj.ptr(), "__array_interface__")) {
+            auto arr = py::array_t<T>::ensure(obj);
+            if (arr) {
+                detail::assignFromNumpy(arr, result);
+                return;
+            }
+        }
     }
     
-    py::list py_list = obj.cast<py::list>();
-    std::vector<T> result;
-    result.reserve(py_list.size());
+    if (TypeConverter::isPythonString(obj) || !PySequence_Check(obj.ptr())) {
+        throw std::runtime_error("Expected Python list for vector conversion");
+    }
     
-    for (const auto& item : py_list) {
-        result.push_back(TypeConverter::fromPython<T>(item));
+    // Lists and tuples are read in place; other sequences are materialized once
+    py::object fast = py::reinterpret_steal<py::object>(
+        PySequence_Fast(obj.ptr(), "Expected Python list for vector conversion"));
+    if (!fast) {
+        throw py::error_already_set();
     }
     
-    return result;
+    const Py_ssize_t size = PySequence_Fast_GET_SIZE(fast.ptr());
+    PyObject** items = PySequence_Fast_ITEMS(fast.ptr());
+    result.reserve(static_cast<size_t>(size));
+    
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        if constexpr (detail::kIsBulkScalar<T>) {
+            result.push_back(detail::scalarFromBorrowed<T>(items[i]));
+        } else {
+            result.push_back(TypeConverter::fromPython<T>(py::reinterpret_borrow<py::object>(items[i])));
+        }
+    }
 }
 
 template<typename K, typename V>
 py::object ComplexTypeConverter::mapToPython(const std::map<K, V>& map) {
+    return mapLikeToPython(map);
+}
+
+template<typename K, typename V>
+std::map<K, V> ComplexTypeConverter::mapFromPython(const py::object& obj) {
+    return mapLikeFromPython<std::map<K, V>>(obj);
+}
+
+template<typename K, typename V>
+py::object ComplexTypeConverter::mapToPython(const std::unordered_map<K, V>& map) {
+    return mapLikeToPython(map);
+}
+
+template<typename K, typename V>
+std::unordered_map<K, V> ComplexTypeConverter::unorderedMapFromPython(const py::object& obj) {
+    return mapLikeFromPython<std::unordered_map<K, V>>(obj);
+}
+
+template<typename K, typename V>
+std::pmr::map<K, V> ComplexTypeConverter::mapFromPython(const py::object& obj, std::pmr::memory_resource* resource) {
+    return mapLikeFromPython(obj, std::pmr::map<K, V>(resource));
+}
+
+template<typename K, typename V>
+std::pmr::unordered_map<K, V> ComplexTypeConverter::unorderedMapFromPython(const py::object& obj,
+                                                                           std::pmr::memory_resource* resource) {
+    return mapLikeFromPython(obj, std::pmr::unordered_map<K, V>(resource));
+}
+
+template<typename Map>
+py::object ComplexTypeConverter::mapLikeToPython(const Map& map) {
+    using K = typename Map::key_type;
+    using V = typename Map::mapped_type;
+    
     py::dict result;
     for (const auto& [key, value] : map) {
-        result[TypeConverter::toPython(key)] = TypeConverter::toPython(value);
+        py::object py_key = TypeConverter::toPython<K>(key);
+        py::object py_value = TypeConverter::toPython<V>(value);
+        if (PyDict_SetItem(result.ptr(), py_key.ptr(), py_value.ptr()) != 0) {
+            throw py::error_already_set();
+        }
     }
     return result;
 }
 
-template<typename K, typename V>
-std::map<K, V> ComplexTypeConverter::mapFromPython(const py::object& obj) {
+template<typename Map>
+Map ComplexTypeConverter::mapLikeFromPython(const py::object& obj, Map result) {
+    using K = typename Map::key_type;
+    using V = typename Map::mapped_type;
+    
     if (!TypeConverter::isPythonDict(obj)) {
         throw std::runtime_error("Expected Python dict for map conversion");
     }
     
-    py::dict py_dict = obj.cast<py::dict>();
-    std::map<K, V> result;
+    if constexpr (detail::HasReserve<Map>::value) {
+        result.reserve(static_cast<size_t>(PyDict_Size(obj.ptr())));
+    }
     
-    for (const auto& item : py_dict) {
-        K key = TypeConverter::fromPython<K>(item.first);
-        V value = TypeConverter::fromPython<V>(item.second);
-        result[key] = value;
+    PyObject* key = nullptr;
+    PyObject* value = nullptr;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(obj.ptr(), &pos, &key, &value)) {
+        if constexpr (detail::kIsBulkScalar<K> && detail::kIsBulkScalar<V>) {
+            result.insert_or_assign(detail::scalarFromBorrowed<K>(key), detail::scalarFromBorrowed<V>(value));
+        } else {
+            // Distinct Python keys can convert to the same C++ key; the last one wins, as in pybind11
+            result.insert_or_assign(TypeConverter::fromPython<K>(py::reinterpret_borrow<py::object>(key)),
+                                    TypeConverter::fromPython<V>(py::reinterpret_borrow<py::object>(value)));
+        }
     }
     
     return result;
 }
 
-
 template<typename... Args>
 py::object ComplexTypeConverter::tupleToPython(const std::tuple<Args...>& tuple)
 {
@@ -163,11 +615,184 @@ py::object ComplexTypeConverter::variantToPython(const std::variant<Types...>& v
 template<typename... Types>
 std::variant<Types...> ComplexTypeConverter::variantFromPython(const py::object& obj)
 {
-    // This is a simplified implementation. A real implementation would need to
-    // try converting to each type in Types...
-    // This requires more advanced template metaprogramming.
-    // For now, we will just throw an error.
-    throw std::runtime_error("variantFromPython is not fully implemented");
+    using Variant = std::variant<Types...>;
+    std::optional<Variant> result;
+
+    // First alternative, in declaration order, whose Python type matches exactly and
+    // whose value loads (an int that overflows int32 falls through to int64)
+    auto exact = [&](auto index) {
+        using Alternative = std::variant_alternative_t<decltype(index)::value, Variant>;
+        if (!detail::PyTypeTag<Alternative>::matches(obj.ptr())) {
+            return false;
+        }
+        if constexpr (std::is_same_v<Alternative, std::monostate> || std::is_same_v<Alternative, std::nullptr_t>) {
+            result.emplace(std::in_place_index<decltype(index)::value>);
+        } else {
+            auto value = detail::loadWithCaster<Alternative>(obj);
+            if (!value) {
+                return false;
+            }
+            result.emplace(std::in_place_index<decltype(index)::value>, std::move(*value));
+        }
+        return true;
+    };
+
+    // Otherwise the first alternative pybind11 accepts with implicit conversions (int -> double, bytes -> string)
+    auto converting = [&](auto index) {
+        using Alternative = std::variant_alternative_t<decltype(index)::value, Variant>;
+        if constexpr (std::is_same_v<Alternative, std::monostate>) {
+            return false;
+        } else {
+            auto value = detail::loadWithCaster<Alternative>(obj);
+            if (!value) {
+                return false;
+            }
+            result.emplace(std::in_place_index<decltype(index)::value>, std::move(*value));
+            return true;
+        }
+    };
+
+    constexpr auto indices = std::index_sequence_for<Types...>{};
+    if (!detail::anyIndex(exact, indices) && !detail::anyIndex(converting, indices)) {
+        throw std::runtime_error(std::string("No variant alternative matches Python type ") +
+                                 Py_TYPE(obj.ptr())->tp_name);
+    }
+    return std::move(*result);
+}
+
+template<typename T>
+py::object ComplexTypeConverter::matrixToPython(const Matrix<T>& matrix) {
+    py::list result(matrix.rows());
+    for (size_t i = 0; i < matrix.rows(); ++i) {
+        py::list row(matrix.cols());
+        for (size_t j = 0; j < matrix.cols(); ++j) {
+            row[j] = TypeConverter::toPython(matrix(i, j));
+        }
+        result[i] = row;
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> ComplexTypeConverter::matrixFromPython(const py::object& obj) {
+    if (py::isinstance<py::array>(obj)) {
+        auto arr = py::array_t<T>::ensure(obj);
+        if (!arr) {
+            throw std::runtime_error("Cannot convert NumPy array to the requested matrix element type");
+        }
+        return NumpyConverter::numpyToMatrix<T>(arr);
+    }
+    
+    if (!py::isinstance<py::sequence>(obj) || py::isinstance<py::str>(obj)) {
+        throw std::runtime_error("Expected a 2D NumPy array or nested sequence for matrix conversion");
+    }
+    
+    py::sequence rows_seq = obj.cast<py::sequence>();
+    const size_t rows = rows_seq.size();
+    if (rows == 0) {
+        return Matrix<T>();
+    }
+    
+    const size_t cols = py::len(rows_seq[0]);
+    Matrix<T> result(rows, cols);
+    
+    for (size_t i = 0; i < rows; ++i) {
+        py::sequence row = py::object(rows_seq[i]).cast<py::sequence>();
+        if (row.size() != cols) {
+            throw std::runtime_error("Inconsistent number of columns in 2D matrix");
+        }
+        for (size_t j = 0; j < cols; ++j) {
+            result(i, j) = TypeConverter::fromPython<T>(row[j]);
+        }
+    }
+    
+    return result;
+}
+
+// NumpyView implementation
+
+template<typename T>
+NumpyView<T>::NumpyView(const py::array& arr) : m_array(arr) {
+    if (!py::isinstance<py::array_t<T, 0>>(m_array)) {
+        throw std::runtime_error("NumPy array dtype does not match the requested view type");
+    }
+    
+    const py::ssize_t ndim = m_array.ndim();
+    m_shape.assign(m_array.shape(), m_array.shape() + ndim);
+    m_strides.assign(m_array.strides(), m_array.strides() + ndim);
+    m_data = static_cast<const char*>(m_array.data());
+    m_size = static_cast<size_t>(m_array.size());
+}
+
+template<typename T>
+size_t NumpyView<T>::ndim() const {
+    return m_shape.size();
+}
+
+template<typename T>
+size_t NumpyView<T>::size() const {
+    return m_size;
+}
+
+template<typename T>
+size_t NumpyView<T>::shape(size_t dim) const {
+    return static_cast<size_t>(m_shape.at(dim));
+}
+
+template<typename T>
+py::ssize_t NumpyView<T>::stride(size_t dim) const {
+    return m_strides.at(dim);
+}
+
+template<typename T>
+bool NumpyView<T>::isContiguous() const {
+    py::ssize_t expected = static_cast<py::ssize_t>(sizeof(T));
+    for (size_t d = m_shape.size(); d-- > 0;) {
+        if (m_shape[d] > 1 && m_strides[d] != expected) {
+            return false;
+        }
+        expected *= m_shape[d];
+    }
+    return true;
+}
+
+template<typename T>
+bool NumpyView<T>::empty() const {
+    return m_size == 0;
+}
+
+template<typename T>
+const T* NumpyView<T>::data() const {
+    return reinterpret_cast<const T*>(m_data);
+}
+
+template<typename T>
+const T& NumpyView<T>::operator[](size_t i) const {
+    return *reinterpret_cast<const T*>(m_data + static_cast<py::ssize_t>(i) * m_strides[0]);
+}
+
+template<typename T>
+const T& NumpyView<T>::operator()(size_t i, size_t j) const {
+    return *reinterpret_cast<const T*>(m_data + static_cast<py::ssize_t>(i) * m_strides[0]
+                                              + static_cast<py::ssize_t>(j) * m_strides[1]);
+}
+
+template<typename T>
+typename NumpyView<T>::const_iterator NumpyView<T>::begin() const {
+    if (m_shape.size() != 1) {
+        throw std::runtime_error("NumpyView iteration requires a 1D array");
+    }
+    return const_iterator(m_data, m_strides[0]);
+}
+
+template<typename T>
+typename NumpyView<T>::const_iterator NumpyView<T>::end() const {
+    return begin() + static_cast<std::ptrdiff_t>(m_shape[0]);
+}
+
+template<typename T>
+const py::array& NumpyView<T>::array() const {
+    return m_array;
 }
 
 // NumpyConverter implementation
@@ -181,15 +806,50 @@ py::array_t<T> NumpyConverter::vectorToNumpy(const std::vector<T>& vec) {
 }
 
 template<typename T>
-std::vector<T> NumpyConverter::numpyToVector(const py::array_t<T>& arr) {
-    auto buf = arr.request();
+py::array_t<T> NumpyConverter::vectorToNumpy(std::vector<T>&& vec) {
+    auto owner = std::make_unique<std::vector<T>>(std::move(vec));
+    T* data = owner->data();
+    const size_t size = owner->size();
     
-    if (buf.ndim != 1) {
-        throw std::runtime_error("Expected 1D array for vector conversion");
-    }
+    // The capsule owns the vector from here on and frees it with the array
+    py::capsule base(owner.get(), [](void* ptr) {
+        delete static_cast<std::vector<T>*>(ptr);
+    });
+    owner.release();
     
-    T* ptr = static_cast<T*>(buf.ptr);
-    return std::vector<T>(ptr, ptr + buf.shape[0]);
+    return py::array_t<T>({size}, {sizeof(T)}, data, base);
+}
+
+template<typename T>
+py::array_t<T> NumpyConverter::sharedToNumpy(std::shared_ptr<T[]> data, size_t size) {
+    auto owner = std::make_unique<std::shared_ptr<T[]>>(std::move(data));
+    T* ptr = owner->get();
+    
+    py::capsule base(owner.get(), [](void* p) {
+        delete static_cast<std::shared_ptr<T[]>*>(p);
+    });
+    owner.release();
+    
+    return py::array_t<T>({size}, {sizeof(T)}, ptr, base);
+}
+
+template<typename T>
+NumpyView<T> NumpyConverter::view(const py::array& arr) {
+    return NumpyView<T>(arr);
+}
+
+template<typename T>
+std::vector<T> NumpyConverter::numpyToVector(const py::array_t<T>& arr) {
+    std::vector<T> result;
+    detail::assignFromNumpy(arr, result);
+    return result;
+}
+
+template<typename T>
+std::pmr::vector<T> NumpyConverter::numpyToVector(const py::array_t<T>& arr, std::pmr::memory_resource* resource) {
+    std::pmr::vector<T> result(resource);
+    detail::assignFromNumpy(arr, result);
+    return result;
 }
 
 template<typename T>
@@ -218,72 +878,173 @@ py::array_t<T> NumpyConverter::matrix2DToNumpy(const std::vector<std::vector<T>>
 
 template<typename T>
 std::vector<std::vector<T>> NumpyConverter::numpyToMatrix2D(const py::array_t<T>& arr) {
-    auto buf = arr.request();
+    NumpyView<T> view = detail::matrix2DView(arr);
+    std::vector<std::vector<T>> result(view.shape(0), std::vector<T>(view.shape(1)));
+    detail::copyRows(view, result);
+    return result;
+}
+
+template<typename T>
+std::pmr::vector<std::pmr::vector<T>> NumpyConverter::numpyToMatrix2D(const py::array_t<T>& arr,
+                                                                      std::pmr::memory_resource* resource) {
+    NumpyView<T> view = detail::matrix2DView(arr);
     
-    if (buf.ndim != 2) {
-        throw std::runtime_error("Expected 2D array for matrix conversion");
+    // Rows are constructed with the outer vector's allocator
+    std::pmr::vector<std::pmr::vector<T>> result(resource);
+    result.reserve(view.shape(0));
+    for (size_t i = 0; i < view.shape(0); ++i) {
+        result.emplace_back(view.shape(1));
     }
+    detail::copyRows(view, result);
+    return result;
+}
+
+template<typename T>
+py::array_t<T> NumpyConverter::matrixToNumpy(const Matrix<T>& matrix) {
+    // The capsule holds a reference to the matrix storage for the array's lifetime
+    auto owner = std::make_unique<std::shared_ptr<void>>(matrix.owner());
+    py::capsule base(owner.get(), [](void* ptr) {
+        delete static_cast<std::shared_ptr<void>*>(ptr);
+    });
+    owner.release();
     
-    const size_t rows = buf.shape[0];
-    const size_t cols = buf.shape[1];
+    const py::ssize_t item_size = static_cast<py::ssize_t>(sizeof(T));
+    return py::array_t<T>(
+        {static_cast<py::ssize_t>(matrix.rows()), static_cast<py::ssize_t>(matrix.cols())},
+        {matrix.rowStride() * item_size, matrix.colStride() * item_size},
+        matrix.data(),
+        base
+    );
+}
+
+template<typename T>
+Matrix<T> NumpyConverter::numpyToMatrix(const py::array_t<T>& arr) {
+    NumpyView<T> view(arr);
     
-    std::vector<std::vector<T>> result(rows, std::vector<T>(cols));
-    T* ptr = static_cast<T*>(buf.ptr);
+    if (view.ndim() != 2) {
+        throw std::runtime_error("Expected 2D array for matrix conversion");
+    }
     
-    for (size_t i = 0; i < rows; ++i) {
-        std::copy(ptr + i * cols, ptr + (i + 1) * cols, result[i].begin());
+    const size_t rows = view.shape(0);
+    const size_t cols = view.shape(1);
+    const py::ssize_t item_size = static_cast<py::ssize_t>(sizeof(T));
+    
+    // Byte strides that are not whole elements, misaligned or read-only buffers are copied
+    const bool shareable = arr.writeable() &&
+                           view.stride(0) % item_size == 0 &&
+                           view.stride(1) % item_size == 0 &&
+                           reinterpret_cast<std::uintptr_t>(view.data()) % alignof(T) == 0;
+    if (!shareable) {
+        Matrix<T> result(rows, cols);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                result(i, j) = view(i, j);
+            }
+        }
+        return result;
     }
     
-    return result;
+    // Keep the array alive for as long as the matrix; release it under the GIL
+    std::shared_ptr<void> owner(new py::object(arr), [](void* ptr) {
+        if (Py_IsInitialized()) {
+            py::gil_scoped_acquire gil;
+            delete static_cast<py::object*>(ptr);
+        }
+    });
+    
+    return Matrix<T>::view(const_cast<T*>(view.data()), rows, cols,
+                           view.stride(0) / item_size, view.stride(1) / item_size,
+                           std::move(owner));
+}
+
+// ColumnarTable implementation
+
+template<typename T>
+void ColumnarTable::addColumn(const std::string& name, std::vector<T>&& values) {
+    auto owner = std::make_shared<const std::vector<T>>(std::move(values));
+    const T* data = owner->data();
+    const size_t length = owner->size();
+    addColumn<T>(name, data, length, std::move(owner));
+}
+
+template<typename T>
+void ColumnarTable::addColumn(const std::string& name, const T* data, size_t length,
+                              std::shared_ptr<const void> owner) {
+    Column column;
+    column.name = name;
+    column.format = ArrowFormat<T>::value;
+    column.data = data;
+    column.owner = std::move(owner);
+    appendColumn(std::move(column), length);
+}
+
+template<typename T>
+const T* ColumnarTable::column(const std::string& name) const {
+    const Column& col = findColumn(name);
+    if (std::strcmp(col.format, ArrowFormat<T>::value) != 0) {
+        throw std::runtime_error("Column '" + name + "' has a different element type");
+    }
+    return static_cast<const T*>(col.data);
+}
+
+template<typename T>
+std::vector<T> ColumnarTable::columnToVector(const std::string& name) const {
+    const T* data = column<T>(name);
+    return std::vector<T>(data, data + m_rows);
 }
 
 // CustomTypeRegistry implementation
 
 template<typename CppType>
-void CustomTypeRegistry::registerToPython(std::function<py::object(const CppType&)> converter) {
-    s_to_python_converters[typeid(CppType).name()] = 
-        [converter](const void* value) -> py::object {
-            return converter(*static_cast<const CppType*>(value));
-        };
+void CustomTypeRegistry::registerToPython(ToPythonFunc<CppType> converter) {
+    auto owned = std::make_shared<const ToPythonFunc<CppType>>(std::move(converter));
+    Slot<CppType>::to_python.store(owned.get(), std::memory_order_release);
+    retain(std::move(owned));
 }
 
 template<typename CppType>
-void CustomTypeRegistry::registerFromPython(std::function<CppType(const py::object&)> converter) {
-    s_from_python_converters[typeid(CppType).name()] = 
-        [converter](const py::object& obj) -> void* {
-            return new CppType(converter(obj));
-        };
+void CustomTypeRegistry::registerFromPython(FromPythonFunc<CppType> converter) {
+    auto owned = std::make_shared<const FromPythonFunc<CppType>>(std::move(converter));
+    Slot<CppType>::from_python.store(owned.get(), std::memory_order_release);
+    retain(std::move(owned));
 }
 
 template<typename CppType>
 bool CustomTypeRegistry::hasToPythonConverter() {
-    return s_to_python_converters.count(typeid(CppType).name()) > 0;
+    return findToPython<CppType>() != nullptr;
 }
 
 template<typename CppType>
 bool CustomTypeRegistry::hasFromPythonConverter() {
-    return s_from_python_converters.count(typeid(CppType).name()) > 0;
+    return findFromPython<CppType>() != nullptr;
+}
+
+template<typename CppType>
+const CustomTypeRegistry::ToPythonFunc<CppType>* CustomTypeRegistry::findToPython() {
+    return Slot<CppType>::to_python.load(std::memory_order_acquire);
+}
+
+template<typename CppType>
+const CustomTypeRegistry::FromPythonFunc<CppType>* CustomTypeRegistry::findFromPython() {
+    return Slot<CppType>::from_python.load(std::memory_order_acquire);
 }
 
 template<typename CppType>
 py::object CustomTypeRegistry::convertToPython(const CppType& value) {
-    auto it = s_to_python_converters.find(typeid(CppType).name());
-    if (it == s_to_python_converters.end()) {
+    const auto* converter = findToPython<CppType>();
+    if (!converter) {
         throw std::runtime_error("No to-Python converter registered for this type");
     }
-    return it->second(&value);
+    return (*converter)(value);
 }
 
 template<typename CppType>
 CppType CustomTypeRegistry::convertFromPython(const py::object& obj) {
-    auto it = s_from_python_converters.find(typeid(CppType).name());
-    if (it == s_from_python_converters.end()) {
+    const auto* converter = findFromPython<CppType>();
+    if (!converter) {
         throw std::runtime_error("No from-Python converter registered for this type");
     }
-    void* ptr = it->second(obj);
-    CppType result = *static_cast<CppType*>(ptr);
-    delete static_cast<CppType*>(ptr);
-    return result;
+    return (*converter)(obj);
 }
 
 } // namespace cpppy_bridge
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <pybind11/pybind11.h>
+#include "python_bridge.h"
+#include "type_converter.h"
+
+namespace py = pybind11;
+
+namespace cpppy_bridge {
+
+namespace detail {
+
+// Call with a borrowed argument array laid out for vectorcall (slot 0 is scratch space)
+inline PyObject* vectorcall(PyObject* callable, PyObject** argv, size_t nargs) {
+#if PY_VERSION_HEX >= 0x03090000
+    return PyObject_Vectorcall(callable, argv + 1, nargs | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr);
+#elif PY_VERSION_HEX >= 0x03080000
+    return _PyObject_Vectorcall(callable, argv + 1, nargs | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr);
+#else
+    PyObject* args = PyTuple_New(static_cast<Py_ssize_t>(nargs));
+    if (!args) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < nargs; ++i) {
+        Py_INCREF(argv[i + 1]);
+        PyTuple_SET_ITEM(args, static_cast<Py_ssize_t>(i), argv[i + 1]);
+    }
+    PyObject* result = PyObject_Call(callable, args, nullptr);
+    Py_DECREF(args);
+    return result;
+#endif
+}
+
+} // namespace detail
+
+template<typename Signature>
+class TypedFunction;
+
+/**
+ * @brief Fixed-signature Python Function
+ * Compile-time specialized invoker for hot functions with a known C++
+ * signature, e.g. TypedFunction<double(double, double)>. Arguments are
+ * converted directly onto a stack array and passed through vectorcall with
+ * no intermediate tuple; the result is unpacked by TypeConverter::fromPython.
+ * Functions resolved from a module follow module reloads.
+ */
+template<typename ReturnType, typename... Args>
+class TypedFunction<ReturnType(Args...)> {
+public:
+    TypedFunction() = default;
+    TypedFunction(const py::object& callable, const std::string& name);
+    TypedFunction(const std::shared_ptr<PythonModule>& module, const std::string& func_name);
+
+    bool isValid() const;
+
+    ReturnType operator()(const std::decay_t<Args>&... args) const;
+
+private:
+    template<size_t... I>
+    ReturnType invoke(std::index_sequence<I...>, const std::decay_t<Args>&... args) const;
+
+    std::shared_ptr<PythonModule> m_module;
+    mutable py::object m_callable;
+    mutable uint64_t m_generation = 0;
+    std::string m_name;
+};
+
+// Template method implementations
+template<typename ReturnType, typename... Args>
+TypedFunction<ReturnType(Args...)>::TypedFunction(const py::object& callable, const std::string& name)
+    : m_callable(callable), m_name(name) {}
+
+template<typename ReturnType, typename... Args>
+TypedFunction<ReturnType(Args...)>::TypedFunction(const std::shared_ptr<PythonModule>& module,
+                                                  const std::string& func_name)
+    : m_name(func_name) {
+    if (module && module->isLoaded() && module->hasFunction(func_name)) {
+        m_module = module;
+        m_generation = module->getGeneration();
+        m_callable = module->getAttribute(func_name);
+    }
+}
+
+template<typename ReturnType, typename... Args>
+bool TypedFunction<ReturnType(Args...)>::isValid() const {
+    return static_cast<bool>(m_callable);
+}
+
+template<typename ReturnType, typename... Args>
+ReturnType TypedFunction<ReturnType(Args...)>::operator()(const std::decay_t<Args>&... args) const {
+    if (!m_callable) {
+        throw PythonFunctionException(m_name, "Invalid function");
+    }
+
+    try {
+        if (m_module && m_generation != m_module->getGeneration()) {
+            m_generation = m_module->getGeneration();
+            m_callable = m_module->getAttribute(m_name);
+        }
+        return invoke(std::index_sequence_for<Args...>{}, args...);
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+        throw; // Should not be reached
+    }
+}
+
+template<typename ReturnType, typename... Args>
+template<size_t... I>
+ReturnType TypedFunction<ReturnType(Args...)>::invoke(std::index_sequence<I...>,
+                                                      const std::decay_t<Args>&... args) const {
+    constexpr size_t nargs = sizeof...(Args);
+    PyObject* argv[nargs + 1] = {};
+
+    // Convert in order and stop at the first failure, so no conversion runs with an error pending
+    const bool converted = ((argv[I + 1] = detail::toOwnedPyObject(args)) != nullptr && ...);
+
+    PyObject* result = converted ? detail::vectorcall(m_callable.ptr(), argv, nargs) : nullptr;
+
+    for (size_t i = 1; i <= nargs; ++i) {
+        Py_XDECREF(argv[i]);
+    }
+
+    if (!result) {
+        throw py::error_already_set();
+    }
+
+    py::object owned = py::reinterpret_steal<py::object>(result);
+    if constexpr (std::is_void_v<ReturnType>) {
+        return;
+    } else {
+        return TypeConverter::fromPython<ReturnType>(owned);
+    }
+}
+
+} // namespace cpppy_bridge
@@ -0,0 +1,168 @@
+#include "argument_pack.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cpppy_bridge {
+
+namespace {
+
+constexpr size_t kCachedValues = static_cast<size_t>(SmallValueCache::kMax - SmallValueCache::kMin);
+
+// 主解释器中按需创建的对象（强引用，由 SmallValueCache::clear 释放）
+std::vector<PyObject*> g_cached_ints;
+std::vector<PyObject*> g_cached_floats;
+
+bool inCacheRange(long long value) {
+    return value >= SmallValueCache::kMin && value < SmallValueCache::kMax;
+}
+
+// 子解释器不能共享对象，只在主解释器中使用缓存
+PyObject* cachedObject(std::vector<PyObject*>& cache, long long value, PyObject* (*create)(long long)) {
+    if (PyInterpreterState_Get() != PyInterpreterState_Main()) {
+        return create(value);
+    }
+    if (cache.empty()) {
+        cache.assign(kCachedValues, nullptr);
+    }
+    PyObject*& slot = cache[static_cast<size_t>(value - SmallValueCache::kMin)];
+    if (!slot) {
+        slot = create(value);
+        if (!slot) {
+            return nullptr;
+        }
+    }
+    Py_INCREF(slot);
+    return slot;
+}
+
+PyObject* createInt(long long value) {
+    return PyLong_FromLongLong(value);
+}
+
+PyObject* createFloat(long long value) {
+    return PyFloat_FromDouble(static_cast<double>(value));
+}
+
+py::object stealOrThrow(PyObject* object) {
+    if (!object) {
+        throw py::error_already_set();
+    }
+    return py::reinterpret_steal<py::object>(object);
+}
+
+void releaseAll(std::vector<PyObject*>& cache) {
+    if (Py_IsInitialized()) {
+        for (PyObject* object : cache) {
+            Py_XDECREF(object);
+        }
+    }
+    cache.clear();
+}
+
+} // namespace
+
+// SmallValueCache 实现
+py::object SmallValueCache::integer(long long value) {
+    if (!inCacheRange(value)) {
+        return stealOrThrow(PyLong_FromLongLong(value));
+    }
+    return stealOrThrow(cachedObject(g_cached_ints, value, createInt));
+}
+
+py::object SmallValueCache::floating(double value) {
+    // 只缓存整数值的浮点数；-0.0 与 0.0 需要区分
+    const bool integral = value >= static_cast<double>(kMin) && value < static_cast<double>(kMax) &&
+                          std::trunc(value) == value && !(value == 0.0 && std::signbit(value));
+    if (!integral) {
+        return stealOrThrow(PyFloat_FromDouble(value));
+    }
+    return stealOrThrow(cachedObject(g_cached_floats, static_cast<long long>(value), createFloat));
+}
+
+void SmallValueCache::clear() {
+    releaseAll(g_cached_ints);
+    releaseAll(g_cached_floats);
+}
+
+// ArgumentPack 实现
+ArgumentPack::ArgumentPack(size_t size) {
+    resize(size);
+}
+
+size_t ArgumentPack::size() const {
+    return m_tuple ? static_cast<size_t>(PyTuple_GET_SIZE(m_tuple.ptr())) : 0;
+}
+
+void ArgumentPack::resize(size_t size) {
+    const size_t previous = m_tuple ? this->size() : 0;
+    if (m_tuple && previous == size) {
+        return;
+    }
+
+    py::object resized = stealOrThrow(PyTuple_New(static_cast<Py_ssize_t>(size)));
+    ++m_allocations;
+    for (size_t i = 0; i < size; ++i) {
+        PyObject* item = i < previous ? PyTuple_GET_ITEM(m_tuple.ptr(), static_cast<Py_ssize_t>(i)) : Py_None;
+        Py_INCREF(item);
+        PyTuple_SET_ITEM(resized.ptr(), static_cast<Py_ssize_t>(i), item);
+    }
+    m_tuple = std::move(resized);
+}
+
+py::object ArgumentPack::get(size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("ArgumentPack index " + std::to_string(index) + " out of range");
+    }
+    return py::reinterpret_borrow<py::object>(PyTuple_GET_ITEM(m_tuple.ptr(), static_cast<Py_ssize_t>(index)));
+}
+
+py::handle ArgumentPack::tuple() const {
+    return m_tuple;
+}
+
+py::object ArgumentPack::call(py::handle callable) const {
+    return stealOrThrow(PyObject_Call(callable.ptr(), m_tuple.ptr(), nullptr));
+}
+
+uint64_t ArgumentPack::allocations() const {
+    return m_allocations;
+}
+
+void ArgumentPack::detach() {
+    // 元组被其他引用持有时不能原地修改，复制一份
+    if (Py_REFCNT(m_tuple.ptr()) == 1) {
+        return;
+    }
+    const Py_ssize_t count = PyTuple_GET_SIZE(m_tuple.ptr());
+    py::object copy = stealOrThrow(PyTuple_New(count));
+    ++m_allocations;
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        PyObject* item = PyTuple_GET_ITEM(m_tuple.ptr(), i);
+        Py_INCREF(item);
+        PyTuple_SET_ITEM(copy.ptr(), i, item);
+    }
+    m_tuple = std::move(copy);
+}
+
+void ArgumentPack::setSlot(size_t index, py::object value) {
+    if (index >= size()) {
+        throw std::out_of_range("ArgumentPack index " + std::to_string(index) + " out of range");
+    }
+    detach();
+
+    PyObject* tuple = m_tuple.ptr();
+    PyObject* previous = PyTuple_GET_ITEM(tuple, static_cast<Py_ssize_t>(index));
+    PyObject* item = value.release().ptr();
+    PyTuple_SET_ITEM(tuple, static_cast<Py_ssize_t>(index), item);
+#if PY_VERSION_HEX >= 0x03090000
+    // 垃圾回收会取消跟踪只含原子对象的元组，放入容器后需要重新跟踪
+    if (PyObject_IS_GC(item) && !PyObject_GC_IsTracked(tuple)) {
+        PyObject_GC_Track(tuple);
+    }
+#endif
+    Py_XDECREF(previous);
+}
+
+} // namespace cpppy_bridge
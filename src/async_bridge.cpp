@@ -0,0 +1,171 @@
+#include "async_bridge.h"
+#include <iostream>
+
+namespace cpppy_bridge {
+
+namespace {
+
+// 在事件循环线程中定义的辅助函数
+const char* kLoopHelpers = R"(
+import asyncio
+
+async def await_any(awaitable):
+    return await awaitable
+
+def drain(loop):
+    tasks = asyncio.all_tasks(loop)
+    for task in tasks:
+        task.cancel()
+    if tasks:
+        loop.run_until_complete(asyncio.gather(*tasks, return_exceptions=True))
+    loop.run_until_complete(loop.shutdown_asyncgens())
+    loop.close()
+)";
+
+} // namespace
+
+// AsyncLoop 实现
+AsyncLoop& AsyncLoop::getInstance() {
+    static AsyncLoop instance;
+    return instance;
+}
+
+AsyncLoop::~AsyncLoop() {
+    if (m_thread.joinable()) {
+        if (Py_IsInitialized()) {
+            stop();
+        } else {
+            m_thread.detach();
+        }
+    }
+}
+
+void AsyncLoop::start() {
+    if (m_running.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // 事件循环线程启动时需要GIL
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running.load(std::memory_order_acquire)) {
+        return;
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    auto started = std::make_shared<std::promise<void>>();
+    std::future<void> ready = started->get_future();
+    m_thread = std::thread(&AsyncLoop::run, this, started);
+    try {
+        ready.get();
+    } catch (...) {
+        m_thread.join();
+        throw;
+    }
+    m_running.store(true, std::memory_order_release);
+}
+
+void AsyncLoop::stop() {
+    if (!m_running.load(std::memory_order_acquire)) {
+        return;
+    }
+    if (std::this_thread::get_id() == m_thread.get_id()) {
+        throw PythonInterpreterException("AsyncLoop cannot be stopped from its own thread");
+    }
+
+    {
+        py::gil_scoped_acquire gil;
+        if (m_loop) {
+            m_loop.attr("call_soon_threadsafe")(m_loop.attr("stop"));
+        }
+    }
+
+    // 循环线程退出前需要GIL来取消剩余任务
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_running.store(false, std::memory_order_release);
+}
+
+bool AsyncLoop::isRunning() const {
+    return m_running.load(std::memory_order_acquire);
+}
+
+size_t AsyncLoop::pendingCalls() const {
+    return m_pending.load(std::memory_order_relaxed);
+}
+
+py::object AsyncLoop::loop() const {
+    if (!m_loop) {
+        return py::none();
+    }
+    return m_loop;
+}
+
+bool AsyncLoop::isAwaitable(const py::handle& object) {
+    return PyCoro_CheckExact(object.ptr()) || py::hasattr(object, "__await__");
+}
+
+void AsyncLoop::schedule(py::object awaitable, Completion done) {
+    start();
+    if (!m_loop) {
+        throw PythonInterpreterException("AsyncLoop is not running");
+    }
+
+    // run_coroutine_threadsafe 只接受协程，其他可等待对象包装一层
+    py::object coroutine = PyCoro_CheckExact(awaitable.ptr()) ? std::move(awaitable) : m_await_any(awaitable);
+    py::object future = m_run_threadsafe(coroutine, m_loop);
+
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+    future.attr("add_done_callback")(py::cpp_function([this, done = std::move(done)](py::handle finished) {
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+        done(finished);
+    }));
+}
+
+void AsyncLoop::run(std::shared_ptr<std::promise<void>> started) {
+    py::gil_scoped_acquire gil;
+    try {
+        py::module asyncio = py::module::import("asyncio");
+        py::dict helpers;
+        helpers["__builtins__"] = py::module::import("builtins");
+        py::exec(kLoopHelpers, helpers);
+
+        m_loop = asyncio.attr("new_event_loop")();
+        asyncio.attr("set_event_loop")(m_loop);
+        m_run_threadsafe = asyncio.attr("run_coroutine_threadsafe");
+        m_await_any = helpers["await_any"];
+        m_drain = helpers["drain"];
+    } catch (...) {
+        m_loop = py::object();
+        started->set_exception(std::current_exception());
+        return;
+    }
+    started->set_value();
+
+    try {
+        m_loop.attr("run_forever")();
+        m_drain(m_loop);
+    } catch (const py::error_already_set& e) {
+        std::cerr << "AsyncLoop terminated: " << e.what() << std::endl;
+    }
+
+    m_loop = py::object();
+    m_run_threadsafe = py::object();
+    m_await_any = py::object();
+    m_drain = py::object();
+}
+
+} // namespace cpppy_bridge
@@ -0,0 +1,177 @@
+#include "bridge_allocator.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace cpppy_bridge {
+
+namespace {
+
+// 块头记录用户请求的大小与块的容量，并保持返回地址的对齐
+struct BlockHeader {
+    size_t size;
+    size_t capacity;
+};
+
+constexpr size_t kBlockAlignment = alignof(std::max_align_t);
+constexpr size_t kHeaderSize = (sizeof(BlockHeader) + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+
+BlockHeader& blockHeader(void* block) {
+    return *static_cast<BlockHeader*>(block);
+}
+
+void* userPointer(void* block) {
+    return static_cast<char*>(block) + kHeaderSize;
+}
+
+void* blockPointer(void* ptr) {
+    return static_cast<char*>(ptr) - kHeaderSize;
+}
+
+} // namespace
+
+// AllocatorConfig 实现
+bool AllocatorConfig::isDefault() const {
+    return preset == PythonAllocator::Default && !raw && !mem && !object && !debug_hooks;
+}
+
+// ResourceAllocator 实现
+ResourceAllocator::ResourceAllocator(std::pmr::memory_resource* resource) : m_resource(resource) {}
+
+PyMemAllocatorEx ResourceAllocator::allocator() {
+    PyMemAllocatorEx allocator;
+    allocator.ctx = this;
+    allocator.malloc = &ResourceAllocator::allocate;
+    allocator.calloc = &ResourceAllocator::allocateZeroed;
+    allocator.realloc = &ResourceAllocator::reallocate;
+    allocator.free = &ResourceAllocator::deallocate;
+    return allocator;
+}
+
+std::pmr::memory_resource* ResourceAllocator::resource() const {
+    return m_resource;
+}
+
+size_t ResourceAllocator::bytesInUse() const {
+    return m_bytes_in_use.load(std::memory_order_relaxed);
+}
+
+size_t ResourceAllocator::allocationCount() const {
+    return m_allocations.load(std::memory_order_relaxed);
+}
+
+void* ResourceAllocator::allocate(void* ctx, size_t size) {
+    auto* self = static_cast<ResourceAllocator*>(ctx);
+    if (size > std::numeric_limits<size_t>::max() - kHeaderSize) {
+        return nullptr;
+    }
+
+    // PyMem 接口通过返回 NULL 报告失败，不能抛出异常
+    void* block = nullptr;
+    try {
+        block = self->m_resource->allocate(size + kHeaderSize, kBlockAlignment);
+    } catch (...) {
+        return nullptr;
+    }
+
+    blockHeader(block) = BlockHeader{size, size};
+    self->m_bytes_in_use.fetch_add(size, std::memory_order_relaxed);
+    self->m_allocations.fetch_add(1, std::memory_order_relaxed);
+    return userPointer(block);
+}
+
+void* ResourceAllocator::allocateZeroed(void* ctx, size_t count, size_t elem_size) {
+    if (elem_size != 0 && count > std::numeric_limits<size_t>::max() / elem_size) {
+        return nullptr;
+    }
+    const size_t size = count * elem_size;
+    void* ptr = allocate(ctx, size);
+    if (ptr) {
+        std::memset(ptr, 0, size);
+    }
+    return ptr;
+}
+
+void* ResourceAllocator::reallocate(void* ctx, void* ptr, size_t new_size) {
+    if (!ptr) {
+        return allocate(ctx, new_size);
+    }
+
+    BlockHeader& header = blockHeader(blockPointer(ptr));
+    const size_t old_size = header.size;
+    if (new_size <= header.capacity) {
+        // 容量足够时原地调整（含缩小），块的容量保持不变
+        auto* self = static_cast<ResourceAllocator*>(ctx);
+        header.size = new_size;
+        if (new_size >= old_size) {
+            self->m_bytes_in_use.fetch_add(new_size - old_size, std::memory_order_relaxed);
+        } else {
+            self->m_bytes_in_use.fetch_sub(old_size - new_size, std::memory_order_relaxed);
+        }
+        return ptr;
+    }
+
+    void* moved = allocate(ctx, new_size);
+    if (!moved) {
+        // 失败时原内存块保持不变
+        return nullptr;
+    }
+    std::memcpy(moved, ptr, old_size);
+    deallocate(ctx, ptr);
+    return moved;
+}
+
+void ResourceAllocator::deallocate(void* ctx, void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto* self = static_cast<ResourceAllocator*>(ctx);
+    void* block = blockPointer(ptr);
+    const BlockHeader header = blockHeader(block);
+    self->m_bytes_in_use.fetch_sub(header.size, std::memory_order_relaxed);
+    self->m_allocations.fetch_sub(1, std::memory_order_relaxed);
+    self->m_resource->deallocate(block, header.capacity + kHeaderSize, kBlockAlignment);
+}
+
+// ConversionArena 实现
+ConversionArena::ConversionArena(size_t initial_size, std::pmr::memory_resource* upstream)
+    : m_upstream(upstream),
+      m_initial_size(std::max<size_t>(initial_size, 1024)),
+      m_initial_buffer(m_upstream->allocate(m_initial_size, kBlockAlignment)),
+      m_buffer(m_initial_buffer, m_initial_size, m_upstream) {}
+
+ConversionArena::~ConversionArena() {
+    m_buffer.release();
+    m_upstream->deallocate(m_initial_buffer, m_initial_size, kBlockAlignment);
+}
+
+void ConversionArena::release() {
+    // 释放后续扩展的内存块，初始缓冲区重新从头使用
+    m_buffer.release();
+    m_bytes = 0;
+}
+
+size_t ConversionArena::bytesAllocated() const {
+    return m_bytes;
+}
+
+size_t ConversionArena::peakBytes() const {
+    return m_peak_bytes;
+}
+
+void* ConversionArena::do_allocate(size_t bytes, size_t alignment) {
+    void* ptr = m_buffer.allocate(bytes, alignment);
+    m_bytes += bytes;
+    m_peak_bytes = std::max(m_peak_bytes, m_bytes);
+    return ptr;
+}
+
+void ConversionArena::do_deallocate(void*, size_t, size_t) {
+    // 单调分配：在 release() 时统一释放
+}
+
+bool ConversionArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace cpppy_bridge
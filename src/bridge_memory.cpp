@@ -0,0 +1,279 @@
+#include "bridge_memory.h"
+#include "python_bridge.h"
+#include "python_object.h"
+#include "type_converter.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace cpppy_bridge {
+
+// BridgeMemoryStats 实现
+LiveObjectCounts BridgeMemoryStats::liveObjects() {
+    LiveObjectCounts counts;
+    counts.modules = detail::LiveCounter<PythonModule>::live();
+    counts.functions = detail::LiveCounter<PythonFunction>::live();
+    counts.call_handles = detail::LiveCounter<CallHandle>::live();
+    counts.instances = detail::LiveCounter<PythonObject>::live();
+    counts.memo_caches = MemoCache::liveCaches();
+    counts.memo_entries = MemoCache::totalEntries();
+    counts.memo_bytes = MemoCache::totalBytes();
+    counts.code_cache_entries = PythonInterpreter::getInstance().getCodeCache().getStats().size;
+    counts.error_callbacks = ErrorHandler::errorCallbackCount();
+    counts.custom_converters = CustomTypeRegistry::retainedCount();
+    return counts;
+}
+
+NativeHeapStats BridgeMemoryStats::nativeHeap() {
+    NativeHeapStats stats;
+
+#if defined(__linux__)
+    // /proc/self/statm：总页数 常驻页数 ...
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (statm >> total_pages >> resident_pages) {
+        stats.rss_bytes = resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        stats.peak_rss_bytes = static_cast<size_t>(usage.ru_maxrss);
+#else
+        stats.peak_rss_bytes = static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    stats.malloc_in_use_bytes = info.uordblks + info.hblkhd;
+#endif
+
+    return stats;
+}
+
+PythonHeapStats BridgeMemoryStats::pythonHeap() {
+    PythonHeapStats stats;
+    if (!Py_IsInitialized()) {
+        return stats;
+    }
+
+    py::gil_scoped_acquire gil;
+    try {
+        stats.allocated_blocks = py::module_::import("sys").attr("getallocatedblocks")().cast<size_t>();
+
+        py::tuple counts = py::module_::import("gc").attr("get_count")();
+        for (size_t i = 0; i < 3 && i < counts.size(); ++i) {
+            stats.gc_counts[i] = counts[i].cast<size_t>();
+        }
+
+        // 未导入 tracemalloc 时不主动导入
+        PyObject* tracemalloc = PyDict_GetItemString(PyImport_GetModuleDict(), "tracemalloc");
+        if (tracemalloc) {
+            py::object module = py::reinterpret_borrow<py::object>(tracemalloc);
+            if (module.attr("is_tracing")().cast<bool>()) {
+                py::tuple memory = module.attr("get_traced_memory")();
+                stats.traced_bytes = memory[0].cast<size_t>();
+            }
+        }
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+    }
+    return stats;
+}
+
+MemorySample BridgeMemoryStats::sample() {
+    MemorySample sample;
+    sample.timestamp = std::chrono::system_clock::now();
+    sample.python = pythonHeap();
+    sample.native = nativeHeap();
+    sample.objects = liveObjects();
+    return sample;
+}
+
+std::string BridgeMemoryStats::exportPrometheus(const MemorySample& sample, const std::string& prefix) {
+    std::ostringstream oss;
+
+    auto gauge = [&oss, &prefix](const std::string& name, const char* help, size_t value) {
+        oss << "# HELP " << prefix << "_" << name << " " << help << "\n";
+        oss << "# TYPE " << prefix << "_" << name << " gauge\n";
+        oss << prefix << "_" << name << " " << value << '\n';
+    };
+
+    gauge("python_allocated_blocks", "Memory blocks allocated by the Python allocator.",
+          sample.python.allocated_blocks);
+    gauge("python_traced_bytes", "Python heap traced by tracemalloc.", sample.python.traced_bytes);
+
+    oss << "# HELP " << prefix << "_python_gc_count Objects pending collection per GC generation.\n";
+    oss << "# TYPE " << prefix << "_python_gc_count gauge\n";
+    for (size_t i = 0; i < 3; ++i) {
+        oss << prefix << "_python_gc_count{generation=\"" << i << "\"} " << sample.python.gc_counts[i] << '\n';
+    }
+
+    gauge("resident_bytes", "Resident set size of the process.", sample.native.rss_bytes);
+    gauge("peak_resident_bytes", "Peak resident set size of the process.", sample.native.peak_rss_bytes);
+    gauge("malloc_in_use_bytes", "Bytes in use by malloc.", sample.native.malloc_in_use_bytes);
+
+    const LiveObjectCounts& objects = sample.objects;
+    const std::pair<const char*, size_t> live[] = {
+        {"module", objects.modules},
+        {"function", objects.functions},
+        {"call_handle", objects.call_handles},
+        {"instance", objects.instances},
+        {"memo_cache", objects.memo_caches},
+        {"code_cache_entry", objects.code_cache_entries},
+        {"error_callback", objects.error_callbacks},
+        {"custom_converter", objects.custom_converters},
+    };
+    oss << "# HELP " << prefix << "_live_objects Live bridge objects by kind.\n";
+    oss << "# TYPE " << prefix << "_live_objects gauge\n";
+    for (const auto& [kind, count] : live) {
+        oss << prefix << "_live_objects{kind=\"" << kind << "\"} " << count << '\n';
+    }
+
+    gauge("memo_cache_entries", "Entries across all memoization caches.", objects.memo_entries);
+    gauge("memo_cache_bytes", "Approximate footprint of all memoization caches.", objects.memo_bytes);
+    return oss.str();
+}
+
+namespace detail {
+
+struct PythonHeapProbe {
+    std::mutex mutex;
+    PythonHeapStats latest;
+    std::atomic<bool> pending{false};
+};
+
+} // namespace detail
+
+namespace {
+
+// 由主线程在持有 GIL 时执行；arg 为堆上的 shared_ptr，采样器先销毁时探针仍然有效
+int collectPythonHeap(void* arg) {
+    std::unique_ptr<std::shared_ptr<detail::PythonHeapProbe>> probe(
+        static_cast<std::shared_ptr<detail::PythonHeapProbe>*>(arg));
+    try {
+        PythonHeapStats stats = BridgeMemoryStats::pythonHeap();
+        std::lock_guard<std::mutex> lock((*probe)->mutex);
+        (*probe)->latest = stats;
+    } catch (const std::exception& e) {
+        // 返回 -1 会在主线程中抛出异常，这里只记录
+        PyErr_Clear();
+        std::cerr << "MemorySampler: " << e.what() << std::endl;
+    }
+    (*probe)->pending.store(false, std::memory_order_release);
+    return 0;
+}
+
+} // namespace
+
+// MemorySampler 实现
+MemorySampler::MemorySampler(std::chrono::milliseconds interval, Callback callback, size_t history)
+    : m_interval(interval),
+      m_callback(std::move(callback)),
+      m_history_size(std::max<size_t>(history, 1)),
+      m_probe(std::make_shared<detail::PythonHeapProbe>()) {
+    m_thread = std::thread(&MemorySampler::run, this);
+}
+
+MemorySampler::~MemorySampler() {
+    stop();
+}
+
+void MemorySampler::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_all();
+
+    // 采样线程本身不获取GIL，但回调可能需要
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+    m_thread.join();
+}
+
+std::vector<MemorySample> MemorySampler::history() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<MemorySample>(m_history.begin(), m_history.end());
+}
+
+std::optional<MemorySample> MemorySampler::latest() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_history.empty()) {
+        return std::nullopt;
+    }
+    return m_history.back();
+}
+
+MemorySample MemorySampler::takeSample() {
+    MemorySample sample;
+    sample.timestamp = std::chrono::system_clock::now();
+    sample.native = BridgeMemoryStats::nativeHeap();
+    sample.objects = BridgeMemoryStats::liveObjects();
+
+    // Python 堆计数来自上一次挂起调用的结果；不阻塞等待 GIL
+    {
+        std::lock_guard<std::mutex> lock(m_probe->mutex);
+        sample.python = m_probe->latest;
+    }
+    if (Py_IsInitialized() && PythonInterpreter::getInstance().tracemallocStarted() &&
+        !m_probe->pending.exchange(true, std::memory_order_acq_rel)) {
+        auto* arg = new std::shared_ptr<detail::PythonHeapProbe>(m_probe);
+        if (Py_AddPendingCall(&collectPythonHeap, arg) != 0) {
+            // 挂起调用队列已满，跳过本次请求
+            delete arg;
+            m_probe->pending.store(false, std::memory_order_release);
+        }
+    }
+    return sample;
+}
+
+void MemorySampler::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    do {
+        lock.unlock();
+
+        std::optional<MemorySample> sample;
+        try {
+            sample = takeSample();
+            if (m_callback) {
+                m_callback(*sample);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "MemorySampler: " << e.what() << std::endl;
+        }
+
+        lock.lock();
+        if (sample) {
+            m_history.push_back(std::move(*sample));
+            while (m_history.size() > m_history_size) {
+                m_history.pop_front();
+            }
+        }
+    } while (!m_wakeup.wait_for(lock, m_interval, [this] { return m_stop; }));
+}
+
+} // namespace cpppy_bridge
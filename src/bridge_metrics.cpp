@@ -0,0 +1,391 @@
+#include "bridge_metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace cpppy_bridge {
+
+namespace {
+
+unsigned highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+// 单写者直方图：只有所属线程写入，读取方在合并时以 relaxed 方式读取
+struct ShardHistogram {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> min_ns{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max_ns{0};
+    std::atomic<uint64_t> buckets[LatencyHistogram::kBuckets] = {};
+
+    // 所属线程是唯一写者，无需原子读改写指令
+    void record(uint64_t ns) {
+        auto bump = [](std::atomic<uint64_t>& counter, uint64_t delta) {
+            counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        };
+        bump(count, 1);
+        bump(total_ns, ns);
+        bump(buckets[LatencyHistogram::bucketIndex(ns)], 1);
+        if (ns < min_ns.load(std::memory_order_relaxed)) {
+            min_ns.store(ns, std::memory_order_relaxed);
+        }
+        if (ns > max_ns.load(std::memory_order_relaxed)) {
+            max_ns.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    void clear() {
+        count.store(0, std::memory_order_relaxed);
+        total_ns.store(0, std::memory_order_relaxed);
+        min_ns.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+        for (auto& bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void mergeInto(LatencyHistogram& target) const {
+        const uint64_t n = count.load(std::memory_order_relaxed);
+        if (n == 0) {
+            return;
+        }
+        if (target.buckets.empty()) {
+            target.buckets.assign(LatencyHistogram::kBuckets, 0);
+            target.min_ns = std::numeric_limits<uint64_t>::max();
+        }
+        target.count += n;
+        target.total_ns += total_ns.load(std::memory_order_relaxed);
+        target.min_ns = std::min(target.min_ns, min_ns.load(std::memory_order_relaxed));
+        target.max_ns = std::max(target.max_ns, max_ns.load(std::memory_order_relaxed));
+        for (size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+            target.buckets[i] += buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+void mergeHistogram(LatencyHistogram& target, const LatencyHistogram& source) {
+    if (source.count == 0) {
+        return;
+    }
+    if (target.buckets.empty()) {
+        target = source;
+        return;
+    }
+    target.count += source.count;
+    target.total_ns += source.total_ns;
+    target.min_ns = std::min(target.min_ns, source.min_ns);
+    target.max_ns = std::max(target.max_ns, source.max_ns);
+    for (size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+        target.buckets[i] += source.buckets[i];
+    }
+}
+
+void appendLabelValue(std::ostringstream& oss, const std::string& value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': oss << "\\\\"; break;
+            case '"': oss << "\\\""; break;
+            case '\n': oss << "\\n"; break;
+            default: oss << c;
+        }
+    }
+}
+
+} // namespace
+
+struct BridgeMetrics::FunctionShard {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> exceptions{0};
+    ShardHistogram phases[kMetricPhaseCount];
+};
+
+namespace {
+
+// 每个线程一个分片；函数表只由所属线程插入，插入与合并读取时加锁
+struct ThreadShard {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::unique_ptr<BridgeMetrics::FunctionShard>> functions;
+    std::string key;
+    uint32_t conversion_depth = 0;
+};
+
+struct MetricsRegistry {
+    std::mutex mutex;
+    std::vector<ThreadShard*> shards;
+
+    // 已退出线程的数据
+    std::map<std::string, FunctionMetrics> retired;
+};
+
+MetricsRegistry& registry() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+void mergeShard(const std::string& name, const BridgeMetrics::FunctionShard& shard,
+                std::map<std::string, FunctionMetrics>& merged);
+
+// 线程退出时将分片数据并入 retired 并注销
+struct ThreadShardHolder {
+    ThreadShard* shard;
+
+    ThreadShardHolder() : shard(new ThreadShard) {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.shards.push_back(shard);
+    }
+
+    ~ThreadShardHolder() {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto& entry : shard->functions) {
+            mergeShard(entry.first, *entry.second, reg.retired);
+        }
+        reg.shards.erase(std::remove(reg.shards.begin(), reg.shards.end(), shard), reg.shards.end());
+        delete shard;
+    }
+};
+
+ThreadShard& threadShard() {
+    thread_local ThreadShardHolder holder;
+    return *holder.shard;
+}
+
+void mergeShard(const std::string& name, const BridgeMetrics::FunctionShard& shard,
+                std::map<std::string, FunctionMetrics>& merged) {
+    FunctionMetrics& metrics = merged[name];
+    metrics.name = name;
+    metrics.calls += shard.calls.load(std::memory_order_relaxed);
+    metrics.exceptions += shard.exceptions.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kMetricPhaseCount; ++i) {
+        shard.phases[i].mergeInto(metrics.phases[i]);
+    }
+}
+
+} // namespace
+
+const char* metricPhaseName(MetricPhase phase) {
+    switch (phase) {
+        case MetricPhase::Python: return "python";
+        case MetricPhase::GilWait: return "gil_wait";
+        case MetricPhase::ArgConversion: return "arg_conversion";
+        case MetricPhase::ResultConversion: return "result_conversion";
+    }
+    return "unknown";
+}
+
+// LatencyHistogram 实现
+size_t LatencyHistogram::bucketIndex(uint64_t ns) {
+    if (ns < 2 * kSubBuckets) {
+        return static_cast<size_t>(ns);
+    }
+    const unsigned exponent = highestBit(ns);
+    if (exponent > kMaxExponent) {
+        return kBuckets - 1;
+    }
+    const size_t sub = static_cast<size_t>(ns >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < 2 * kSubBuckets) {
+        return index;
+    }
+    const size_t exponent = index / kSubBuckets + kSubBucketBits - 1;
+    const uint64_t width = uint64_t{1} << (exponent - kSubBucketBits);
+    const uint64_t lower = (kSubBuckets + index % kSubBuckets) * width;
+    return lower + width - 1;
+}
+
+double LatencyHistogram::meanNanos() const {
+    return count == 0 ? 0.0 : static_cast<double>(total_ns) / static_cast<double>(count);
+}
+
+uint64_t LatencyHistogram::percentileNanos(double q) const {
+    if (count == 0 || buckets.empty()) {
+        return 0;
+    }
+    q = std::min(std::max(q, 0.0), 1.0);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(std::max(bucketUpperBound(i), min_ns), max_ns);
+        }
+    }
+    return max_ns;
+}
+
+// MetricsSnapshot 实现
+const FunctionMetrics* MetricsSnapshot::find(const std::string& name) const {
+    auto it = std::lower_bound(functions.begin(), functions.end(), name,
+                               [](const FunctionMetrics& metrics, const std::string& key) { return metrics.name < key; });
+    return it != functions.end() && it->name == name ? &*it : nullptr;
+}
+
+// BridgeMetrics 实现
+std::atomic<bool> BridgeMetrics::s_enabled{false};
+
+void BridgeMetrics::setEnabled(bool enable) {
+    s_enabled.store(enable, std::memory_order_relaxed);
+}
+
+BridgeMetrics::FunctionShard& BridgeMetrics::shardFor(std::string_view scope, std::string_view name) {
+    ThreadShard& shard = threadShard();
+
+    // 复用线程内的键缓冲区，热路径上不分配内存
+    shard.key.assign(scope.data(), scope.size());
+    shard.key += '.';
+    shard.key.append(name.data(), name.size());
+
+    auto it = shard.functions.find(shard.key);
+    if (it != shard.functions.end()) {
+        return *it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto inserted = shard.functions.emplace(shard.key, std::make_unique<FunctionShard>());
+    return *inserted.first->second;
+}
+
+void BridgeMetrics::record(FunctionShard& shard, MetricPhase phase, uint64_t ns) {
+    shard.phases[static_cast<size_t>(phase)].record(ns);
+}
+
+void BridgeMetrics::finish(FunctionShard& shard, bool failed) {
+    shard.calls.store(shard.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (failed) {
+        shard.exceptions.store(shard.exceptions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+bool BridgeMetrics::enterConversion() {
+    return threadShard().conversion_depth++ == 0;
+}
+
+void BridgeMetrics::leaveConversion() {
+    --threadShard().conversion_depth;
+}
+
+MetricsSnapshot BridgeMetrics::snapshot() {
+    std::map<std::string, FunctionMetrics> merged;
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto& entry : reg.retired) {
+            FunctionMetrics& metrics = merged[entry.first];
+            metrics.name = entry.first;
+            metrics.calls += entry.second.calls;
+            metrics.exceptions += entry.second.exceptions;
+            for (size_t i = 0; i < kMetricPhaseCount; ++i) {
+                mergeHistogram(metrics.phases[i], entry.second.phases[i]);
+            }
+        }
+        for (ThreadShard* shard : reg.shards) {
+            std::lock_guard<std::mutex> shard_lock(shard->mutex);
+            for (const auto& entry : shard->functions) {
+                mergeShard(entry.first, *entry.second, merged);
+            }
+        }
+    }
+
+    MetricsSnapshot result;
+    result.timestamp = std::chrono::system_clock::now();
+    result.functions.reserve(merged.size());
+    for (auto& entry : merged) {
+        result.functions.push_back(std::move(entry.second));
+    }
+    return result;
+}
+
+void BridgeMetrics::reset() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.retired.clear();
+    for (ThreadShard* shard : reg.shards) {
+        std::lock_guard<std::mutex> shard_lock(shard->mutex);
+        for (auto& entry : shard->functions) {
+            entry.second->calls.store(0, std::memory_order_relaxed);
+            entry.second->exceptions.store(0, std::memory_order_relaxed);
+            for (auto& phase : entry.second->phases) {
+                phase.clear();
+            }
+        }
+    }
+}
+
+std::string BridgeMetrics::exportPrometheus(const std::string& prefix) {
+    return exportPrometheus(snapshot(), prefix);
+}
+
+std::string BridgeMetrics::exportPrometheus(const MetricsSnapshot& snapshot, const std::string& prefix) {
+    std::ostringstream oss;
+    oss << std::setprecision(9);
+
+    auto labels = [&oss](const FunctionMetrics& metrics) {
+        oss << "{function=\"";
+        appendLabelValue(oss, metrics.name);
+        oss << '"';
+    };
+
+    oss << "# HELP " << prefix << "_calls_total Calls through the bridge.\n";
+    oss << "# TYPE " << prefix << "_calls_total counter\n";
+    for (const auto& metrics : snapshot.functions) {
+        oss << prefix << "_calls_total";
+        labels(metrics);
+        oss << "} " << metrics.calls << '\n';
+    }
+
+    oss << "# HELP " << prefix << "_exceptions_total Calls that ended with an exception.\n";
+    oss << "# TYPE " << prefix << "_exceptions_total counter\n";
+    for (const auto& metrics : snapshot.functions) {
+        oss << prefix << "_exceptions_total";
+        labels(metrics);
+        oss << "} " << metrics.exceptions << '\n';
+    }
+
+    static const double kQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+    for (size_t p = 0; p < kMetricPhaseCount; ++p) {
+        const std::string metric = prefix + "_" + metricPhaseName(static_cast<MetricPhase>(p)) + "_seconds";
+        oss << "# HELP " << metric << " Time spent in the " << metricPhaseName(static_cast<MetricPhase>(p))
+            << " phase of bridge calls.\n";
+        oss << "# TYPE " << metric << " summary\n";
+        for (const auto& metrics : snapshot.functions) {
+            const LatencyHistogram& histogram = metrics.phases[p];
+            if (histogram.count == 0) {
+                continue;
+            }
+            for (double q : kQuantiles) {
+                oss << metric;
+                labels(metrics);
+                oss << ",quantile=\"" << q << "\"} " << histogram.percentileNanos(q) * 1e-9 << '\n';
+            }
+            oss << metric << "_sum";
+            labels(metrics);
+            oss << "} " << static_cast<double>(histogram.total_ns) * 1e-9 << '\n';
+            oss << metric << "_count";
+            labels(metrics);
+            oss << "} " << histogram.count << '\n';
+        }
+    }
+    return oss.str();
+}
+
+} // namespace cpppy_bridge
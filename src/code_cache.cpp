@@ -0,0 +1,162 @@
+#include "code_cache.h"
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+
+namespace cpppy_bridge {
+
+// CodeCache 实现
+CodeCache::CodeCache(size_t capacity) : m_capacity(capacity) {}
+
+CodeCache::~CodeCache() {
+    // 解释器已终止时不能再释放代码对象，仅丢弃引用
+    if (!Py_IsInitialized()) {
+        for (auto& entry : m_entries) {
+            entry.code.release();
+        }
+    }
+}
+
+uint64_t CodeCache::makeKey(const std::string& text, CodeMode mode, bool is_file) {
+    uint64_t key = std::hash<std::string>{}(text);
+    key ^= (static_cast<uint64_t>(mode) + 1) * 0x9E3779B97F4A7C15ULL;
+    if (is_file) {
+        key ^= 0xC2B2AE3D27D4EB4FULL;
+    }
+    return key;
+}
+
+bool CodeCache::cacheableInterpreter() {
+    // 代码对象属于创建它的解释器，子解释器不使用缓存
+    return PyInterpreterState_Get() == PyInterpreterState_Main();
+}
+
+py::object CodeCache::compile(const std::string& source, CodeMode mode, const char* filename) {
+    PyObject* code = Py_CompileString(source.c_str(), filename,
+                                      mode == CodeMode::Eval ? Py_eval_input : Py_file_input);
+    if (!code) {
+        throw py::error_already_set();
+    }
+    return py::reinterpret_steal<py::object>(code);
+}
+
+CodeCache::EntryList::iterator CodeCache::find(uint64_t key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        return m_entries.end();
+    }
+    // 移到链表头部，标记为最近使用
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second;
+}
+
+py::object CodeCache::insert(Entry entry) {
+    py::object code = entry.code;
+    auto existing = m_index.find(entry.key);
+    if (existing != m_index.end()) {
+        // 哈希冲突或文件已修改：原位替换
+        *existing->second = std::move(entry);
+        m_entries.splice(m_entries.begin(), m_entries, existing->second);
+        return code;
+    }
+
+    m_entries.push_front(std::move(entry));
+    m_index.emplace(m_entries.front().key, m_entries.begin());
+    evictToCapacity();
+    m_size.store(m_entries.size(), std::memory_order_relaxed);
+    return code;
+}
+
+void CodeCache::evictToCapacity() {
+    const size_t capacity = m_capacity.load(std::memory_order_relaxed);
+    while (m_entries.size() > capacity) {
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+py::object CodeCache::get(const std::string& source, CodeMode mode, const char* filename) {
+    if (capacity() == 0 || !cacheableInterpreter()) {
+        return compile(source, mode, filename);
+    }
+
+    const uint64_t key = makeKey(source, mode, false);
+    auto it = find(key);
+    if (it != m_entries.end() && !it->is_file && it->mode == mode && it->text == source) {
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return it->code;
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    Entry entry{key, mode, source, compile(source, mode, filename)};
+    return insert(std::move(entry));
+}
+
+py::object CodeCache::getFile(const std::string& path) {
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    uintmax_t file_size = ec ? 0 : std::filesystem::file_size(path, ec);
+    if (ec) {
+        throw std::runtime_error("File not found: " + path);
+    }
+
+    const bool cacheable = capacity() > 0 && cacheableInterpreter();
+    const uint64_t key = makeKey(path, CodeMode::Exec, true);
+    if (cacheable) {
+        auto it = find(key);
+        if (it != m_entries.end() && it->is_file && it->text == path) {
+            if (it->mtime == mtime && it->file_size == file_size) {
+                m_hits.fetch_add(1, std::memory_order_relaxed);
+                return it->code;
+            }
+            m_invalidations.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+
+    py::object code = compile(contents.str(), CodeMode::Exec, path.c_str());
+    if (!cacheable) {
+        return code;
+    }
+
+    Entry entry{key, CodeMode::Exec, path, std::move(code), true, mtime, file_size};
+    return insert(std::move(entry));
+}
+
+void CodeCache::setCapacity(size_t capacity) {
+    m_capacity.store(capacity, std::memory_order_relaxed);
+    evictToCapacity();
+    m_size.store(m_entries.size(), std::memory_order_relaxed);
+}
+
+size_t CodeCache::capacity() const {
+    return m_capacity.load(std::memory_order_relaxed);
+}
+
+void CodeCache::clear() {
+    m_index.clear();
+    m_entries.clear();
+    m_size.store(0, std::memory_order_relaxed);
+}
+
+CodeCacheStats CodeCache::getStats() const {
+    CodeCacheStats stats;
+    stats.hits = m_hits.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    stats.evictions = m_evictions.load(std::memory_order_relaxed);
+    stats.invalidations = m_invalidations.load(std::memory_order_relaxed);
+    stats.size = m_size.load(std::memory_order_relaxed);
+    stats.capacity = capacity();
+    return stats;
+}
+
+} // namespace cpppy_bridge
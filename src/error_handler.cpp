@@ -1,11 +1,196 @@
 #include "error_handler.h"
+#include "error_log_sink.h"
+#include "python_bridge.h"
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <chrono>
-#include <iomanip>
 
 namespace cpppy_bridge {
 
+namespace {
+
+// 每次解释器终止时递增，用于识别属于已终止解释器的对象
+std::atomic<uint64_t> g_interpreter_epoch{0};
+
+// 主解释器中缓存的 traceback 模块（强引用，由 resetInterpreterState 释放）
+PyObject* g_traceback_module = nullptr;
+
+// 子解释器不能共享对象，只在主解释器中使用缓存
+py::object tracebackModule() {
+    if (PyInterpreterState_Get() != PyInterpreterState_Main()) {
+        return py::module::import("traceback");
+    }
+    if (!g_traceback_module) {
+        g_traceback_module = py::module::import("traceback").release().ptr();
+    }
+    return py::reinterpret_borrow<py::object>(g_traceback_module);
+}
+
+// 日志输出目标；用户显式设置后不再安装默认目标
+std::shared_ptr<ErrorLogSink> g_log_sink;
+std::atomic<bool> g_log_sink_configured{false};
+std::once_flag g_default_sink_once;
+
+ErrorRateLimiter g_rate_limiter;
+
+// 异步回调分发目标，未启用时为空
+std::shared_ptr<ErrorLogSink> g_callback_sink;
+
+// 回调列表的写入锁；读取方从不加锁
+std::mutex g_callbacks_mutex;
+
+// 当前发布的回调列表与等待回收的旧列表（仅在持有写入锁时访问）
+std::shared_ptr<const void> g_current_callbacks;
+std::vector<std::shared_ptr<const void>> g_retired_callbacks;
+
+} // namespace
+
+// PythonErrorInfo 实现
+struct PythonErrorInfo::LazyDetails {
+    PyObject* trace = nullptr;          // 强引用，格式化后释放
+    PyInterpreterState* interp = nullptr;
+    uint64_t epoch = 0;
+
+    std::atomic<bool> ready{false};
+    std::mutex publish_mutex;
+    std::string traceback;
+    std::string file;
+    std::string function;
+    int line = -1;
+
+    ~LazyDetails();
+    void materialize();
+};
+
+PythonErrorInfo::LazyDetails::~LazyDetails() {
+    if (!trace) {
+        return;
+    }
+    // 解释器已终止或重新初始化时，引用随旧解释器一起失效
+    if (!Py_IsInitialized() || epoch != g_interpreter_epoch.load(std::memory_order_acquire)) {
+        return;
+    }
+    if (PythonInterpreter::holdsGIL()) {
+        // 只能在创建它的解释器中释放
+        if (PyInterpreterState_Get() == interp) {
+            Py_DECREF(trace);
+        }
+    } else if (interp == PyInterpreterState_Main()) {
+        py::gil_scoped_acquire gil;
+        Py_DECREF(trace);
+    }
+}
+
+void PythonErrorInfo::LazyDetails::materialize() {
+    if (!Py_IsInitialized() || epoch != g_interpreter_epoch.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // 堆栈跟踪只能在创建它的解释器中格式化
+    std::optional<py::gil_scoped_acquire> gil;
+    if (PythonInterpreter::holdsGIL()) {
+        if (PyInterpreterState_Get() != interp) {
+            return;
+        }
+    } else if (interp == PyInterpreterState_Main()) {
+        gil.emplace();
+    } else {
+        return;
+    }
+
+    // 格式化过程可能释放GIL，因此在锁外计算，只在发布时加锁
+    std::string formatted;
+    std::string frame_file;
+    std::string frame_function;
+    int frame_line = -1;
+
+    py::object trace_obj;
+    {
+        std::lock_guard<std::mutex> lock(publish_mutex);
+        if (ready.load(std::memory_order_relaxed) || !trace) {
+            return;
+        }
+        trace_obj = py::reinterpret_borrow<py::object>(trace);
+    }
+
+    try {
+        py::object formatted_tb = tracebackModule().attr("format_tb")(trace_obj);
+        std::ostringstream oss;
+        for (const auto& entry : formatted_tb) {
+            oss << py::str(entry).cast<std::string>();
+        }
+        formatted = oss.str();
+    } catch (...) {
+        formatted = "Failed to parse traceback";
+    }
+
+    // 直接遍历traceback链找到最内层帧，无需导入模块或读取源文件
+    try {
+        py::object tb = trace_obj;
+        while (true) {
+            py::object next = tb.attr("tb_next");
+            if (next.is_none()) {
+                break;
+            }
+            tb = next;
+        }
+        py::object code = tb.attr("tb_frame").attr("f_code");
+        frame_file = py::str(code.attr("co_filename")).cast<std::string>();
+        frame_function = py::str(code.attr("co_name")).cast<std::string>();
+        frame_line = tb.attr("tb_lineno").cast<int>();
+    } catch (...) {
+        // 忽略堆栈跟踪解析错误
+    }
+
+    std::lock_guard<std::mutex> lock(publish_mutex);
+    if (ready.load(std::memory_order_relaxed)) {
+        return;
+    }
+    traceback = std::move(formatted);
+    file = std::move(frame_file);
+    function = std::move(frame_function);
+    line = frame_line;
+    Py_DECREF(trace);
+    trace = nullptr;
+    ready.store(true, std::memory_order_release);
+}
+
+const PythonErrorInfo::LazyDetails* PythonErrorInfo::details() const {
+    if (!m_details) {
+        return nullptr;
+    }
+    if (!m_details->ready.load(std::memory_order_acquire)) {
+        m_details->materialize();
+    }
+    return m_details->ready.load(std::memory_order_acquire) ? m_details.get() : nullptr;
+}
+
+const std::string& PythonErrorInfo::traceback() const {
+    static const std::string empty;
+    const LazyDetails* d = details();
+    return d ? d->traceback : empty;
+}
+
+const std::string& PythonErrorInfo::file() const {
+    static const std::string empty;
+    const LazyDetails* d = details();
+    return d ? d->file : empty;
+}
+
+int PythonErrorInfo::line() const {
+    const LazyDetails* d = details();
+    return d ? d->line : -1;
+}
+
+const std::string& PythonErrorInfo::function() const {
+    static const std::string empty;
+    const LazyDetails* d = details();
+    return d ? d->function : empty;
+}
+
 // PythonBridgeException 实现
 PythonBridgeException::PythonBridgeException(const std::string &message)
     : m_message(message) {}
@@ -47,21 +232,99 @@ const std::string &TypeConversionException::getToType() const {
 }
 
 // ErrorHandler 静态成员初始化
-std::vector<ErrorHandler::ErrorCallback> ErrorHandler::s_error_callbacks;
-bool ErrorHandler::s_verbose_errors = true;
-bool ErrorHandler::s_error_logging = true;
+std::atomic<const ErrorHandler::CallbackList*> ErrorHandler::s_error_callbacks{nullptr};
+std::atomic<uint32_t> ErrorHandler::s_callback_readers{0};
+std::atomic<ErrorHandler::CallbackToken> ErrorHandler::s_next_callback_token{1};
+std::atomic<bool> ErrorHandler::s_verbose_errors{true};
+std::atomic<bool> ErrorHandler::s_error_logging{true};
+
+ErrorHandler::CallbackToken ErrorHandler::setGlobalErrorCallback(ErrorCallback callback) {
+    const CallbackToken token = s_next_callback_token.fetch_add(1, std::memory_order_relaxed);
+    auto list = std::make_unique<CallbackList>();
+    list->push_back({token, std::move(callback)});
+
+    std::vector<std::shared_ptr<const void>> reclaimed;
+    {
+        std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+        reclaimed = publishCallbacks(std::move(list));
+    }
+    return token;
+}
 
-void ErrorHandler::setGlobalErrorCallback(ErrorCallback callback) {
-    s_error_callbacks.clear();
-    s_error_callbacks.push_back(callback);
+ErrorHandler::CallbackToken ErrorHandler::addErrorCallback(ErrorCallback callback) {
+    const CallbackToken token = s_next_callback_token.fetch_add(1, std::memory_order_relaxed);
+
+    std::vector<std::shared_ptr<const void>> reclaimed;
+    {
+        std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+        const CallbackList* current = s_error_callbacks.load(std::memory_order_acquire);
+        auto list = current ? std::make_unique<CallbackList>(*current) : std::make_unique<CallbackList>();
+        list->push_back({token, std::move(callback)});
+        reclaimed = publishCallbacks(std::move(list));
+    }
+    return token;
 }
 
-void ErrorHandler::addErrorCallback(ErrorCallback callback) {
-    s_error_callbacks.push_back(callback);
+bool ErrorHandler::removeErrorCallback(CallbackToken token) {
+    std::vector<std::shared_ptr<const void>> reclaimed;
+    {
+        std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+        const CallbackList* current = s_error_callbacks.load(std::memory_order_acquire);
+        if (!current) {
+            return false;
+        }
+
+        auto it = std::find_if(current->begin(), current->end(),
+                               [token](const CallbackEntry& entry) { return entry.token == token; });
+        if (it == current->end()) {
+            return false;
+        }
+
+        std::unique_ptr<CallbackList> list;
+        if (current->size() > 1) {
+            list = std::make_unique<CallbackList>();
+            list->reserve(current->size() - 1);
+            list->insert(list->end(), current->begin(), it);
+            list->insert(list->end(), std::next(it), current->end());
+        }
+        reclaimed = publishCallbacks(std::move(list));
+    }
+    return true;
 }
 
 void ErrorHandler::clearErrorCallbacks() {
-    s_error_callbacks.clear();
+    std::vector<std::shared_ptr<const void>> reclaimed;
+    {
+        std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+        reclaimed = publishCallbacks(nullptr);
+    }
+}
+
+size_t ErrorHandler::errorCallbackCount() {
+    // 计数器保护列表在读取期间不被回收
+    s_callback_readers.fetch_add(1, std::memory_order_seq_cst);
+    const CallbackList* list = s_error_callbacks.load(std::memory_order_seq_cst);
+    const size_t count = list ? list->size() : 0;
+    s_callback_readers.fetch_sub(1, std::memory_order_release);
+    return count;
+}
+
+std::vector<std::shared_ptr<const void>> ErrorHandler::publishCallbacks(std::unique_ptr<const CallbackList> list) {
+    std::shared_ptr<const void> owner(std::move(list));
+    s_error_callbacks.store(static_cast<const CallbackList*>(owner.get()), std::memory_order_seq_cst);
+    if (g_current_callbacks) {
+        g_retired_callbacks.push_back(std::move(g_current_callbacks));
+    }
+    g_current_callbacks = std::move(owner);
+
+    // 读取方先递增计数再加载指针：发布后观察到计数为零，说明之后的读取方
+    // 只能看到新列表，此前退休的旧列表都可以回收。写入方从不等待读取方，
+    // 因此回调内部注册或注销回调也不会死锁。
+    std::vector<std::shared_ptr<const void>> reclaimed;
+    if (s_callback_readers.load(std::memory_order_seq_cst) == 0) {
+        reclaimed.swap(g_retired_callbacks);
+    }
+    return reclaimed;
 }
 
 PythonErrorInfo ErrorHandler::handlePythonException(const py::error_already_set &e) {
@@ -71,14 +334,16 @@ PythonErrorInfo ErrorHandler::handlePythonException(const py::error_already_set
         logError(error_info);
     }
 
-    triggerErrorCallbacks(error_info);
+    dispatchErrorCallbacks(error_info);
 
     return error_info;
 }
 
 void ErrorHandler::convertPythonException(const py::error_already_set &e) {
-    auto error_info = extractPythonErrorInfo(e);
+    convertPythonException(extractPythonErrorInfo(e));
+}
 
+void ErrorHandler::convertPythonException(const PythonErrorInfo &error_info) {
     // 根据Python异常类型转换为相应的C++异常
     if (error_info.type == "ModuleNotFoundError" || error_info.type == "ImportError") {
         throw PythonModuleException("unknown", error_info.message);
@@ -111,31 +376,13 @@ PythonErrorInfo ErrorHandler::extractPythonErrorInfo(const py::error_already_set
             info.message = py::str(value_obj).cast<std::string>();
         }
 
-        // 获取堆栈跟踪
+        // 只保存堆栈跟踪的引用，首次访问时再格式化
         if (e.trace()) {
-            py::object trace_obj = py::reinterpret_borrow<py::object>(e.trace());
-            info.traceback = parsePythonTraceback(trace_obj);
-
-            // 尝试从堆栈跟踪中提取文件名和行号
-            try {
-                py::module traceback_module = py::module::import("traceback");
-                py::object tb_list = traceback_module.attr("extract_tb")(trace_obj);
-
-                if (py::len(tb_list) > 0) {
-                    py::object last_frame = tb_list[py::cast(py::len(tb_list) - 1)];
-                    if (py::hasattr(last_frame, "filename")) {
-                        info.file = py::str(last_frame.attr("filename")).cast<std::string>();
-                    }
-                    if (py::hasattr(last_frame, "lineno")) {
-                        info.line = py::int_(last_frame.attr("lineno")).cast<int>();
-                    }
-                    if (py::hasattr(last_frame, "name")) {
-                        info.function = py::str(last_frame.attr("name")).cast<std::string>();
-                    }
-                }
-            } catch (...) {
-                // 忽略堆栈跟踪解析错误
-            }
+            auto details = std::make_shared<PythonErrorInfo::LazyDetails>();
+            details->trace = e.trace().inc_ref().ptr();
+            details->interp = PyInterpreterState_Get();
+            details->epoch = g_interpreter_epoch.load(std::memory_order_acquire);
+            info.m_details = std::move(details);
         }
     } catch (...) {
         // 如果解析异常信息失败，使用默认值
@@ -147,6 +394,10 @@ PythonErrorInfo ErrorHandler::extractPythonErrorInfo(const py::error_already_set
 }
 
 std::string ErrorHandler::formatErrorInfo(const PythonErrorInfo &info) {
+    return formatErrorInfo(info, s_verbose_errors);
+}
+
+std::string ErrorHandler::formatErrorInfo(const PythonErrorInfo &info, bool verbose) {
     std::ostringstream oss;
 
     oss << "Python Error: " << info.type;
@@ -154,21 +405,21 @@ std::string ErrorHandler::formatErrorInfo(const PythonErrorInfo &info) {
         oss << " - " << info.message;
     }
 
-    if (s_verbose_errors) {
-        if (!info.file.empty()) {
-            oss << "\n  File: " << info.file;
-            if (info.line > 0) {
-                oss << ":" << info.line;
+    if (verbose) {
+        if (!info.file().empty()) {
+            oss << "\n  File: " << info.file();
+            if (info.line() > 0) {
+                oss << ":" << info.line();
             }
         }
 
-        if (!info.function.empty()) {
-            oss << "\n  Function: " << info.function;
+        if (!info.function().empty()) {
+            oss << "\n  Function: " << info.function();
         }
 
-        if (!info.traceback.empty()) {
+        if (!info.traceback().empty()) {
             oss << "\n  Traceback:\n"
-                << info.traceback;
+                << info.traceback();
         }
     }
 
@@ -180,22 +431,23 @@ void ErrorHandler::logError(const PythonErrorInfo &info) {
         return;
     }
 
-    // 获取当前时间
-    auto now = std::chrono::system_clock::now();
-    time_t time = std::chrono::system_clock::to_time_t(now);
-    std::tm tm_buf;
-
-#ifdef _WIN32
-    localtime_s(&tm_buf, &time);
-#else
-    localtime_r(&time, &tm_buf);
-#endif
+    auto sink = getLogSink();
+    if (!sink) {
+        return;
+    }
 
-    std::ostringstream log_stream;
-    log_stream << "[" << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S") << "] ";
-    log_stream << formatErrorInfo(info);
+    uint64_t suppressed = 0;
+    if (!g_rate_limiter.allow(info.type, suppressed)) {
+        return;
+    }
 
-    std::cerr << log_stream.str() << std::endl;
+    // 只记录事件，时间格式化和输出由日志目标完成
+    ErrorLogRecord record;
+    record.timestamp = std::chrono::system_clock::now();
+    record.info = info;
+    record.verbose = s_verbose_errors;
+    record.suppressed = suppressed;
+    sink->write(record);
 }
 
 void ErrorHandler::setVerboseErrors(bool verbose) {
@@ -206,21 +458,94 @@ void ErrorHandler::setErrorLogging(bool enable) {
     s_error_logging = enable;
 }
 
+void ErrorHandler::setLogSink(std::shared_ptr<ErrorLogSink> sink) {
+    g_log_sink_configured.store(true);
+    auto previous = std::atomic_exchange(&g_log_sink, std::move(sink));
+    if (previous) {
+        previous->flush();
+    }
+}
+
+std::shared_ptr<ErrorLogSink> ErrorHandler::getLogSink() {
+    if (!g_log_sink_configured.load(std::memory_order_acquire)) {
+        std::call_once(g_default_sink_once, [] {
+            auto stderr_sink = std::make_shared<StreamLogSink>(std::cerr, LogFormat::Text);
+            std::shared_ptr<ErrorLogSink> expected;
+            std::shared_ptr<ErrorLogSink> desired = std::make_shared<AsyncLogSink>(stderr_sink);
+            std::atomic_compare_exchange_strong(&g_log_sink, &expected, desired);
+        });
+    }
+    return std::atomic_load(&g_log_sink);
+}
+
+void ErrorHandler::setErrorRateLimit(uint32_t max_per_second) {
+    g_rate_limiter.setLimit(max_per_second);
+}
+
+void ErrorHandler::setAsyncCallbacks(bool enable) {
+    std::shared_ptr<ErrorLogSink> sink;
+    if (enable) {
+        auto runner = std::make_shared<FunctionLogSink>([](const ErrorLogRecord &record) {
+            triggerErrorCallbacks(record.info);
+        });
+        sink = std::make_shared<AsyncLogSink>(runner);
+    }
+    auto previous = std::atomic_exchange(&g_callback_sink, std::move(sink));
+    if (previous) {
+        previous->flush();
+    }
+}
+
+void ErrorHandler::flushErrorLog() {
+    if (auto callback_sink = std::atomic_load(&g_callback_sink)) {
+        callback_sink->flush();
+    }
+    if (auto sink = std::atomic_load(&g_log_sink)) {
+        sink->flush();
+    }
+}
+
+void ErrorHandler::resetInterpreterState() {
+    // 排空仍引用Python对象的日志记录和回调
+    flushErrorLog();
+
+    if (g_traceback_module && Py_IsInitialized()) {
+        Py_DECREF(g_traceback_module);
+    }
+    g_traceback_module = nullptr;
+    g_interpreter_epoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
 void ErrorHandler::triggerErrorCallbacks(const PythonErrorInfo &info) {
-    for (const auto &callback : s_error_callbacks) {
-        try {
-            callback(info);
-        } catch (...) {
-            // 忽略回调函数中的异常，避免无限递归
-            std::cerr << "Error in error callback function" << std::endl;
+    s_callback_readers.fetch_add(1, std::memory_order_seq_cst);
+    const CallbackList* list = s_error_callbacks.load(std::memory_order_seq_cst);
+    if (list) {
+        for (const auto &entry : *list) {
+            try {
+                entry.callback(info);
+            } catch (...) {
+                // 忽略回调函数中的异常，避免无限递归
+                std::cerr << "Error in error callback function" << std::endl;
+            }
         }
     }
+    s_callback_readers.fetch_sub(1, std::memory_order_release);
+}
+
+void ErrorHandler::dispatchErrorCallbacks(const PythonErrorInfo &info) {
+    if (auto callback_sink = std::atomic_load(&g_callback_sink)) {
+        ErrorLogRecord record;
+        record.timestamp = std::chrono::system_clock::now();
+        record.info = info;
+        callback_sink->write(record);
+        return;
+    }
+    triggerErrorCallbacks(info);
 }
 
 std::string ErrorHandler::parsePythonTraceback(const py::object &traceback_obj) {
     try {
-        py::module traceback_module = py::module::import("traceback");
-        py::object formatted = traceback_module.attr("format_tb")(traceback_obj);
+        py::object formatted = tracebackModule().attr("format_tb")(traceback_obj);
 
         std::ostringstream oss;
         for (const auto &line : formatted) {
@@ -235,16 +560,10 @@ std::string ErrorHandler::parsePythonTraceback(const py::object &traceback_obj)
 
 // ScopedErrorHandler 实现
 ScopedErrorHandler::ScopedErrorHandler(ErrorHandler::ErrorCallback callback)
-    : m_callback(callback) {
-    ErrorHandler::addErrorCallback(m_callback);
-    m_registered = true;
-}
+    : m_token(ErrorHandler::addErrorCallback(std::move(callback))) {}
 
 ScopedErrorHandler::~ScopedErrorHandler() {
-    if (m_registered) {
-        // Note: Simplified handling here, a more robust implementation
-        // might need to remove the specific callback from the list.
-    }
+    ErrorHandler::removeErrorCallback(m_token);
 }
 
 // ExceptionConverter static member initialization
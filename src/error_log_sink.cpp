@@ -0,0 +1,275 @@
+#include "error_log_sink.h"
+#include "python_bridge.h"
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+namespace cpppy_bridge {
+
+namespace {
+
+std::tm toLocalTime(std::chrono::system_clock::time_point timestamp) {
+    time_t time = std::chrono::system_clock::to_time_t(timestamp);
+    std::tm tm_buf;
+#ifdef _WIN32
+    localtime_s(&tm_buf, &time);
+#else
+    localtime_r(&time, &tm_buf);
+#endif
+    return tm_buf;
+}
+
+std::tm toUtcTime(std::chrono::system_clock::time_point timestamp) {
+    time_t time = std::chrono::system_clock::to_time_t(timestamp);
+    std::tm tm_buf;
+#ifdef _WIN32
+    gmtime_s(&tm_buf, &time);
+#else
+    gmtime_r(&time, &tm_buf);
+#endif
+    return tm_buf;
+}
+
+void appendJsonString(std::ostringstream& oss, const std::string& value) {
+    static const char* hex = "0123456789abcdef";
+    oss << '"';
+    for (unsigned char c : value) {
+        switch (c) {
+            case '"': oss << "\\\""; break;
+            case '\\': oss << "\\\\"; break;
+            case '\n': oss << "\\n"; break;
+            case '\r': oss << "\\r"; break;
+            case '\t': oss << "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    oss << "\\u00" << hex[c >> 4] << hex[c & 0xF];
+                } else {
+                    oss << c;
+                }
+        }
+    }
+    oss << '"';
+}
+
+} // namespace
+
+// ErrorLogSink 实现
+std::string ErrorLogSink::format(const ErrorLogRecord& record, LogFormat format) {
+    std::ostringstream oss;
+
+    if (format == LogFormat::Text) {
+        std::tm tm_buf = toLocalTime(record.timestamp);
+        oss << "[" << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S") << "] ";
+        oss << ErrorHandler::formatErrorInfo(record.info, record.verbose);
+        if (record.suppressed > 0) {
+            oss << "\n  (" << record.suppressed << " similar errors suppressed)";
+        }
+        return oss.str();
+    }
+
+    // 时间戳使用 UTC 并精确到毫秒
+    std::tm tm_buf = toUtcTime(record.timestamp);
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        record.timestamp.time_since_epoch()).count() % 1000;
+
+    oss << "{\"ts\":\"" << std::put_time(&tm_buf, "%Y-%m-%dT%H:%M:%S")
+        << '.' << std::setfill('0') << std::setw(3) << millis << "Z\"";
+    oss << ",\"type\":";
+    appendJsonString(oss, record.info.type);
+    oss << ",\"message\":";
+    appendJsonString(oss, record.info.message);
+    if (record.verbose) {
+        oss << ",\"file\":";
+        appendJsonString(oss, record.info.file());
+        oss << ",\"line\":" << record.info.line();
+        oss << ",\"function\":";
+        appendJsonString(oss, record.info.function());
+        oss << ",\"traceback\":";
+        appendJsonString(oss, record.info.traceback());
+    }
+    oss << ",\"suppressed\":" << record.suppressed << "}";
+    return oss.str();
+}
+
+// StreamLogSink 实现
+StreamLogSink::StreamLogSink(std::ostream& stream, LogFormat format)
+    : m_stream(&stream), m_format(format) {}
+
+StreamLogSink::StreamLogSink(const std::string& path, LogFormat format)
+    : m_file(std::make_unique<std::ofstream>(path, std::ios::app)), m_stream(m_file.get()), m_format(format) {
+    if (!*m_file) {
+        throw std::runtime_error("Failed to open error log file: " + path);
+    }
+}
+
+void StreamLogSink::write(const ErrorLogRecord& record) {
+    std::string line = ErrorLogSink::format(record, m_format);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    *m_stream << line << '\n';
+}
+
+void StreamLogSink::flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stream->flush();
+}
+
+// FunctionLogSink 实现
+FunctionLogSink::FunctionLogSink(std::function<void(const ErrorLogRecord&)> function)
+    : m_function(std::move(function)) {}
+
+void FunctionLogSink::write(const ErrorLogRecord& record) {
+    m_function(record);
+}
+
+// AsyncLogSink 实现
+AsyncLogSink::AsyncLogSink(std::shared_ptr<ErrorLogSink> target, size_t capacity)
+    : m_target(std::move(target)), m_ring(capacity > 0 ? capacity : 1) {
+    if (!m_target) {
+        throw std::invalid_argument("AsyncLogSink requires a target sink");
+    }
+    m_thread = std::thread(&AsyncLogSink::run, this);
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping.store(true);
+    }
+    m_wakeup.notify_one();
+
+    // 后台线程本身不接触 Python，但目标（如错误回调）可能需要GIL
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void AsyncLogSink::write(const ErrorLogRecord& record) {
+    // 先占到槽位再复制记录，环满时被丢弃的记录不承担任何格式化开销
+    const bool queued = m_ring.tryEmplace([&record](ErrorLogRecord& copy) {
+        copy.timestamp = record.timestamp;
+        copy.verbose = record.verbose;
+        copy.suppressed = record.suppressed;
+        if (record.verbose) {
+            // 在生产线程上（通常已持有GIL）格式化堆栈跟踪并释放其引用，后台线程不再接触 Python
+            record.info.traceback();
+            copy.info = record.info;
+        } else {
+            // 不需要位置信息时只保留类型和消息，避免后台线程释放堆栈跟踪引用
+            copy.info.type = record.info.type;
+            copy.info.message = record.info.message;
+        }
+    });
+    if (!queued) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_enqueued.fetch_add(1, std::memory_order_seq_cst);
+
+    // 只在消费线程休眠时才需要加锁唤醒
+    if (m_sleeping.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wakeup.notify_one();
+    }
+}
+
+void AsyncLogSink::flush() {
+    if (std::this_thread::get_id() == m_thread.get_id()) {
+        return;
+    }
+
+    const uint64_t target = m_enqueued.load(std::memory_order_seq_cst);
+    {
+        std::optional<py::gil_scoped_release> release;
+        if (PythonInterpreter::holdsGIL()) {
+            release.emplace();
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeup.notify_one();
+        m_drained.wait(lock, [this, target] {
+            return m_processed.load(std::memory_order_acquire) >= target;
+        });
+    }
+    m_target->flush();
+}
+
+uint64_t AsyncLogSink::droppedRecords() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+void AsyncLogSink::run() {
+    ErrorLogRecord record;
+    for (;;) {
+        while (m_ring.tryPop(record)) {
+            try {
+                m_target->write(record);
+            } catch (...) {
+                std::cerr << "Error in error log sink" << std::endl;
+            }
+            record = ErrorLogRecord{};
+            m_processed.fetch_add(1, std::memory_order_release);
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_drained.notify_all();
+        if (m_stopping.load()) {
+            if (m_processed.load() >= m_enqueued.load()) {
+                break;
+            }
+            continue;
+        }
+
+        // 先声明休眠再检查计数，配合生产者的检查避免丢失唤醒；超时作为兜底
+        m_sleeping.store(true, std::memory_order_seq_cst);
+        if (m_processed.load(std::memory_order_seq_cst) >= m_enqueued.load(std::memory_order_seq_cst)) {
+            m_wakeup.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        m_sleeping.store(false, std::memory_order_seq_cst);
+    }
+}
+
+// ErrorRateLimiter 实现
+ErrorRateLimiter::ErrorRateLimiter(uint32_t max_per_second)
+    : m_limit(max_per_second) {}
+
+void ErrorRateLimiter::setLimit(uint32_t max_per_second) {
+    m_limit.store(max_per_second, std::memory_order_relaxed);
+}
+
+uint32_t ErrorRateLimiter::limit() const {
+    return m_limit.load(std::memory_order_relaxed);
+}
+
+bool ErrorRateLimiter::allow(const std::string& type, uint64_t& suppressed) {
+    suppressed = 0;
+    const uint32_t limit = m_limit.load(std::memory_order_relaxed);
+    if (limit == 0) {
+        return true;
+    }
+
+    Bucket& bucket = m_buckets[std::hash<std::string>{}(type) % kBuckets];
+    const int64_t window = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // 进入新的一秒窗口时由一个线程重置计数
+    int64_t current = bucket.window.load(std::memory_order_acquire);
+    if (current != window && bucket.window.compare_exchange_strong(current, window, std::memory_order_acq_rel)) {
+        bucket.count.store(0, std::memory_order_release);
+    }
+
+    if (bucket.count.fetch_add(1, std::memory_order_acq_rel) < limit) {
+        suppressed = bucket.suppressed.exchange(0, std::memory_order_acq_rel);
+        return true;
+    }
+    bucket.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+} // namespace cpppy_bridge
@@ -0,0 +1,265 @@
+#include "interpreter_pool.h"
+#include <iostream>
+#include <stdexcept>
+
+#if PY_VERSION_HEX >= 0x030C0000
+#define CPPPY_HAS_PER_INTERPRETER_GIL 1
+#else
+#define CPPPY_HAS_PER_INTERPRETER_GIL 0
+#endif
+
+namespace cpppy_bridge {
+
+namespace {
+
+// 为当前解释器配置模块搜索路径
+void configureSysPath(const std::vector<std::string>& module_paths) {
+    py::module sys = py::module::import("sys");
+    py::list sys_path = sys.attr("path");
+    sys_path.append(".");
+    for (const auto& path : module_paths) {
+        py::str entry(path);
+        if (!sys_path.contains(entry)) {
+            sys_path.append(entry);
+        }
+    }
+}
+
+} // namespace
+
+// InterpreterPool 实现
+InterpreterPool::InterpreterPool(size_t num_interpreters, const std::vector<std::string>& module_paths)
+    : m_module_paths(module_paths) {
+
+    auto& interpreter = PythonInterpreter::getInstance();
+    if (!interpreter.isInitialized()) {
+        throw PythonInterpreterException("InterpreterPool requires an initialized interpreter");
+    }
+    if (!PythonInterpreter::holdsGIL()) {
+        throw PythonInterpreterException("InterpreterPool must be created while holding the GIL");
+    }
+
+    if (num_interpreters == 0) {
+        num_interpreters = 1;
+    }
+
+#if CPPPY_HAS_PER_INTERPRETER_GIL
+    m_sub_interpreters = true;
+    PyThreadState* main_tstate = PyThreadState_Get();
+
+    // 预留容量使登记槽位不会抛出：任何已创建的子解释器都在 m_slots 中，失败时可统一销毁
+    m_slots.reserve(num_interpreters);
+    try {
+        for (size_t i = 0; i < num_interpreters; ++i) {
+            PyInterpreterConfig config = {};
+            config.use_main_obmalloc = 0;
+            config.allow_fork = 0;
+            config.allow_exec = 0;
+            config.allow_threads = 1;
+            config.allow_daemon_threads = 0;
+            config.check_multi_interp_extensions = 1;
+            config.gil = PyInterpreterConfig_OWN_GIL;
+
+            auto slot = std::make_unique<Slot>();
+
+            // 成功后新解释器的线程状态成为当前状态，主解释器的GIL被释放
+            PyThreadState* sub_tstate = nullptr;
+            PyStatus status = Py_NewInterpreterFromConfig(&sub_tstate, &config);
+            if (PyStatus_Exception(status) || sub_tstate == nullptr) {
+                PyThreadState_Swap(main_tstate);
+                throw PythonInterpreterException(std::string("Failed to create sub-interpreter: ") +
+                                                 (status.err_msg ? status.err_msg : "unknown error"));
+            }
+
+            slot->interp = PyThreadState_GetInterpreter(sub_tstate);
+            slot->home_tstate = sub_tstate;
+            m_slots.push_back(std::move(slot));
+
+            try {
+                configureSysPath(m_module_paths);
+            } catch (const py::error_already_set& e) {
+                std::cerr << "Failed to configure sys.path for sub-interpreter " << i << ": " << e.what() << std::endl;
+            }
+
+            PyEval_SaveThread();
+            PyEval_RestoreThread(main_tstate);
+        }
+    } catch (...) {
+        // 析构函数不会运行：回到主解释器后销毁已创建的子解释器
+        if (PyThreadState_Get() != main_tstate) {
+            PyEval_SaveThread();
+            PyEval_RestoreThread(main_tstate);
+        }
+        endSubInterpreters();
+        throw;
+    }
+
+    std::cout << "InterpreterPool started " << m_slots.size() << " sub-interpreters." << std::endl;
+#else
+    // 回退模式：单个槽位，直接使用主解释器
+    m_sub_interpreters = false;
+    m_slots.push_back(std::make_unique<Slot>());
+    for (const auto& path : m_module_paths) {
+        interpreter.addModulePath(path);
+    }
+
+    std::cout << "InterpreterPool: per-interpreter GIL unavailable, using the main interpreter." << std::endl;
+#endif
+}
+
+InterpreterPool::~InterpreterPool() {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_slot_available.wait(lock, [this] {
+            for (const auto& slot : m_slots) {
+                if (slot->busy) {
+                    return false;
+                }
+            }
+            return true;
+        });
+    }
+
+    if (!Py_IsInitialized()) {
+        return;
+    }
+
+    if (!m_sub_interpreters) {
+        PyGILState_STATE state = PyGILState_Ensure();
+        m_slots.front()->modules.clear();
+        PyGILState_Release(state);
+        return;
+    }
+
+    endSubInterpreters();
+}
+
+void InterpreterPool::endSubInterpreters() {
+#if CPPPY_HAS_PER_INTERPRETER_GIL
+    PyThreadState* saved_tstate = PythonInterpreter::holdsGIL() ? PyEval_SaveThread() : nullptr;
+
+    for (auto& slot : m_slots) {
+        if (!slot->home_tstate) {
+            continue;
+        }
+        PyEval_RestoreThread(slot->home_tstate);
+        slot->modules.clear();
+        Py_EndInterpreter(slot->home_tstate);
+        slot->home_tstate = nullptr;
+        slot->interp = nullptr;
+    }
+
+    if (saved_tstate) {
+        PyEval_RestoreThread(saved_tstate);
+    }
+#endif
+}
+
+bool InterpreterPool::subInterpretersSupported() {
+    return CPPPY_HAS_PER_INTERPRETER_GIL != 0;
+}
+
+bool InterpreterPool::usesSubInterpreters() const {
+    return m_sub_interpreters;
+}
+
+size_t InterpreterPool::size() const {
+    return m_slots.size();
+}
+
+std::vector<InterpreterStats> InterpreterPool::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<InterpreterStats> stats;
+    stats.reserve(m_slots.size());
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        const Slot& slot = *m_slots[i];
+        InterpreterStats entry;
+        entry.index = i;
+        entry.own_gil = m_sub_interpreters;
+        entry.busy = slot.busy;
+        entry.calls = slot.calls.load(std::memory_order_relaxed);
+        entry.busy_time_us = slot.busy_time_us.load(std::memory_order_relaxed);
+        entry.cached_modules = slot.cached_modules.load(std::memory_order_relaxed);
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+InterpreterPool::Slot& InterpreterPool::acquireSlot() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        // 从上次位置开始轮询，使负载均匀分布到各个解释器
+        for (size_t offset = 0; offset < m_slots.size(); ++offset) {
+            size_t index = (m_next_slot + offset) % m_slots.size();
+            Slot& slot = *m_slots[index];
+            if (!slot.busy) {
+                slot.busy = true;
+                m_next_slot = index + 1;
+                return slot;
+            }
+        }
+        m_slot_available.wait(lock);
+    }
+}
+
+void InterpreterPool::releaseSlot(Slot& slot) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        slot.busy = false;
+    }
+    m_slot_available.notify_all();
+}
+
+// InterpreterPool::Lease 实现
+InterpreterPool::Lease::Lease(InterpreterPool& pool)
+    : m_pool(pool), m_slot(pool.acquireSlot()), m_start(std::chrono::steady_clock::now()) {
+
+    if (!m_pool.m_sub_interpreters) {
+        m_gil_state = PyGILState_Ensure();
+        return;
+    }
+
+    // 调用方若持有其他解释器的GIL，先将其释放
+    if (PythonInterpreter::holdsGIL()) {
+        m_saved_tstate = PyEval_SaveThread();
+    }
+    m_tstate = PyThreadState_New(m_slot.interp);
+    PyEval_RestoreThread(m_tstate);
+}
+
+InterpreterPool::Lease::~Lease() {
+    if (!m_pool.m_sub_interpreters) {
+        PyGILState_Release(m_gil_state);
+    } else {
+        PyThreadState_Clear(m_tstate);
+        PyThreadState_DeleteCurrent();
+        if (m_saved_tstate) {
+            PyEval_RestoreThread(m_saved_tstate);
+        }
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - m_start;
+    m_slot.calls.fetch_add(1, std::memory_order_relaxed);
+    m_slot.busy_time_us.fetch_add(
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()),
+        std::memory_order_relaxed);
+    m_pool.releaseSlot(m_slot);
+}
+
+std::shared_ptr<PythonModule> InterpreterPool::Lease::loadModule(const std::string& module_name) {
+    auto it = m_slot.modules.find(module_name);
+    if (it != m_slot.modules.end()) {
+        return it->second;
+    }
+
+    auto module = std::make_shared<PythonModule>(module_name);
+    if (!module->isLoaded()) {
+        throw PythonModuleException(module_name, "Failed to load module in interpreter pool");
+    }
+    m_slot.modules.emplace(module_name, module);
+    m_slot.cached_modules.store(m_slot.modules.size(), std::memory_order_relaxed);
+    return module;
+}
+
+} // namespace cpppy_bridge
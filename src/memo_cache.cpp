@@ -0,0 +1,172 @@
+#include "memo_cache.h"
+#include <algorithm>
+#include <functional>
+
+namespace cpppy_bridge {
+
+// MemoCache 实现
+std::atomic<size_t> MemoCache::s_live_caches{0};
+std::atomic<size_t> MemoCache::s_total_entries{0};
+std::atomic<size_t> MemoCache::s_total_bytes{0};
+
+MemoCache::MemoCache(const MemoCachePolicy& policy) : m_policy(policy) {
+    s_live_caches.fetch_add(1, std::memory_order_relaxed);
+    m_policy.shards = std::max<size_t>(m_policy.shards, 1);
+    m_shard_entries = std::max<size_t>(m_policy.max_entries / m_policy.shards, 1);
+    m_shard_bytes = std::max<size_t>(m_policy.max_bytes / m_policy.shards, 1);
+    for (size_t i = 0; i < m_policy.shards; ++i) {
+        m_shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+MemoCache::~MemoCache() {
+    s_total_entries.fetch_sub(m_entries.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    s_total_bytes.fetch_sub(m_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    s_live_caches.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemoCache::Shard& MemoCache::shardFor(std::string_view key) {
+    return *m_shards[std::hash<std::string_view>{}(key) % m_shards.size()];
+}
+
+void MemoCache::erase(Shard& shard, EntryList::iterator it) {
+    shard.bytes -= it->bytes;
+    m_bytes.fetch_sub(it->bytes, std::memory_order_relaxed);
+    m_entries.fetch_sub(1, std::memory_order_relaxed);
+    s_total_bytes.fetch_sub(it->bytes, std::memory_order_relaxed);
+    s_total_entries.fetch_sub(1, std::memory_order_relaxed);
+    shard.index.erase(it->key);
+    shard.entries.erase(it);
+}
+
+bool MemoCache::syncGeneration(uint64_t generation) {
+    const uint64_t current = m_generation.load(std::memory_order_acquire);
+    if (generation == current) {
+        return true;
+    }
+    if (generation < current) {
+        // 调用开始后模块已重新加载，结果已过时
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_generation_mutex);
+    if (generation <= m_generation.load(std::memory_order_relaxed)) {
+        return generation == m_generation.load(std::memory_order_relaxed);
+    }
+    // 先公开新版本再清空：并发写入在分片锁内检查版本，旧结果要么被拒绝，要么随后被清除
+    const bool had_entries = m_entries.load(std::memory_order_relaxed) > 0;
+    m_generation.store(generation, std::memory_order_release);
+    clear();
+    if (had_entries) {
+        m_invalidations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+std::shared_ptr<const void> MemoCache::lookup(const std::string& key, std::type_index type, uint64_t generation) {
+    if (!syncGeneration(generation)) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end() || it->second->type != type) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // 版本更新后、清空完成前仍可能遇到旧条目
+    if (it->second->generation != generation) {
+        erase(shard, it->second);
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    if (m_policy.ttl.count() > 0 && Clock::now() - it->second->stored > m_policy.ttl) {
+        erase(shard, it->second);
+        m_expirations.fetch_add(1, std::memory_order_relaxed);
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // 移到链表头部，标记为最近使用
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return it->second->value;
+}
+
+void MemoCache::store(std::string key, std::type_index type, std::shared_ptr<const void> value, size_t bytes,
+                      uint64_t generation) {
+    if (bytes > m_shard_bytes || !syncGeneration(generation)) {
+        return;
+    }
+
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // 调用期间模块可能已重新加载，在分片锁内再次确认版本
+    if (m_generation.load(std::memory_order_acquire) != generation) {
+        return;
+    }
+
+    auto existing = shard.index.find(key);
+    if (existing != shard.index.end()) {
+        erase(shard, existing->second);
+    }
+
+    // 按条目数和字节数淘汰最近最少使用的条目
+    while (!shard.entries.empty() &&
+           (shard.entries.size() >= m_shard_entries || shard.bytes + bytes > m_shard_bytes)) {
+        erase(shard, std::prev(shard.entries.end()));
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.entries.push_front(Entry{std::move(key), type, std::move(value), bytes, Clock::now(), generation});
+    shard.index.emplace(shard.entries.front().key, shard.entries.begin());
+    shard.bytes += bytes;
+    m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    m_entries.fetch_add(1, std::memory_order_relaxed);
+    s_total_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    s_total_entries.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoCache::clear() {
+    for (auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        while (!shard->entries.empty()) {
+            erase(*shard, std::prev(shard->entries.end()));
+        }
+    }
+}
+
+MemoCacheStats MemoCache::getStats() const {
+    MemoCacheStats stats;
+    stats.hits = m_hits.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    stats.evictions = m_evictions.load(std::memory_order_relaxed);
+    stats.expirations = m_expirations.load(std::memory_order_relaxed);
+    stats.invalidations = m_invalidations.load(std::memory_order_relaxed);
+    stats.entries = m_entries.load(std::memory_order_relaxed);
+    stats.bytes = m_bytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const MemoCachePolicy& MemoCache::getPolicy() const {
+    return m_policy;
+}
+
+size_t MemoCache::liveCaches() {
+    return s_live_caches.load(std::memory_order_relaxed);
+}
+
+size_t MemoCache::totalEntries() {
+    return s_total_entries.load(std::memory_order_relaxed);
+}
+
+size_t MemoCache::totalBytes() {
+    return s_total_bytes.load(std::memory_order_relaxed);
+}
+
+} // namespace cpppy_bridge
@@ -0,0 +1,418 @@
+#include "numpy_kernels.h"
+#include "python_bridge.h"
+#include "type_converter.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CPPPY_X86_DISPATCH 1
+#else
+#define CPPPY_X86_DISPATCH 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CPPPY_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define CPPPY_ALWAYS_INLINE inline
+#endif
+
+namespace cpppy_bridge {
+
+namespace {
+
+// 每个线程至少处理的元素数，避免线程启动开销超过计算本身
+constexpr size_t kMinChunk = 1 << 16;
+
+// 小数组释放 GIL 的开销高于计算本身
+constexpr size_t kMinReleaseElements = 1 << 14;
+
+// 独立累加器个数：足够填满两条 AVX-512 双精度向量，编译器据此向量化
+constexpr size_t kLanes = 16;
+
+struct Partial {
+    size_t count = 0;
+    double sum = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double m2 = 0.0;      // 相对本块均值的离差平方和
+    bool nan = false;
+};
+
+// 多累加器版本：各通道之间没有依赖，可在任意指令集下向量化
+template<typename T>
+CPPPY_ALWAYS_INLINE void reduceLanes(const T* data, size_t count, bool variance, Partial& out) {
+    double sum[kLanes] = {};
+    double lo[kLanes];
+    double hi[kLanes];
+    for (size_t l = 0; l < kLanes; ++l) {
+        lo[l] = std::numeric_limits<double>::infinity();
+        hi[l] = -std::numeric_limits<double>::infinity();
+    }
+
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            const double v = static_cast<double>(data[i + l]);
+            sum[l] += v;
+            lo[l] = v < lo[l] ? v : lo[l];
+            hi[l] = v > hi[l] ? v : hi[l];
+        }
+    }
+
+    double total = 0.0;
+    double low = std::numeric_limits<double>::infinity();
+    double high = -std::numeric_limits<double>::infinity();
+    for (size_t l = 0; l < kLanes; ++l) {
+        total += sum[l];
+        low = std::min(low, lo[l]);
+        high = std::max(high, hi[l]);
+    }
+    for (; i < count; ++i) {
+        const double v = static_cast<double>(data[i]);
+        total += v;
+        low = v < low ? v : low;
+        high = v > high ? v : high;
+    }
+
+    out.count = count;
+    out.sum = total;
+    out.min = low;
+    out.max = high;
+    out.m2 = 0.0;
+    out.nan = false;
+
+    // 比较会跳过 NaN；总和为 NaN 时再确认是否含 NaN（inf - inf 也会得到 NaN）
+    if constexpr (std::is_floating_point_v<T>) {
+        if (std::isnan(total)) {
+            out.nan = std::any_of(data, data + count, [](T v) { return std::isnan(v); });
+            if (out.nan) {
+                return;
+            }
+        }
+    }
+
+    if (variance && count > 0) {
+        const double mean = total / static_cast<double>(count);
+        double sq[kLanes] = {};
+        size_t j = 0;
+        for (; j + kLanes <= count; j += kLanes) {
+            for (size_t l = 0; l < kLanes; ++l) {
+                const double d = static_cast<double>(data[j + l]) - mean;
+                sq[l] += d * d;
+            }
+        }
+        double m2 = 0.0;
+        for (size_t l = 0; l < kLanes; ++l) {
+            m2 += sq[l];
+        }
+        for (; j < count; ++j) {
+            const double d = static_cast<double>(data[j]) - mean;
+            m2 += d * d;
+        }
+        out.m2 = m2;
+    }
+}
+
+// 单累加器版本（SimdLevel::Scalar）
+template<typename T>
+void reduceScalar(const T* data, size_t count, bool variance, Partial& out) {
+    out = Partial();
+    out.count = count;
+    for (size_t i = 0; i < count; ++i) {
+        const double v = static_cast<double>(data[i]);
+        if constexpr (std::is_floating_point_v<T>) {
+            if (std::isnan(v)) {
+                out.nan = true;
+                return;
+            }
+        }
+        out.sum += v;
+        out.min = std::min(out.min, v);
+        out.max = std::max(out.max, v);
+    }
+    if (variance && count > 0) {
+        const double mean = out.sum / static_cast<double>(count);
+        for (size_t i = 0; i < count; ++i) {
+            const double d = static_cast<double>(data[i]) - mean;
+            out.m2 += d * d;
+        }
+    }
+}
+
+// 基线指令集（x86-64 上为 SSE2，AArch64 上为 NEON）
+template<typename T>
+void reduceBaseline(const T* data, size_t count, bool variance, Partial& out) {
+    reduceLanes(data, count, variance, out);
+}
+
+#if CPPPY_X86_DISPATCH
+template<typename T>
+__attribute__((target("avx2"))) void reduceAvx2(const T* data, size_t count, bool variance, Partial& out) {
+    reduceLanes(data, count, variance, out);
+}
+
+template<typename T>
+__attribute__((target("avx512f,avx512dq"))) void reduceAvx512(const T* data, size_t count, bool variance,
+                                                              Partial& out) {
+    reduceLanes(data, count, variance, out);
+}
+#endif
+
+template<typename T>
+using ReduceFn = void (*)(const T*, size_t, bool, Partial&);
+
+template<typename T>
+ReduceFn<T> kernelFor(SimdLevel level) {
+    switch (level) {
+#if CPPPY_X86_DISPATCH
+    case SimdLevel::AVX512:
+        return &reduceAvx512<T>;
+    case SimdLevel::AVX2:
+        return &reduceAvx2<T>;
+#endif
+    case SimdLevel::Scalar:
+        return &reduceScalar<T>;
+    default:
+        return &reduceBaseline<T>;
+    }
+}
+
+// 合并两块的统计量（Chan 等人的成对合并公式）
+void merge(Partial& into, const Partial& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (into.count == 0) {
+        into = other;
+        return;
+    }
+    const double n_a = static_cast<double>(into.count);
+    const double n_b = static_cast<double>(other.count);
+    const double delta = other.sum / n_b - into.sum / n_a;
+    into.m2 += other.m2 + delta * delta * n_a * n_b / (n_a + n_b);
+    into.sum += other.sum;
+    into.count += other.count;
+    into.min = std::min(into.min, other.min);
+    into.max = std::max(into.max, other.max);
+    into.nan = into.nan || other.nan;
+}
+
+template<typename T>
+Partial reduce(const T* data, size_t count, bool variance, const KernelOptions& options) {
+    const ReduceFn<T> kernel = kernelFor<T>(NumpyKernels::simdLevel());
+
+    size_t threads = 1;
+    if (options.parallel_threshold > 0 && count >= options.parallel_threshold) {
+        const size_t limit = options.max_threads
+            ? options.max_threads
+            : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        threads = std::clamp<size_t>(count / kMinChunk, 1, limit);
+    }
+
+    if (threads == 1) {
+        Partial result;
+        kernel(data, count, variance, result);
+        return result;
+    }
+
+    // 块大小按通道数对齐，调用线程处理第一块
+    const size_t chunk = ((count + threads - 1) / threads + kLanes - 1) / kLanes * kLanes;
+    std::vector<Partial> partials(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    try {
+        for (size_t t = 1; t < threads && t * chunk < count; ++t) {
+            const size_t begin = t * chunk;
+            workers.emplace_back(kernel, data + begin, std::min(chunk, count - begin), variance,
+                                 std::ref(partials[t]));
+        }
+    } catch (...) {
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        throw;
+    }
+    kernel(data, std::min(chunk, count), variance, partials[0]);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    Partial result;
+    for (const auto& partial : partials) {
+        merge(result, partial);
+    }
+    return result;
+}
+
+ArrayStats toStats(const Partial& partial) {
+    if (partial.count == 0) {
+        throw std::runtime_error("NumpyKernels: cannot compute statistics of an empty array");
+    }
+
+    ArrayStats stats;
+    stats.count = partial.count;
+    if (partial.nan) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        stats.sum = stats.mean = stats.stddev = stats.min = stats.max = nan;
+        return stats;
+    }
+    stats.sum = partial.sum;
+    stats.mean = partial.sum / static_cast<double>(partial.count);
+    stats.stddev = std::sqrt(partial.m2 / static_cast<double>(partial.count));
+    stats.min = partial.min;
+    stats.max = partial.max;
+    return stats;
+}
+
+template<typename T>
+Partial reduceArrayAs(const py::array& arr, bool variance, const KernelOptions& options) {
+    // 非连续数组先复制为 C 连续布局（dtype 已匹配，不会做类型转换）
+    auto contiguous = py::array_t<T, py::array::c_style>::ensure(arr);
+    if (!contiguous) {
+        throw std::runtime_error("NumpyKernels: cannot access array buffer");
+    }
+    const T* data = contiguous.data();
+    const size_t count = static_cast<size_t>(contiguous.size());
+
+    std::optional<py::gil_scoped_release> release;
+    if (options.release_gil && count >= kMinReleaseElements && PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+    return reduce(data, count, variance, options);
+}
+
+// 按 dtype 分派（比较 dtype 对象，不构造 getArrayDtype 的字符串）
+Partial reduceArray(const py::array& arr, bool variance, const KernelOptions& options) {
+    const py::dtype dtype = arr.dtype();
+    if (dtype.equal(py::dtype::of<double>())) {
+        return reduceArrayAs<double>(arr, variance, options);
+    }
+    if (dtype.equal(py::dtype::of<float>())) {
+        return reduceArrayAs<float>(arr, variance, options);
+    }
+    if (dtype.equal(py::dtype::of<int64_t>())) {
+        return reduceArrayAs<int64_t>(arr, variance, options);
+    }
+    if (dtype.equal(py::dtype::of<int32_t>())) {
+        return reduceArrayAs<int32_t>(arr, variance, options);
+    }
+    throw std::runtime_error("NumpyKernels: unsupported dtype " + NumpyConverter::getArrayDtype(arr));
+}
+
+SimdLevel detectSimdLevel() {
+#if CPPPY_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    return SimdLevel::SSE2;
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+std::atomic<SimdLevel>& activeLevel() {
+    static std::atomic<SimdLevel> level{NumpyKernels::detectedSimdLevel()};
+    return level;
+}
+
+} // namespace
+
+// NumpyKernels 实现
+ArrayStats NumpyKernels::stats(const py::array& arr, const KernelOptions& options) {
+    return toStats(reduceArray(arr, true, options));
+}
+
+double NumpyKernels::sum(const py::array& arr, const KernelOptions& options) {
+    const Partial partial = reduceArray(arr, false, options);
+    return partial.nan ? std::numeric_limits<double>::quiet_NaN() : partial.sum;
+}
+
+double NumpyKernels::mean(const py::array& arr, const KernelOptions& options) {
+    const Partial partial = reduceArray(arr, false, options);
+    if (partial.nan || partial.count == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return partial.sum / static_cast<double>(partial.count);
+}
+
+double NumpyKernels::min(const py::array& arr, const KernelOptions& options) {
+    return toStats(reduceArray(arr, false, options)).min;
+}
+
+double NumpyKernels::max(const py::array& arr, const KernelOptions& options) {
+    return toStats(reduceArray(arr, false, options)).max;
+}
+
+double NumpyKernels::stddev(const py::array& arr, const KernelOptions& options) {
+    const Partial partial = reduceArray(arr, true, options);
+    if (partial.nan || partial.count == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return std::sqrt(partial.m2 / static_cast<double>(partial.count));
+}
+
+ArrayStats NumpyKernels::stats(const float* data, size_t count, const KernelOptions& options) {
+    return toStats(reduce(data, count, true, options));
+}
+
+ArrayStats NumpyKernels::stats(const double* data, size_t count, const KernelOptions& options) {
+    return toStats(reduce(data, count, true, options));
+}
+
+ArrayStats NumpyKernels::stats(const int32_t* data, size_t count, const KernelOptions& options) {
+    return toStats(reduce(data, count, true, options));
+}
+
+ArrayStats NumpyKernels::stats(const int64_t* data, size_t count, const KernelOptions& options) {
+    return toStats(reduce(data, count, true, options));
+}
+
+SimdLevel NumpyKernels::detectedSimdLevel() {
+    static const SimdLevel detected = detectSimdLevel();
+    return detected;
+}
+
+SimdLevel NumpyKernels::simdLevel() {
+    return activeLevel().load(std::memory_order_relaxed);
+}
+
+void NumpyKernels::setSimdLevel(SimdLevel level) {
+    const SimdLevel detected = detectedSimdLevel();
+    bool supported = level == SimdLevel::Scalar || level == detected;
+    if (level != SimdLevel::NEON && detected != SimdLevel::NEON && detected != SimdLevel::Scalar) {
+        supported = supported || static_cast<int>(level) <= static_cast<int>(detected);
+    }
+    activeLevel().store(supported ? level : SimdLevel::Scalar, std::memory_order_relaxed);
+}
+
+const char* NumpyKernels::simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return "scalar";
+    case SimdLevel::SSE2:
+        return "sse2";
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::AVX512:
+        return "avx512";
+    case SimdLevel::NEON:
+        return "neon";
+    }
+    return "unknown";
+}
+
+} // namespace cpppy_bridge
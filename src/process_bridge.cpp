@@ -0,0 +1,1055 @@
+#include "process_bridge.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "python_bridge.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace cpppy_bridge {
+
+namespace {
+
+// 共享区域布局：请求环头、响应环头（计数器各占一个缓存行），随后是两个数据区
+constexpr size_t kCounterStride = 64;
+constexpr size_t kRingHeaderBytes = 2 * kCounterStride;
+constexpr size_t kRegionHeaderBytes = 2 * kRingHeaderBytes;
+constexpr auto kStartTimeout = std::chrono::seconds(30);
+constexpr auto kStopTimeout = std::chrono::seconds(2);
+constexpr auto kDispatchTimeout = std::chrono::seconds(10);
+
+struct FrameHeader {
+    uint32_t length;
+    uint32_t kind;
+    uint64_t id;
+};
+static_assert(sizeof(FrameHeader) == 16, "FrameHeader must match the worker's '=IIQ' header");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring counters must be lock-free");
+
+// 单生产者单消费者字节环，计数器单调递增
+struct RingView {
+    std::atomic<uint64_t>* head;
+    std::atomic<uint64_t>* tail;
+    char* data;
+    size_t capacity;
+
+    void copyIn(uint64_t pos, const void* src, size_t bytes) const {
+        const size_t start = static_cast<size_t>(pos % capacity);
+        const size_t first = std::min(bytes, capacity - start);
+        std::memcpy(data + start, src, first);
+        std::memcpy(data, static_cast<const char*>(src) + first, bytes - first);
+    }
+
+    void copyOut(uint64_t pos, void* dst, size_t bytes) const {
+        const size_t start = static_cast<size_t>(pos % capacity);
+        const size_t first = std::min(bytes, capacity - start);
+        std::memcpy(dst, data + start, first);
+        std::memcpy(static_cast<char*>(dst) + first, data, bytes - first);
+    }
+};
+
+RingView ringAt(void* region, size_t header_offset, size_t data_offset, size_t capacity) {
+    char* base = static_cast<char*>(region);
+    return RingView{reinterpret_cast<std::atomic<uint64_t>*>(base + header_offset),
+                    reinterpret_cast<std::atomic<uint64_t>*>(base + header_offset + kCounterStride),
+                    base + data_offset, capacity};
+}
+
+RingView requestRing(void* region, size_t capacity) {
+    return ringAt(region, 0, kRegionHeaderBytes, capacity);
+}
+
+RingView replyRing(void* region, size_t capacity) {
+    return ringAt(region, kRingHeaderBytes, kRegionHeaderBytes + capacity, capacity);
+}
+
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+std::string uniqueSegmentName(const char* kind) {
+    static std::atomic<uint64_t> counter{0};
+    return "/cpppy." + std::to_string(getpid()) + "." + kind + std::to_string(counter.fetch_add(1));
+}
+
+std::string describeExit(int status) {
+    if (WIFSIGNALED(status)) {
+        return "was killed by signal " + std::to_string(WTERMSIG(status));
+    }
+    if (WIFEXITED(status)) {
+        return "exited with status " + std::to_string(WEXITSTATUS(status));
+    }
+    return "exited";
+}
+
+// 按 PATH 解析解释器路径；fork 之后不能再做这类查找
+std::string resolveExecutable(const std::string& name) {
+    if (name.find('/') != std::string::npos) {
+        return name;
+    }
+    const char* path = std::getenv("PATH");
+    std::string directories = path ? path : "/usr/local/bin:/usr/bin:/bin";
+    size_t begin = 0;
+    while (begin <= directories.size()) {
+        size_t end = directories.find(':', begin);
+        if (end == std::string::npos) {
+            end = directories.size();
+        }
+        std::string directory = directories.substr(begin, end - begin);
+        std::string candidate = (directory.empty() ? std::string(".") : directory) + "/" + name;
+        if (access(candidate.c_str(), X_OK) == 0) {
+            return candidate;
+        }
+        begin = end + 1;
+    }
+    throw PythonInterpreterException("ProcessBridge worker interpreter '" + name + "' not found on PATH");
+}
+
+// 等待工作进程退出，超时后强制终止
+int waitForExit(pid_t pid) {
+    int status = 0;
+    const auto deadline = std::chrono::steady_clock::now() + kStopTimeout;
+    for (;;) {
+        pid_t result = waitpid(pid, &status, WNOHANG);
+        if (result == pid || (result < 0 && errno != EINTR)) {
+            return status;
+        }
+        if (std::chrono::steady_clock::now() > deadline) {
+            kill(pid, SIGKILL);
+            while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+            }
+            return status;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+// 工作进程脚本，通过 `python -c` 运行
+// argv: region_fd socket_fd ring_bytes module_paths...
+const char* kWorkerScript = R"PY(
+import importlib, mmap, socket, struct, sys, time
+from multiprocessing import shared_memory
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+LOAD, CALL, RESULT, ERROR = 1, 2, 3, 4
+HEADER = struct.Struct('=IIQ')
+COUNTER = struct.Struct('=Q')
+FORMATS = {('f', 4): 'f', ('f', 8): 'd', ('i', 1): 'b', ('i', 2): 'h', ('i', 4): 'i', ('i', 8): 'q',
+           ('u', 1): 'B', ('u', 2): 'H', ('u', 4): 'I', ('u', 8): 'Q'}
+lingering = []
+
+
+def segment(name=None, size=0):
+    # The bridge owns segment lifetimes, so keep the resource tracker out
+    try:
+        return shared_memory.SharedMemory(name=name, create=name is None, size=size, track=False)
+    except TypeError:
+        shm = shared_memory.SharedMemory(name=name, create=name is None, size=size)
+        from multiprocessing import resource_tracker
+        resource_tracker.unregister(shm._name, 'shared_memory')
+        return shm
+
+
+class Ring:
+    def __init__(self, buf, header, data, capacity):
+        self.buf, self.head_at, self.tail_at = buf, header, header + 64
+        self.data, self.capacity = data, capacity
+
+    def _load(self, at):
+        return COUNTER.unpack_from(self.buf, at)[0]
+
+    def _read(self, pos, n):
+        start = pos % self.capacity
+        first = min(n, self.capacity - start)
+        chunk = self.buf[self.data + start:self.data + start + first].tobytes()
+        if first < n:
+            chunk += self.buf[self.data:self.data + n - first].tobytes()
+        return chunk
+
+    def _write(self, pos, payload):
+        start = pos % self.capacity
+        first = min(len(payload), self.capacity - start)
+        self.buf[self.data + start:self.data + start + first] = payload[:first]
+        if first < len(payload):
+            self.buf[self.data:self.data + len(payload) - first] = payload[first:]
+
+    def pop(self):
+        tail = self._load(self.tail_at)
+        if tail == self._load(self.head_at):
+            return None
+        length, kind, call_id = HEADER.unpack(self._read(tail, HEADER.size))
+        body = self._read(tail + HEADER.size, length)
+        COUNTER.pack_into(self.buf, self.tail_at, tail + HEADER.size + length)
+        return kind, call_id, body
+
+    def push(self, kind, call_id, body):
+        need = HEADER.size + len(body)
+        if need > self.capacity:
+            raise ValueError('reply of %d bytes exceeds the ring capacity' % need)
+        head = self._load(self.head_at)
+        while self.capacity - (head - self._load(self.tail_at)) < need:
+            time.sleep(0.0001)
+        self._write(head, HEADER.pack(len(body), kind, call_id) + body)
+        COUNTER.pack_into(self.buf, self.head_at, head + need)
+
+
+def pack_str(raw):
+    return struct.pack('=I', len(raw)) + raw
+
+
+def read_str(body, pos):
+    (n,) = struct.unpack_from('=I', body, pos)
+    pos += 4
+    return body[pos:pos + n], pos + n
+
+
+def decode(body, pos, segments):
+    tag = body[pos]
+    pos += 1
+    if tag == 0:
+        return None, pos
+    if tag == 1:
+        return body[pos] != 0, pos + 1
+    if tag == 2:
+        return struct.unpack_from('=q', body, pos)[0], pos + 8
+    if tag == 3:
+        return struct.unpack_from('=d', body, pos)[0], pos + 8
+    if tag == 4:
+        raw, pos = read_str(body, pos)
+        return raw.decode(), pos
+    if tag == 5:
+        return read_str(body, pos)
+    if tag == 6:
+        (n,) = struct.unpack_from('=I', body, pos)
+        pos += 4
+        items = []
+        for _ in range(n):
+            item, pos = decode(body, pos, segments)
+            items.append(item)
+        return items, pos
+    if tag == 7:
+        fmt, ndim = chr(body[pos]), body[pos + 1]
+        pos += 2
+        shape = struct.unpack_from('=%dq' % ndim, body, pos)
+        pos += 8 * ndim
+        name, pos = read_str(body, pos)
+        (nbytes,) = struct.unpack_from('=Q', body, pos)
+        pos += 8
+        shm = segment(name.decode().lstrip('/'))
+        segments.append(shm)
+        if numpy is not None:
+            return numpy.ndarray(shape, dtype=fmt, buffer=shm.buf), pos
+        return shm.buf[:nbytes].cast(fmt, shape), pos
+    raise ValueError('unknown wire tag %d' % tag)
+
+
+def encode_array(out, value, created):
+    key = (value.dtype.kind, value.dtype.itemsize)
+    if key not in FORMATS:
+        raise TypeError('cannot send arrays of dtype %s to the bridge' % value.dtype)
+    shm = segment(size=max(value.nbytes, 1))
+    created.append(shm.name)
+    numpy.ndarray(value.shape, dtype=value.dtype.newbyteorder('='), buffer=shm.buf)[...] = value
+    shm.close()
+    out += struct.pack('=BBB', 7, ord(FORMATS[key]), value.ndim)
+    out += struct.pack('=%dq' % value.ndim, *value.shape)
+    out += pack_str(('/' + shm.name).encode())
+    out += struct.pack('=Q', value.nbytes)
+
+
+def encode(out, value, created):
+    if value is None:
+        out += b'\x00'
+    elif numpy is not None and isinstance(value, numpy.ndarray):
+        encode_array(out, value, created)
+    elif numpy is not None and isinstance(value, numpy.generic):
+        encode(out, value.item(), created)
+    elif isinstance(value, bool):
+        out += struct.pack('=BB', 1, value)
+    elif isinstance(value, int):
+        out += struct.pack('=Bq', 2, value)
+    elif isinstance(value, float):
+        out += struct.pack('=Bd', 3, value)
+    elif isinstance(value, str):
+        out += b'\x04' + pack_str(value.encode())
+    elif isinstance(value, (bytes, bytearray, memoryview)):
+        out += b'\x05' + pack_str(bytes(value))
+    elif isinstance(value, (list, tuple)):
+        out += struct.pack('=BI', 6, len(value))
+        for item in value:
+            encode(out, item, created)
+    else:
+        raise TypeError('cannot send %s to the bridge' % type(value).__name__)
+
+
+def release(segments):
+    # Arrays the callee kept alive pin their segment until they are dropped
+    pending = lingering + segments
+    del lingering[:]
+    for shm in pending:
+        try:
+            shm.close()
+        except BufferError:
+            lingering.append(shm)
+
+
+def failure(error):
+    return ERROR, pack_str(type(error).__name__.encode()) + pack_str(str(error).encode())
+
+
+def handle(kind, body, modules):
+    segments, created = [], []
+    arg = args = result = None
+    try:
+        name, pos = read_str(body, 0)
+        name = name.decode()
+        module = modules.get(name)
+        if module is None:
+            module = modules[name] = importlib.import_module(name)
+        if kind == LOAD:
+            return RESULT, b'\x00'
+        func, pos = read_str(body, pos)
+        (argc,) = struct.unpack_from('=I', body, pos)
+        pos += 4
+        args = []
+        for _ in range(argc):
+            arg, pos = decode(body, pos, segments)
+            args.append(arg)
+        result = getattr(module, func.decode())(*args)
+        out = bytearray()
+        encode(out, result, created)
+        return RESULT, bytes(out)
+    except Exception as error:
+        for name in created:
+            try:
+                segment(name).unlink()
+            except OSError:
+                pass
+        return failure(error)
+    finally:
+        arg = args = result = None
+        release(segments)
+
+
+def main():
+    region_fd, sock_fd, capacity = int(sys.argv[1]), int(sys.argv[2]), int(sys.argv[3])
+    for path in ['.'] + sys.argv[4:]:
+        if path not in sys.path:
+            sys.path.append(path)
+
+    buf = memoryview(mmap.mmap(region_fd, 256 + 2 * capacity))
+    requests = Ring(buf, 0, 256, capacity)
+    replies = Ring(buf, 128, 256 + capacity, capacity)
+    wake = socket.socket(fileno=sock_fd)
+    modules = {}
+
+    wake.send(b'\x00')
+    while wake.recv(4096):
+        message = requests.pop()
+        while message is not None:
+            kind, call_id, body = message
+            reply_kind, payload = handle(kind, body, modules)
+            try:
+                replies.push(reply_kind, call_id, payload)
+            except ValueError as error:
+                reply_kind, payload = failure(error)
+                replies.push(reply_kind, call_id, payload)
+            wake.send(b'\x01')
+            message = requests.pop()
+
+
+main()
+)PY";
+
+} // namespace
+
+// SharedSegment 实现
+SharedSegment::~SharedSegment() {
+    reset();
+}
+
+SharedSegment::SharedSegment(SharedSegment&& other) noexcept
+    : m_name(std::move(other.m_name)), m_data(other.m_data), m_size(other.m_size),
+      m_mapped(other.m_mapped), m_owner(other.m_owner) {
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_mapped = 0;
+    other.m_owner = false;
+}
+
+SharedSegment& SharedSegment::operator=(SharedSegment&& other) noexcept {
+    if (this != &other) {
+        reset();
+        m_name = std::move(other.m_name);
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_mapped = other.m_mapped;
+        m_owner = other.m_owner;
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_mapped = 0;
+        other.m_owner = false;
+    }
+    return *this;
+}
+
+void SharedSegment::reset() {
+    if (m_data) {
+        munmap(m_data, m_mapped);
+        m_data = nullptr;
+    }
+    if (m_owner) {
+        shm_unlink(m_name.c_str());
+        m_owner = false;
+    }
+    m_size = 0;
+    m_mapped = 0;
+}
+
+SharedSegment SharedSegment::create(size_t bytes) {
+    SharedSegment segment;
+    segment.m_name = uniqueSegmentName("s");
+    segment.m_size = bytes;
+    segment.m_mapped = std::max<size_t>(bytes, 1);
+
+    int fd = shm_open(segment.m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw systemError("shm_open failed for " + segment.m_name);
+    }
+    segment.m_owner = true;
+
+    if (ftruncate(fd, static_cast<off_t>(segment.m_mapped)) != 0) {
+        auto error = systemError("ftruncate failed for " + segment.m_name);
+        close(fd);
+        throw error;
+    }
+    void* data = mmap(nullptr, segment.m_mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw systemError("mmap failed for " + segment.m_name);
+    }
+    segment.m_data = data;
+    return segment;
+}
+
+SharedSegment SharedSegment::attach(const std::string& name, size_t bytes, bool take_ownership) {
+    SharedSegment segment;
+    segment.m_name = name;
+    segment.m_size = bytes;
+    segment.m_mapped = std::max<size_t>(bytes, 1);
+
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        throw systemError("shm_open failed for " + name);
+    }
+    // 取得所有权后立即删除名字，映射在析构前一直有效
+    if (take_ownership) {
+        shm_unlink(name.c_str());
+    }
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < segment.m_mapped) {
+        close(fd);
+        throw std::runtime_error("Shared memory segment " + name + " is smaller than expected");
+    }
+    void* data = mmap(nullptr, segment.m_mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw systemError("mmap failed for " + name);
+    }
+    segment.m_data = data;
+    return segment;
+}
+
+namespace detail {
+
+// 线路格式实现
+void WireWriter::putString(std::string_view text) {
+    put<uint32_t>(static_cast<uint32_t>(text.size()));
+    m_bytes.insert(m_bytes.end(), text.begin(), text.end());
+}
+
+const char* WireReader::take(size_t bytes) {
+    if (bytes > m_bytes.size() - m_offset) {
+        throw std::runtime_error("Truncated message from ProcessBridge worker");
+    }
+    const char* data = m_bytes.data() + m_offset;
+    m_offset += bytes;
+    return data;
+}
+
+std::string WireReader::getString() {
+    const uint32_t length = get<uint32_t>();
+    const char* data = take(length);
+    return std::string(data, length);
+}
+
+void encodeArray(WireWriter& out, char format, const std::vector<int64_t>& shape, const SharedSegment& segment) {
+    out.put<uint8_t>(static_cast<uint8_t>(format));
+    out.put<uint8_t>(static_cast<uint8_t>(shape.size()));
+    for (int64_t dim : shape) {
+        out.put<int64_t>(dim);
+    }
+    out.putString(segment.name());
+    out.put<uint64_t>(segment.size());
+}
+
+namespace {
+
+// 按流顺序遍历一个值，接管其中所有数组段
+void claimValue(WireReader& in, std::vector<SharedSegment>& segments, std::vector<std::string>& errors) {
+    switch (in.getTag()) {
+    case WireTag::None:
+        break;
+    case WireTag::Bool:
+        in.get<uint8_t>();
+        break;
+    case WireTag::Int:
+        in.get<int64_t>();
+        break;
+    case WireTag::Float:
+        in.get<double>();
+        break;
+    case WireTag::Str:
+    case WireTag::Bytes:
+        in.take(in.get<uint32_t>());
+        break;
+    case WireTag::List: {
+        const uint32_t count = in.get<uint32_t>();
+        for (uint32_t i = 0; i < count; ++i) {
+            claimValue(in, segments, errors);
+        }
+        break;
+    }
+    case WireTag::Array: {
+        in.get<uint8_t>();
+        const uint8_t ndim = in.get<uint8_t>();
+        for (uint8_t i = 0; i < ndim; ++i) {
+            in.get<int64_t>();
+        }
+        const std::string name = in.getString();
+        const uint64_t bytes = in.get<uint64_t>();
+        // 某个段无法映射时继续接管其余的段，错误留到解码时报告
+        try {
+            segments.push_back(SharedSegment::attach(name, static_cast<size_t>(bytes), true));
+            errors.emplace_back();
+        } catch (const std::exception& e) {
+            shm_unlink(name.c_str());
+            segments.emplace_back();
+            errors.emplace_back(e.what());
+        }
+        break;
+    }
+    default:
+        throw std::runtime_error("Unknown tag in worker reply");
+    }
+}
+
+} // namespace
+
+ReplyArrays::ReplyArrays(const std::vector<char>& payload) {
+    std::vector<SharedSegment> segments;
+    std::vector<std::string> errors;
+    try {
+        WireReader in(payload);
+        claimValue(in, segments, errors);
+    } catch (const std::exception&) {
+        // 格式错误由解码过程报告；已接管的段照常释放
+    }
+    for (size_t i = 0; i < segments.size(); ++i) {
+        m_claimed.push_back(Claimed{std::move(segments[i]), std::move(errors[i])});
+    }
+}
+
+SharedSegment ReplyArrays::take() {
+    if (m_next >= m_claimed.size()) {
+        throw std::runtime_error("Worker reply references more arrays than it carries");
+    }
+    Claimed& claimed = m_claimed[m_next++];
+    if (!claimed.error.empty()) {
+        throw std::runtime_error(claimed.error);
+    }
+    return std::move(claimed.segment);
+}
+
+SharedSegment decodeArray(WireReader& in, char format, std::vector<int64_t>& shape, ReplyArrays& arrays) {
+    const char actual = static_cast<char>(in.get<uint8_t>());
+    const uint8_t ndim = in.get<uint8_t>();
+    shape.resize(ndim);
+    for (auto& dim : shape) {
+        dim = in.get<int64_t>();
+    }
+    in.getString();
+    in.get<uint64_t>();
+
+    // 段已在 ReplyArrays 中接管，类型不符时随其一起释放
+    SharedSegment segment = arrays.take();
+    if (actual != format) {
+        throw TypeConversionException(std::string("array '") + actual + "'", std::string("array '") + format + "'",
+                                      "Worker array element type does not match");
+    }
+    return segment;
+}
+
+} // namespace detail
+
+// ProcessModule / ProcessFunction 实现
+ProcessModule::ProcessModule(ProcessBridge& bridge, std::string module_name)
+    : m_bridge(bridge), m_module_name(std::move(module_name)) {}
+
+ProcessFunction::ProcessFunction(ProcessBridge& bridge, std::string module_name, std::string func_name)
+    : m_bridge(bridge), m_module_name(std::move(module_name)), m_func_name(std::move(func_name)) {}
+
+// ProcessBridge 实现
+ProcessBridge::ProcessBridge(ProcessBridgeConfig config) : m_config(std::move(config)) {
+    if (m_config.num_workers == 0) {
+        m_config.num_workers = 1;
+    }
+    m_config.ring_bytes = std::max<size_t>(m_config.ring_bytes, 4096);
+
+    for (size_t i = 0; i < m_config.num_workers; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+        m_workers.back()->index = i;
+    }
+
+    try {
+        for (auto& worker : m_workers) {
+            spawn(*worker);
+            worker->reader = std::thread(&ProcessBridge::readLoop, this, std::ref(*worker));
+        }
+    } catch (...) {
+        shutdown();
+        throw;
+    }
+}
+
+ProcessBridge::~ProcessBridge() {
+    shutdown();
+}
+
+void ProcessBridge::shutdown() {
+    m_stopping.store(true);
+    m_worker_ready.notify_all();
+
+    // 关闭套接字后工作进程读到EOF并退出，读取线程随后回收进程
+    for (auto& worker : m_workers) {
+        std::lock_guard<std::mutex> lock(worker->write_mutex);
+        if (worker->socket >= 0) {
+            ::shutdown(worker->socket, SHUT_RDWR);
+        }
+    }
+
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+    for (auto& worker : m_workers) {
+        if (worker->reader.joinable()) {
+            worker->reader.join();
+        } else if (worker->pid > 0) {
+            reap(*worker);
+        }
+    }
+}
+
+std::shared_ptr<ProcessModule> ProcessBridge::loadModule(const std::string& module_name) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (std::find(m_modules.begin(), m_modules.end(), module_name) != m_modules.end()) {
+            return std::make_shared<ProcessModule>(*this, module_name);
+        }
+        m_modules.push_back(module_name);
+    }
+
+    detail::WireWriter request;
+    request.putString(module_name);
+
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+
+    try {
+        std::vector<std::future<Reply>> replies;
+        for (auto& worker : m_workers) {
+            if (worker->alive.load()) {
+                replies.push_back(send(*worker, kLoad, request.bytes()));
+            }
+        }
+        for (auto& pending : replies) {
+            Reply reply = pending.get();
+            if (reply.kind != kResult) {
+                detail::WireReader in(reply.payload);
+                std::string type = in.getString();
+                throw PythonModuleException(module_name, type + ": " + in.getString());
+            }
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_modules.erase(std::remove(m_modules.begin(), m_modules.end(), module_name), m_modules.end());
+        throw;
+    }
+    return std::make_shared<ProcessModule>(*this, module_name);
+}
+
+std::shared_ptr<ProcessFunction> ProcessBridge::createFunction(const std::string& module_name,
+                                                               const std::string& func_name) {
+    loadModule(module_name);
+    return std::make_shared<ProcessFunction>(*this, module_name, func_name);
+}
+
+size_t ProcessBridge::size() const {
+    return m_workers.size();
+}
+
+std::vector<WorkerStats> ProcessBridge::getStats() const {
+    std::vector<WorkerStats> stats;
+    stats.reserve(m_workers.size());
+    for (const auto& worker : m_workers) {
+        WorkerStats entry;
+        entry.index = worker->index;
+        {
+            std::lock_guard<std::mutex> lock(worker->write_mutex);
+            entry.pid = worker->pid;
+        }
+        entry.alive = worker->alive.load();
+        entry.in_flight = worker->in_flight.load();
+        entry.calls = worker->calls.load();
+        entry.restarts = worker->restarts.load();
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+ProcessBridge::Reply ProcessBridge::dispatch(uint32_t kind, std::vector<char> body) {
+    Worker& worker = pickWorker();
+    worker.in_flight.fetch_add(1);
+
+    Reply reply;
+    try {
+        std::future<Reply> pending = send(worker, kind, body);
+
+        // 等待期间不需要本进程的解释器
+        std::optional<py::gil_scoped_release> release;
+        if (PythonInterpreter::holdsGIL()) {
+            release.emplace();
+        }
+        reply = pending.get();
+    } catch (...) {
+        worker.in_flight.fetch_sub(1);
+        throw;
+    }
+    worker.in_flight.fetch_sub(1);
+    worker.calls.fetch_add(1, std::memory_order_relaxed);
+    return reply;
+}
+
+ProcessBridge::Worker& ProcessBridge::pickWorker() {
+    const auto deadline = std::chrono::steady_clock::now() + kDispatchTimeout;
+    for (;;) {
+        if (m_stopping.load()) {
+            throw PythonInterpreterException("ProcessBridge is shut down");
+        }
+
+        // 负载最低的存活进程；起点轮转以分散相同负载
+        Worker* best = nullptr;
+        const size_t count = m_workers.size();
+        const size_t start = m_next_worker.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i) {
+            Worker& candidate = *m_workers[(start + i) % count];
+            if (candidate.alive.load() && (!best || candidate.in_flight.load() < best->in_flight.load())) {
+                best = &candidate;
+            }
+        }
+        if (best) {
+            return *best;
+        }
+
+        // 所有进程都在重启中
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_worker_ready.wait_until(lock, std::min(deadline, std::chrono::steady_clock::now() +
+                                                                   std::chrono::milliseconds(50))) ==
+                std::cv_status::timeout &&
+            std::chrono::steady_clock::now() >= deadline) {
+            throw PythonInterpreterException("No ProcessBridge worker is running");
+        }
+    }
+}
+
+std::future<ProcessBridge::Reply> ProcessBridge::send(Worker& worker, uint32_t kind, const std::vector<char>& body) {
+    const size_t need = sizeof(FrameHeader) + body.size();
+    if (need > m_config.ring_bytes) {
+        throw PythonInterpreterException("Request of " + std::to_string(need) +
+                                         " bytes exceeds the ProcessBridge ring capacity");
+    }
+
+    const uint64_t id = m_next_id.fetch_add(1, std::memory_order_relaxed);
+    auto promise = std::make_shared<std::promise<Reply>>();
+    std::future<Reply> future = promise->get_future();
+    {
+        std::lock_guard<std::mutex> lock(worker.pending_mutex);
+        worker.pending.emplace(id, std::move(promise));
+    }
+
+    std::unique_lock<std::mutex> lock(worker.write_mutex);
+    for (;;) {
+        if (!worker.alive.load()) {
+            lock.unlock();
+            std::lock_guard<std::mutex> pending_lock(worker.pending_mutex);
+            worker.pending.erase(id);
+            throw PythonInterpreterException("ProcessBridge worker " + std::to_string(worker.index) +
+                                             " is not running");
+        }
+        RingView ring = requestRing(worker.region, m_config.ring_bytes);
+        const uint64_t head = ring.head->load(std::memory_order_relaxed);
+        if (m_config.ring_bytes - (head - ring.tail->load(std::memory_order_acquire)) >= need) {
+            FrameHeader header{static_cast<uint32_t>(body.size()), kind, id};
+            ring.copyIn(head, &header, sizeof(header));
+            ring.copyIn(head + sizeof(header), body.data(), body.size());
+            ring.head->store(head + need, std::memory_order_release);
+            break;
+        }
+        // 环已满，等待工作进程消费；期间释放锁以便回收已退出的进程
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        lock.lock();
+    }
+
+    // 写入失败说明进程已退出，读取线程会让该调用失败
+    const char bell = 1;
+    (void)::send(worker.socket, &bell, 1, MSG_NOSIGNAL);
+    return future;
+}
+
+void ProcessBridge::spawn(Worker& worker) {
+    const std::string executable = resolveExecutable(m_config.python_executable);
+    const size_t capacity = m_config.ring_bytes;
+    const size_t region_size = kRegionHeaderBytes + 2 * capacity;
+
+    // 匿名共享区域：创建后立即删除名字，只通过继承的描述符共享
+    const std::string region_name = uniqueSegmentName("w");
+    int region_fd = shm_open(region_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (region_fd < 0) {
+        throw systemError("shm_open failed for worker region");
+    }
+    shm_unlink(region_name.c_str());
+    if (ftruncate(region_fd, static_cast<off_t>(region_size)) != 0) {
+        auto error = systemError("ftruncate failed for worker region");
+        close(region_fd);
+        throw error;
+    }
+    void* region = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, region_fd, 0);
+    if (region == MAP_FAILED) {
+        auto error = systemError("mmap failed for worker region");
+        close(region_fd);
+        throw error;
+    }
+
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+        auto error = systemError("socketpair failed");
+        munmap(region, region_size);
+        close(region_fd);
+        throw error;
+    }
+    for (int fd : sockets) {
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+        int enable = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+    }
+
+    // fork 之后子进程只调用异步信号安全的函数，路径与参数提前准备好
+    std::vector<std::string> args = {m_config.python_executable, "-c", kWorkerScript,
+                                     std::to_string(region_fd), std::to_string(sockets[1]),
+                                     std::to_string(capacity)};
+    args.insert(args.end(), m_config.module_paths.begin(), m_config.module_paths.end());
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        fcntl(region_fd, F_SETFD, 0);
+        fcntl(sockets[1], F_SETFD, 0);
+        execv(executable.c_str(), argv.data());
+        _exit(127);
+    }
+    close(region_fd);
+    close(sockets[1]);
+    if (pid < 0) {
+        auto error = systemError("fork failed");
+        close(sockets[0]);
+        munmap(region, region_size);
+        throw error;
+    }
+
+    // 等待工作进程的就绪字节，解释器无法启动时尽早失败
+    pollfd ready{sockets[0], POLLIN, 0};
+    const int timeout_ms = static_cast<int>(std::chrono::milliseconds(kStartTimeout).count());
+    char byte = 0;
+    if (poll(&ready, 1, timeout_ms) <= 0 || recv(sockets[0], &byte, 1, 0) != 1) {
+        kill(pid, SIGKILL);
+        int status = waitForExit(pid);
+        close(sockets[0]);
+        munmap(region, region_size);
+        throw PythonInterpreterException("ProcessBridge worker '" + m_config.python_executable +
+                                         "' failed to start (" + describeExit(status) + ")");
+    }
+
+    std::lock_guard<std::mutex> lock(worker.write_mutex);
+    worker.pid = pid;
+    worker.socket = sockets[0];
+    worker.region = region;
+    worker.region_size = region_size;
+    worker.alive.store(true);
+}
+
+void ProcessBridge::readLoop(Worker& worker) {
+    char wake[256];
+    for (;;) {
+        ssize_t received = recv(worker.socket, wake, sizeof(wake), 0);
+        if (received > 0) {
+            if (drainReplies(worker)) {
+                continue;
+            }
+        } else if (received < 0 && errno == EINTR) {
+            continue;
+        }
+
+        reap(worker);
+        if (m_stopping.load()) {
+            return;
+        }
+
+        try {
+            spawn(worker);
+        } catch (const std::exception& e) {
+            std::cerr << "ProcessBridge worker " << worker.index << " could not be restarted: " << e.what()
+                      << std::endl;
+            return;
+        }
+        worker.restarts.fetch_add(1);
+        if (m_stopping.load()) {
+            // shutdown() ran while the worker was starting
+            std::lock_guard<std::mutex> lock(worker.write_mutex);
+            ::shutdown(worker.socket, SHUT_RDWR);
+            continue;
+        }
+
+        // 预先导入已加载的模块；失败会在调用时重新报告
+        std::vector<std::string> modules;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            modules = m_modules;
+        }
+        for (const auto& module_name : modules) {
+            detail::WireWriter request;
+            request.putString(module_name);
+            try {
+                send(worker, kLoad, request.bytes());
+            } catch (const std::exception& e) {
+                std::cerr << "ProcessBridge worker " << worker.index << " could not reload " << module_name
+                          << ": " << e.what() << std::endl;
+            }
+        }
+        m_worker_ready.notify_all();
+    }
+}
+
+bool ProcessBridge::drainReplies(Worker& worker) {
+    RingView ring = replyRing(worker.region, m_config.ring_bytes);
+    uint64_t tail = ring.tail->load(std::memory_order_relaxed);
+    while (tail != ring.head->load(std::memory_order_acquire)) {
+        FrameHeader header{};
+        ring.copyOut(tail, &header, sizeof(header));
+        if (sizeof(header) + header.length > m_config.ring_bytes) {
+            // 帧损坏，终止进程并按崩溃处理
+            kill(worker.pid, SIGKILL);
+            return false;
+        }
+
+        Reply reply;
+        reply.kind = header.kind;
+        reply.payload.resize(header.length);
+        ring.copyOut(tail + sizeof(header), reply.payload.data(), header.length);
+        tail += sizeof(header) + header.length;
+        ring.tail->store(tail, std::memory_order_release);
+
+        std::shared_ptr<std::promise<Reply>> promise;
+        {
+            std::lock_guard<std::mutex> lock(worker.pending_mutex);
+            auto it = worker.pending.find(header.id);
+            if (it != worker.pending.end()) {
+                promise = std::move(it->second);
+                worker.pending.erase(it);
+            }
+        }
+        if (promise) {
+            promise->set_value(std::move(reply));
+        }
+    }
+    return true;
+}
+
+void ProcessBridge::reap(Worker& worker) {
+    pid_t pid;
+    {
+        std::lock_guard<std::mutex> lock(worker.write_mutex);
+        worker.alive.store(false);
+        if (worker.socket >= 0) {
+            close(worker.socket);
+            worker.socket = -1;
+        }
+        if (worker.region) {
+            munmap(worker.region, worker.region_size);
+            worker.region = nullptr;
+        }
+        pid = worker.pid;
+    }
+
+    const std::string reason = pid > 0 ? describeExit(waitForExit(pid)) : "is not running";
+
+    // 进行中的调用可能有副作用，不自动重试
+    std::unordered_map<uint64_t, std::shared_ptr<std::promise<Reply>>> pending;
+    {
+        std::lock_guard<std::mutex> lock(worker.pending_mutex);
+        pending.swap(worker.pending);
+    }
+    for (auto& entry : pending) {
+        entry.second->set_exception(std::make_exception_ptr(PythonInterpreterException(
+            "ProcessBridge worker " + std::to_string(worker.index) + " " + reason)));
+    }
+
+    std::lock_guard<std::mutex> lock(worker.write_mutex);
+    worker.pid = -1;
+}
+
+void ProcessBridge::throwRemoteError(const std::string& func_name, const Reply& reply) {
+    detail::WireReader in(reply.payload);
+    std::string type = in.getString();
+    throw PythonFunctionException(func_name, type + ": " + in.getString());
+}
+
+} // namespace cpppy_bridge
@@ -1,10 +1,127 @@
 #include "python_bridge.h"
+#include "async_bridge.h"
+#include "interpreter_pool.h"
+#include "python_object.h"
+#include <algorithm>
 #include <iostream>
 #include <filesystem>
+#include <optional>
 #include <stdexcept>
 
+#if defined(PYBIND11_PYCONFIG_SUPPORT_PY_VERSION_HEX) && PY_VERSION_HEX >= PYBIND11_PYCONFIG_SUPPORT_PY_VERSION_HEX
+#define CPPPY_HAS_PYCONFIG 1
+#else
+#define CPPPY_HAS_PYCONFIG 0
+#endif
+
 namespace cpppy_bridge {
 
+namespace {
+
+std::chrono::microseconds elapsedSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+#if CPPPY_HAS_PYCONFIG
+// 解释器启动前转换路径并追加到 PyConfig 的宽字符串列表
+void appendSearchPath(PyConfig& config, const std::string& path) {
+    wchar_t* wide = Py_DecodeLocale(path.c_str(), nullptr);
+    if (!wide) {
+        throw PythonInterpreterException("Failed to decode module search path: " + path);
+    }
+    PyStatus status = PyWideStringList_Append(&config.module_search_paths, wide);
+    PyMem_RawFree(wide);
+    if (PyStatus_Exception(status)) {
+        throw PythonInterpreterException("Failed to set module search path: " + path);
+    }
+}
+
+// 分配器必须在预初始化之后、创建解释器之前安装
+void installAllocators(const AllocatorConfig& allocators, bool isolated) {
+    PyPreConfig preconfig;
+    if (isolated) {
+        PyPreConfig_InitIsolatedConfig(&preconfig);
+    } else {
+        PyPreConfig_InitPythonConfig(&preconfig);
+    }
+    
+    switch (allocators.preset) {
+    case PythonAllocator::Default:
+        // 保留默认值（非隔离模式下 PYTHONMALLOC 仍然生效）
+        break;
+    case PythonAllocator::Malloc:
+        preconfig.allocator = PYMEM_ALLOCATOR_MALLOC;
+        break;
+    case PythonAllocator::PyMalloc:
+        preconfig.allocator = PYMEM_ALLOCATOR_PYMALLOC;
+        break;
+    case PythonAllocator::MallocDebug:
+        preconfig.allocator = PYMEM_ALLOCATOR_MALLOC_DEBUG;
+        break;
+    case PythonAllocator::PyMallocDebug:
+        preconfig.allocator = PYMEM_ALLOCATOR_PYMALLOC_DEBUG;
+        break;
+    }
+    
+    PyStatus status = Py_PreInitialize(&preconfig);
+    if (PyStatus_Exception(status)) {
+        throw PythonInterpreterException(std::string("Failed to preinitialize Python: ") +
+                                         (status.err_msg ? status.err_msg : "unknown error"));
+    }
+    
+    // PyMem_SetAllocator 复制结构体，ctx 由调用方维持有效
+    if (allocators.raw) {
+        PyMemAllocatorEx raw = *allocators.raw;
+        PyMem_SetAllocator(PYMEM_DOMAIN_RAW, &raw);
+    }
+    if (allocators.mem) {
+        PyMemAllocatorEx mem = *allocators.mem;
+        PyMem_SetAllocator(PYMEM_DOMAIN_MEM, &mem);
+    }
+    if (allocators.object) {
+        PyMemAllocatorEx object = *allocators.object;
+        PyMem_SetAllocator(PYMEM_DOMAIN_OBJ, &object);
+    }
+    if (allocators.debug_hooks) {
+        PyMem_SetupDebugHooks();
+    }
+}
+#endif
+
+// 以 vectorcall 直接传递参数数组，不构造中间的 list 和 tuple
+py::object callWithArguments(const py::handle& callable, const std::vector<py::object>& args, CallTimer& timer) {
+    PyObject* result = nullptr;
+#if PY_VERSION_HEX >= 0x03090000
+    constexpr size_t kStackArguments = 8;
+    if (args.size() <= kStackArguments) {
+        PyObject* stack[kStackArguments];
+        for (size_t i = 0; i < args.size(); ++i) {
+            stack[i] = args[i].ptr();
+        }
+        timer.lap(MetricPhase::ArgConversion);
+        result = PyObject_Vectorcall(callable.ptr(), stack, args.size(), nullptr);
+    } else
+#endif
+    {
+        py::tuple packed(args.size());
+        for (size_t i = 0; i < args.size(); ++i) {
+            PyTuple_SET_ITEM(packed.ptr(), static_cast<Py_ssize_t>(i), args[i].inc_ref().ptr());
+        }
+        timer.lap(MetricPhase::ArgConversion);
+        result = PyObject_Call(callable.ptr(), packed.ptr(), nullptr);
+    }
+    if (!result) {
+        throw py::error_already_set();
+    }
+    timer.lap(MetricPhase::Python);
+    return py::reinterpret_steal<py::object>(result);
+}
+
+} // namespace
+
+// StartupProfile 实现
+StartupProfile::StartupProfile() = default;
+
 // PythonInterpreter 实现
 PythonInterpreter& PythonInterpreter::getInstance() {
     static PythonInterpreter instance;
@@ -12,28 +129,222 @@ PythonInterpreter& PythonInterpreter::getInstance() {
 }
 
 void PythonInterpreter::initialize() {
+    initialize(StartupProfile());
+}
+
+void PythonInterpreter::initialize(const StartupProfile& profile) {
     if (m_initialized) {
+        // 解释器已存在：配置项不再生效，只补充路径与预加载模块
+        if (!profile.allocator.isDefault()) {
+            std::cerr << "Python interpreter is already initialized; allocator is ignored." << std::endl;
+        }
+        waitUntilReady();
+        for (const auto& path : profile.module_paths) {
+            addModulePath(path);
+        }
+        if (!profile.preload_modules.empty()) {
+            startPreload(profile.preload_modules, profile.async_preload);
+        }
         return;
     }
     
+    const auto start = std::chrono::steady_clock::now();
+    CallTimer timer("PythonInterpreter", "initialize");
+    
     try {
+        if (profile.frozen_modules) {
+            PyImport_FrozenModules = profile.frozen_modules;
+        }
+        
+        const bool precomputed_path = !profile.module_search_paths.empty();
+#if CPPPY_HAS_PYCONFIG
+        // 分配器只在进程内首次创建解释器时安装：已分配的内存块不能交给其他分配器释放
+        if (!profile.allocator.isDefault()) {
+            if (!m_allocators_installed && !Py_IsInitialized()) {
+                installAllocators(profile.allocator, profile.isolated);
+                m_allocators_installed = true;
+            } else {
+                std::cerr << "Python allocators can only be installed before the first initialization; "
+                             "allocator is ignored." << std::endl;
+            }
+        }
+        
+        PyConfig config;
+        if (profile.isolated) {
+            PyConfig_InitIsolatedConfig(&config);
+        } else {
+            PyConfig_InitPythonConfig(&config);
+        }
+        config.site_import = profile.no_site ? 0 : 1;
+        
+        try {
+            // 预先计算的 sys.path 跳过解释器启动时的路径探测
+            if (precomputed_path) {
+                config.module_search_paths_set = 1;
+                for (const auto& archive : profile.bytecode_archives) {
+                    appendSearchPath(config, archive);
+                }
+                for (const auto& path : profile.module_search_paths) {
+                    appendSearchPath(config, path);
+                }
+            }
+            m_interpreter = std::make_unique<py::scoped_interpreter>(&config);
+        } catch (...) {
+            PyConfig_Clear(&config);
+            throw;
+        }
+        PyConfig_Clear(&config);
+#else
+        if (profile.isolated || profile.no_site || precomputed_path || !profile.allocator.isDefault()) {
+            std::cerr << "PyConfig is unavailable; isolated, no_site, module_search_paths and allocator are ignored."
+                      << std::endl;
+        }
         m_interpreter = std::make_unique<py::scoped_interpreter>();
+#endif
         m_initialized = true;
         
-        // 添加当前目录到Python路径
         py::module sys = py::module::import("sys");
         py::list path = sys.attr("path");
-        path.append(".");
+        if (!precomputed_path) {
+            // 字节码归档优先于源码目录
+            for (auto it = profile.bytecode_archives.rbegin(); it != profile.bytecode_archives.rend(); ++it) {
+                path.insert(0, py::str(*it));
+            }
+            
+            // 添加当前目录到Python路径
+            path.append(".");
+        }
+        for (const auto& module_path : profile.module_paths) {
+            addModulePath(module_path);
+        }
+        timer.lap(MetricPhase::Python);
+        
+        {
+            std::lock_guard<std::mutex> lock(m_preload_mutex);
+            m_startup_stats = StartupStats();
+            m_startup_stats.interpreter_init = elapsedSince(start);
+        }
         
         std::cout << "Python interpreter initialized successfully." << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Failed to initialize Python interpreter: " << e.what() << std::endl;
         throw;
     }
+    
+    if (!profile.preload_modules.empty()) {
+        startPreload(profile.preload_modules, profile.async_preload);
+    }
+}
+
+void PythonInterpreter::startPreload(const std::vector<std::string>& modules, bool async) {
+    // 后台导入尚未被发起线程收回时不再启动新的导入线程，改为同步导入
+    if (!async || m_preloading.load(std::memory_order_acquire)) {
+        py::gil_scoped_acquire gil;
+        preloadModules(modules);
+        return;
+    }
+    if (m_preload_thread.joinable()) {
+        m_preload_thread.join();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_preload_mutex);
+        m_preload_finished = false;
+    }
+    m_owner_thread = std::this_thread::get_id();
+    m_preloading.store(true, std::memory_order_release);
+    
+    // 将GIL交给后台导入线程，调用方继续执行其余的C++启动流程
+    m_suspended_tstate = holdsGIL() ? PyEval_SaveThread() : nullptr;
+    m_preload_thread = std::thread([this, modules] {
+        {
+            py::gil_scoped_acquire gil;
+            preloadModules(modules);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_preload_mutex);
+            m_preload_finished = true;
+        }
+        m_preload_done.notify_all();
+    });
+}
+
+void PythonInterpreter::preloadModules(const std::vector<std::string>& modules) {
+    const auto start = std::chrono::steady_clock::now();
+    CallTimer timer("PythonInterpreter", "preload");
+    
+    std::vector<std::string> preloaded;
+    std::vector<std::string> failed;
+    for (const auto& module_name : modules) {
+        try {
+            py::module::import(module_name.c_str());
+            preloaded.push_back(module_name);
+        } catch (const py::error_already_set& e) {
+            std::cerr << "Failed to preload module " << module_name << ": " << e.what() << std::endl;
+            failed.push_back(module_name);
+        }
+    }
+    timer.lap(MetricPhase::Python);
+    
+    std::lock_guard<std::mutex> lock(m_preload_mutex);
+    m_startup_stats.preload += elapsedSince(start);
+    m_startup_stats.preloaded.insert(m_startup_stats.preloaded.end(), preloaded.begin(), preloaded.end());
+    m_startup_stats.failed_preloads.insert(m_startup_stats.failed_preloads.end(), failed.begin(), failed.end());
+}
+
+void PythonInterpreter::waitUntilReady() {
+    if (!m_preloading.load(std::memory_order_acquire)) {
+        return;
+    }
+    
+    if (std::this_thread::get_id() != m_owner_thread) {
+        // 其他线程只等待导入完成；持有GIL时先释放，否则导入线程无法继续
+        std::optional<py::gil_scoped_release> release;
+        if (holdsGIL()) {
+            release.emplace();
+        }
+        std::unique_lock<std::mutex> lock(m_preload_mutex);
+        m_preload_done.wait(lock, [this] { return m_preload_finished; });
+        return;
+    }
+    
+    {
+        std::unique_lock<std::mutex> lock(m_preload_mutex);
+        m_preload_done.wait(lock, [this] { return m_preload_finished; });
+    }
+    m_preload_thread.join();
+    if (m_suspended_tstate) {
+        PyEval_RestoreThread(m_suspended_tstate);
+        m_suspended_tstate = nullptr;
+    }
+    m_preloading.store(false, std::memory_order_release);
+}
+
+bool PythonInterpreter::isReady() const {
+    if (!m_initialized) {
+        return false;
+    }
+    if (!m_preloading.load(std::memory_order_acquire)) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(m_preload_mutex);
+    return m_preload_finished;
+}
+
+StartupStats PythonInterpreter::getStartupStats() const {
+    std::lock_guard<std::mutex> lock(m_preload_mutex);
+    return m_startup_stats;
 }
 
 void PythonInterpreter::finalize() {
     if (m_initialized) {
+        waitUntilReady();
+        AsyncLoop::getInstance().stop();
+        ErrorHandler::resetInterpreterState();
+        m_code_cache.clear();
+        SmallValueCache::clear();
+        m_tracemalloc_baseline = py::object();
+        m_tracemalloc_started.store(false, std::memory_order_release);
         m_interpreter.reset();
         m_initialized = false;
         std::cout << "Python interpreter finalized." << std::endl;
@@ -48,22 +359,16 @@ void PythonInterpreter::addModulePath(const std::string& path) {
     if (!m_initialized) {
         throw std::runtime_error("Python interpreter not initialized");
     }
+    waitUntilReady();
     
     try {
         py::module sys = py::module::import("sys");
         py::list sys_path = sys.attr("path");
         
-        // 检查路径是否已存在
-        bool path_exists = false;
-        for (auto item : sys_path) {
-            if (item.cast<std::string>() == path) {
-                path_exists = true;
-                break;
-            }
-        }
-        
-        if (!path_exists) {
-            sys_path.append(path);
+        // 检查路径是否已存在（PySequence_Contains，无需逐项转换为 std::string）
+        py::str entry(path);
+        if (!sys_path.contains(entry)) {
+            sys_path.append(entry);
             std::cout << "Added module path: " << path << std::endl;
         }
     } catch (const py::error_already_set& e) {
@@ -72,17 +377,189 @@ void PythonInterpreter::addModulePath(const std::string& path) {
 }
 
 py::object PythonInterpreter::execute(const std::string& code) {
+    return execute(code, CodeMode::Eval);
+}
+
+py::object PythonInterpreter::execute(const std::string& code, CodeMode mode) {
+    if (!m_initialized) {
+        throw std::runtime_error("Python interpreter not initialized");
+    }
+    waitUntilReady();
+    
+    try {
+        py::object globals = py::globals();
+        return evalCode(m_code_cache.get(code, mode), globals, globals);
+    } catch (const py::error_already_set& e) {
+        throw std::runtime_error("Failed to execute Python code: " + std::string(e.what()));
+    }
+}
+
+py::object PythonInterpreter::execute(const std::string& code, const py::dict& locals, CodeMode mode) {
     if (!m_initialized) {
         throw std::runtime_error("Python interpreter not initialized");
     }
+    waitUntilReady();
     
     try {
-        return py::eval(code);
+        return evalCode(m_code_cache.get(code, mode), py::globals(), locals);
     } catch (const py::error_already_set& e) {
         throw std::runtime_error("Failed to execute Python code: " + std::string(e.what()));
     }
 }
 
+void PythonInterpreter::executeFile(const std::string& file_path) {
+    if (!m_initialized) {
+        throw std::runtime_error("Python interpreter not initialized");
+    }
+    waitUntilReady();
+    
+    try {
+        // 与 py::eval_file 一致：__file__ 未设置时指向脚本
+        py::dict globals = py::globals();
+        if (!globals.contains("__file__")) {
+            globals["__file__"] = py::str(file_path);
+        }
+        evalCode(m_code_cache.getFile(file_path), globals, globals);
+    } catch (const py::error_already_set& e) {
+        throw std::runtime_error("Failed to execute file " + file_path + ": " + e.what());
+    }
+}
+
+CodeCache& PythonInterpreter::getCodeCache() {
+    return m_code_cache;
+}
+
+py::object PythonInterpreter::evalCode(const py::object& code, const py::object& globals, const py::object& locals) {
+    PyObject* result = PyEval_EvalCode(code.ptr(), globals.ptr(), locals.ptr());
+    if (!result) {
+        throw py::error_already_set();
+    }
+    return py::reinterpret_steal<py::object>(result);
+}
+
+bool PythonInterpreter::holdsGIL() {
+    if (!Py_IsInitialized()) {
+        return false;
+    }
+    // PyGILState_Check() is unreliable once sub-interpreters exist, so look at
+    // the current thread state directly
+#if PY_VERSION_HEX >= 0x030D0000
+    return PyThreadState_GetUnchecked() != nullptr;
+#else
+    return _PyThreadState_UncheckedGet() != nullptr;
+#endif
+}
+
+void PythonInterpreter::startTracemalloc(int frames) {
+    if (!m_initialized) {
+        throw std::runtime_error("Python interpreter not initialized");
+    }
+    waitUntilReady();
+    
+    py::gil_scoped_acquire gil;
+    py::module_ tracemalloc = py::module_::import("tracemalloc");
+    if (!tracemalloc.attr("is_tracing")().cast<bool>()) {
+        tracemalloc.attr("start")(std::max(frames, 1));
+    }
+    m_tracemalloc_started.store(true, std::memory_order_release);
+}
+
+void PythonInterpreter::stopTracemalloc() {
+    if (!m_initialized) {
+        return;
+    }
+    waitUntilReady();
+    
+    py::gil_scoped_acquire gil;
+    m_tracemalloc_started.store(false, std::memory_order_release);
+    m_tracemalloc_baseline = py::object();
+    py::module_::import("tracemalloc").attr("stop")();
+}
+
+bool PythonInterpreter::isTracemallocActive() {
+    if (!m_initialized) {
+        return false;
+    }
+    waitUntilReady();
+    
+    py::gil_scoped_acquire gil;
+    return py::module_::import("tracemalloc").attr("is_tracing")().cast<bool>();
+}
+
+bool PythonInterpreter::tracemallocStarted() const {
+    return m_tracemalloc_started.load(std::memory_order_acquire);
+}
+
+namespace {
+
+// 将 tracemalloc 的 Statistic / StatisticDiff 列表转换为分配位置
+std::vector<PythonAllocation> topAllocations(const py::object& statistics, size_t top_n, bool diff) {
+    std::vector<PythonAllocation> top;
+    for (py::handle stat : statistics) {
+        if (top.size() >= top_n) {
+            break;
+        }
+        PythonAllocation allocation;
+        py::object frame = stat.attr("traceback")[py::int_(0)];
+        allocation.location = frame.attr("filename").cast<std::string>() + ":" +
+                              std::to_string(frame.attr("lineno").cast<int>());
+        allocation.bytes = stat.attr(diff ? "size_diff" : "size").cast<int64_t>();
+        allocation.blocks = stat.attr(diff ? "count_diff" : "count").cast<int64_t>();
+        top.push_back(std::move(allocation));
+    }
+    return top;
+}
+
+} // namespace
+
+TracemallocSnapshot PythonInterpreter::takeTracemallocSnapshot(size_t top_n) {
+    if (!m_initialized) {
+        throw std::runtime_error("Python interpreter not initialized");
+    }
+    waitUntilReady();
+    
+    py::gil_scoped_acquire gil;
+    py::module_ tracemalloc = py::module_::import("tracemalloc");
+    if (!tracemalloc.attr("is_tracing")().cast<bool>()) {
+        throw std::runtime_error("tracemalloc is not tracing; call startTracemalloc() first");
+    }
+    
+    TracemallocSnapshot result;
+    py::tuple memory = tracemalloc.attr("get_traced_memory")();
+    result.traced_bytes = memory[0].cast<size_t>();
+    result.peak_bytes = memory[1].cast<size_t>();
+    py::object snapshot = tracemalloc.attr("take_snapshot")();
+    result.top = topAllocations(snapshot.attr("statistics")("lineno"), top_n, false);
+    return result;
+}
+
+TracemallocSnapshot PythonInterpreter::tracemallocGrowth(size_t top_n) {
+    if (!m_initialized) {
+        throw std::runtime_error("Python interpreter not initialized");
+    }
+    waitUntilReady();
+    
+    py::gil_scoped_acquire gil;
+    py::module_ tracemalloc = py::module_::import("tracemalloc");
+    if (!tracemalloc.attr("is_tracing")().cast<bool>()) {
+        throw std::runtime_error("tracemalloc is not tracing; call startTracemalloc() first");
+    }
+    
+    TracemallocSnapshot result;
+    py::tuple memory = tracemalloc.attr("get_traced_memory")();
+    result.traced_bytes = memory[0].cast<size_t>();
+    result.peak_bytes = memory[1].cast<size_t>();
+    
+    // 排除 tracemalloc 自身的分配，避免快照本身显示为增长
+    py::object snapshot = tracemalloc.attr("take_snapshot")().attr("filter_traces")(py::make_tuple(
+        tracemalloc.attr("Filter")(false, tracemalloc.attr("__file__"))));
+    if (m_tracemalloc_baseline) {
+        result.top = topAllocations(snapshot.attr("compare_to")(m_tracemalloc_baseline, "lineno"), top_n, true);
+    }
+    m_tracemalloc_baseline = snapshot;
+    return result;
+}
+
 PythonInterpreter::~PythonInterpreter() {
     finalize();
 }
@@ -95,10 +572,12 @@ PythonModule::PythonModule(const std::string& module_name)
     if (!interpreter.isInitialized()) {
         interpreter.initialize();
     }
+    interpreter.waitUntilReady();
     
     try {
         m_module = py::module::import(module_name.c_str());
         m_loaded = true;
+        recordSource();
         std::cout << "Successfully loaded module: " << module_name << std::endl;
     } catch (const py::error_already_set& e) {
         std::cerr << "Failed to load module " << module_name << ": " << e.what() << std::endl;
@@ -128,14 +607,25 @@ py::object PythonModule::callFunction(const std::string& func_name, const std::v
     }
     
     try {
+        CallTimer timer(m_module_name, func_name);
         py::object func = m_module.attr(func_name.c_str());
-        
-        if (args.empty()) {
-            return func();
-        } else {
-            py::tuple py_args = py::cast(args);
-            return func(*py_args);
-        }
+        return callWithArguments(func, args, timer);
+    } catch (const py::error_already_set& e) {
+        throw std::runtime_error("Python error in " + m_module_name + "." + func_name + ": " + e.what());
+    }
+}
+
+py::object PythonModule::callFunction(const std::string& func_name, const ArgumentPack& args) {
+    if (!m_loaded) {
+        throw std::runtime_error("Module not loaded: " + m_module_name);
+    }
+    
+    try {
+        CallTimer timer(m_module_name, func_name);
+        py::object func = m_module.attr(func_name.c_str());
+        py::object result = args.call(func);
+        timer.lap(MetricPhase::Python);
+        return result;
     } catch (const py::error_already_set& e) {
         throw std::runtime_error("Python error in " + m_module_name + "." + func_name + ": " + e.what());
     }
@@ -160,11 +650,152 @@ void PythonModule::setAttribute(const std::string& attr_name, const py::object&
     
     try {
         m_module.attr(attr_name.c_str()) = value;
+        m_generation.fetch_add(1, std::memory_order_release);
     } catch (const py::error_already_set& e) {
         throw std::runtime_error("Failed to set attribute " + attr_name + " in " + m_module_name + ": " + e.what());
     }
 }
 
+bool PythonModule::reload() {
+    if (!m_loaded) {
+        return false;
+    }
+    
+    // 同一模块的重新加载串行执行；等待期间释放GIL，因为导入过程中持有者会让出GIL
+    std::unique_lock<std::mutex> reload_lock(m_reload_mutex, std::try_to_lock);
+    if (!reload_lock.owns_lock()) {
+        py::gil_scoped_release release;
+        reload_lock.lock();
+    }
+    
+    try {
+        // 导入全新的模块对象而不是原地 importlib.reload，
+        // 正在执行的调用持有旧函数及其全局变量，不会看到半更新的状态
+        py::dict modules = py::module::import("sys").attr("modules");
+        py::str key(m_module_name);
+        py::object previous = modules.attr("pop")(key, py::none());
+        
+        py::module fresh;
+        try {
+            py::module::import("importlib").attr("invalidate_caches")();
+            fresh = py::module::import(m_module_name.c_str());
+        } catch (const py::error_already_set&) {
+            // 导入失败时恢复旧模块，并记录当前时间戳以免监视线程反复重试
+            if (!previous.is_none()) {
+                modules[key] = previous;
+            }
+            recordSource();
+            throw;
+        }
+        
+        m_module = std::move(fresh);
+        recordSource();
+        m_generation.fetch_add(1, std::memory_order_release);
+        std::cout << "Reloaded module: " << m_module_name << std::endl;
+        return true;
+    } catch (const py::error_already_set& e) {
+        std::cerr << "Failed to reload module " << m_module_name << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void PythonModule::recordSource() {
+    std::string file_path;
+    if (py::hasattr(m_module, "__file__")) {
+        py::object file = m_module.attr("__file__");
+        if (!file.is_none()) {
+            file_path = file.cast<std::string>();
+        }
+    }
+    
+    std::error_code ec;
+    std::filesystem::file_time_type mtime{};
+    if (!file_path.empty()) {
+        mtime = std::filesystem::last_write_time(file_path, ec);
+    }
+    
+    std::lock_guard<std::mutex> lock(m_source_mutex);
+    m_file_path = std::move(file_path);
+    m_file_mtime = ec ? std::filesystem::file_time_type{} : mtime;
+}
+
+std::string PythonModule::getFilePath() const {
+    std::lock_guard<std::mutex> lock(m_source_mutex);
+    return m_file_path;
+}
+
+bool PythonModule::isSourceModified() const {
+    std::lock_guard<std::mutex> lock(m_source_mutex);
+    if (m_file_path.empty()) {
+        return false;
+    }
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(m_file_path, ec);
+    return !ec && mtime != m_file_mtime;
+}
+
+uint64_t PythonModule::getGeneration() const {
+    return m_generation.load(std::memory_order_acquire);
+}
+
+const std::string& PythonModule::getName() const {
+    return m_module_name;
+}
+
+const py::module& PythonModule::getModuleObject() const {
+    return m_module;
+}
+
+// CallHandle 实现
+CallHandle::CallHandle(std::shared_ptr<PythonModule> module, const std::string& attr_name)
+    : m_module(std::move(module)), m_attr_name(attr_name) {
+    
+    if (!m_module || !m_module->isLoaded()) {
+        throw PythonModuleException(m_module ? m_module->getName() : "unknown", "Module not loaded");
+    }
+    
+    // 驻留属性名，之后刷新时无需再创建字符串对象
+    m_interned_name = py::reinterpret_steal<py::object>(PyUnicode_InternFromString(attr_name.c_str()));
+    if (!m_interned_name) {
+        throw py::error_already_set();
+    }
+    refresh();
+}
+
+bool CallHandle::isValid() const {
+    return m_module && m_callable;
+}
+
+uint64_t CallHandle::getGeneration() const {
+    return m_generation;
+}
+
+void CallHandle::refresh() {
+    // 先读取版本号，保证并发修改时最多多刷新一次
+    uint64_t generation = m_module->getGeneration();
+    PyObject* attr = PyObject_GetAttr(m_module->getModuleObject().ptr(), m_interned_name.ptr());
+    if (!attr) {
+        PyErr_Clear();
+        throw PythonFunctionException(m_attr_name, "Attribute not found in module " + m_module->getName());
+    }
+    m_callable = py::reinterpret_steal<py::object>(attr);
+    m_generation = generation;
+}
+
+py::object CallHandle::callPy(const ArgumentPack& args) {
+    if (!m_module) {
+        throw PythonFunctionException(m_attr_name, "Invalid call handle");
+    }
+    
+    try {
+        return args.call(get());
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+        throw; // Should not be reached
+    }
+}
+
 // PythonFunction 实现
 PythonFunction::PythonFunction(const std::string& module_name, const std::string& func_name)
     : m_func_name(func_name) {
@@ -173,6 +804,7 @@ PythonFunction::PythonFunction(const std::string& module_name, const std::string
     
     if (m_module->isLoaded() && m_module->hasFunction(func_name)) {
         try {
+            m_generation = m_module->getGeneration();
             m_function = m_module->getAttribute(func_name);
             m_valid = true;
         } catch (const std::exception& e) {
@@ -189,6 +821,7 @@ PythonFunction::PythonFunction(std::shared_ptr<PythonModule> module, const std::
     
     if (m_module && m_module->isLoaded() && m_module->hasFunction(func_name)) {
         try {
+            m_generation = m_module->getGeneration();
             m_function = m_module->getAttribute(func_name);
             m_valid = true;
         } catch (const std::exception& e) {
@@ -204,19 +837,62 @@ bool PythonFunction::isValid() const {
     return m_valid;
 }
 
+uint64_t PythonFunction::getGeneration() const {
+    return m_generation;
+}
+
+PythonFunction& PythonFunction::withCache(const MemoCachePolicy& policy) {
+    m_cache = std::make_shared<MemoCache>(policy);
+    return *this;
+}
+
+void PythonFunction::clearCache() {
+    if (m_cache) {
+        m_cache->clear();
+    }
+}
+
+MemoCacheStats PythonFunction::getCacheStats() const {
+    return m_cache ? m_cache->getStats() : MemoCacheStats{};
+}
+
+void PythonFunction::refresh() {
+    // 先读取版本号，保证并发修改时最多多刷新一次
+    uint64_t generation = m_module->getGeneration();
+    PyObject* attr = PyObject_GetAttrString(m_module->getModuleObject().ptr(), m_func_name.c_str());
+    if (!attr) {
+        PyErr_Clear();
+        throw PythonFunctionException(m_func_name, "Function no longer exists in module " + m_module->getName());
+    }
+    m_function = py::reinterpret_steal<py::object>(attr);
+    m_generation = generation;
+}
+
 py::object PythonFunction::callPy(const std::vector<py::object>& args) {
     if (!m_valid) {
         throw std::runtime_error("Invalid function: " + m_func_name);
     }
     
     try {
-        if (args.empty()) {
-            return m_function();
-        } else {
-            py::tuple py_args = py::cast(args);
-            py::object result = m_function(*py_args);
-            return result;
-        }
+        refreshIfStale();
+        CallTimer timer(m_module->getName(), m_func_name);
+        return callWithArguments(m_function, args, timer);
+    } catch (const py::error_already_set& e) {
+        throw std::runtime_error("Python error in function " + m_func_name + ": " + e.what());
+    }
+}
+
+py::object PythonFunction::callPy(const ArgumentPack& args) {
+    if (!m_valid) {
+        throw std::runtime_error("Invalid function: " + m_func_name);
+    }
+    
+    try {
+        refreshIfStale();
+        CallTimer timer(m_module->getName(), m_func_name);
+        py::object result = args.call(m_function);
+        timer.lap(MetricPhase::Python);
+        return result;
     } catch (const py::error_already_set& e) {
         throw std::runtime_error("Python error in function " + m_func_name + ": " + e.what());
     }
@@ -225,17 +901,22 @@ py::object PythonFunction::callPy(const std::vector<py::object>& args) {
 // PythonBridge 实现
 PythonBridge::PythonBridge() = default;
 
-PythonBridge::~PythonBridge() = default;
+PythonBridge::~PythonBridge() {
+    stopWatching();
+}
 
 bool PythonBridge::initialize(const std::vector<std::string>& module_paths) {
+    StartupProfile profile;
+    profile.module_paths = module_paths;
+    return initialize(profile);
+}
+
+bool PythonBridge::initialize(const StartupProfile& profile) {
     try {
+        // 模块搜索路径在预加载开始前加入
         auto& interpreter = PythonInterpreter::getInstance();
-        interpreter.initialize();
-        
-        // 添加模块搜索路径
-        for (const auto& path : module_paths) {
-            interpreter.addModulePath(path);
-        }
+        interpreter.initialize(profile);
+        m_module_paths = profile.module_paths;
         
         m_initialized = true;
         std::cout << "PythonBridge initialized successfully." << std::endl;
@@ -252,15 +933,18 @@ std::shared_ptr<PythonModule> PythonBridge::loadModule(const std::string& module
         throw std::runtime_error("PythonBridge not initialized");
     }
     
-    auto it = m_modules.find(module_name);
-    if (it != m_modules.end()) {
-        return it->second;
+    {
+        std::lock_guard<std::mutex> lock(m_modules_mutex);
+        auto it = m_modules.find(module_name);
+        if (it != m_modules.end()) {
+            return it->second;
+        }
     }
     
     auto module = std::make_shared<PythonModule>(module_name);
     if (module->isLoaded()) {
-        m_modules[module_name] = module;
-        return module;
+        std::lock_guard<std::mutex> lock(m_modules_mutex);
+        return m_modules.emplace(module_name, module).first->second;
     }
     
     return nullptr;
@@ -276,6 +960,30 @@ std::shared_ptr<PythonFunction> PythonBridge::createFunction(const std::string&
     return std::make_shared<PythonFunction>(module, func_name);
 }
 
+std::shared_ptr<PythonClass> PythonBridge::getClass(const std::string& module_name,
+                                                   const std::string& class_name) {
+    auto module = loadModule(module_name);
+    if (!module) {
+        throw PythonModuleException(module_name, "Failed to load module");
+    }
+    
+    const std::string key = module_name + "." + class_name;
+    const uint64_t generation = module->getGeneration();
+    {
+        std::lock_guard<std::mutex> lock(m_modules_mutex);
+        auto it = m_classes.find(key);
+        if (it != m_classes.end() && it->second.generation == generation) {
+            return it->second.cls;
+        }
+    }
+    
+    // 模块重新加载后类对象已更换，重新解析
+    auto cls = std::make_shared<PythonClass>(module, class_name);
+    std::lock_guard<std::mutex> lock(m_modules_mutex);
+    m_classes[key] = ClassEntry{generation, cls};
+    return cls;
+}
+
 py::object PythonBridge::executeFile(const std::string& file_path) {
     if (!m_initialized) {
         throw std::runtime_error("PythonBridge not initialized");
@@ -285,12 +993,8 @@ py::object PythonBridge::executeFile(const std::string& file_path) {
         throw std::runtime_error("File not found: " + file_path);
     }
     
-    try {
-        py::eval_file(file_path);
-        return py::none();
-    } catch (const py::error_already_set& e) {
-        throw std::runtime_error("Failed to execute file " + file_path + ": " + e.what());
-    }
+    PythonInterpreter::getInstance().executeFile(file_path);
+    return py::none();
 }
 
 py::object PythonBridge::executeCode(const std::string& code) {
@@ -302,9 +1006,129 @@ py::object PythonBridge::executeCode(const std::string& code) {
     return interpreter.execute(code);
 }
 
+py::object PythonBridge::executeCode(const std::string& code, CodeMode mode) {
+    if (!m_initialized) {
+        throw std::runtime_error("PythonBridge not initialized");
+    }
+    
+    return PythonInterpreter::getInstance().execute(code, mode);
+}
+
+py::object PythonBridge::executeCode(const std::string& code, const py::dict& locals, CodeMode mode) {
+    if (!m_initialized) {
+        throw std::runtime_error("PythonBridge not initialized");
+    }
+    
+    return PythonInterpreter::getInstance().execute(code, locals, mode);
+}
+
 std::shared_ptr<PythonModule> PythonBridge::getModule(const std::string& module_name) {
+    std::lock_guard<std::mutex> lock(m_modules_mutex);
     auto it = m_modules.find(module_name);
     return (it != m_modules.end()) ? it->second : nullptr;
 }
 
+CallHandle PythonBridge::resolve(const std::string& module_name, const std::string& attr_name) {
+    auto module = loadModule(module_name);
+    if (!module) {
+        throw PythonModuleException(module_name, "Failed to load module");
+    }
+    
+    return CallHandle(module, attr_name);
+}
+
+std::shared_ptr<InterpreterPool> PythonBridge::createInterpreterPool(size_t num_interpreters) {
+    if (!m_initialized) {
+        throw std::runtime_error("PythonBridge not initialized");
+    }
+    PythonInterpreter::getInstance().waitUntilReady();
+    
+    return std::make_shared<InterpreterPool>(num_interpreters, m_module_paths);
+}
+
+bool PythonBridge::reloadModule(const std::string& module_name) {
+    auto module = getModule(module_name);
+    if (!module) {
+        throw PythonModuleException(module_name, "Module has not been loaded");
+    }
+    
+    PythonInterpreter::getInstance().waitUntilReady();
+    py::gil_scoped_acquire gil;
+    return module->reload();
+}
+
+std::future<bool> PythonBridge::reloadModuleAsync(const std::string& module_name) {
+    auto module = getModule(module_name);
+    if (!module) {
+        throw PythonModuleException(module_name, "Module has not been loaded");
+    }
+    
+    // std::async 的 future 析构时会等待任务结束；调用方持有GIL时任务无法获取GIL而死锁，
+    // 因此改用分离线程和 promise，丢弃 future 不会阻塞
+    std::promise<bool> promise;
+    std::future<bool> result = promise.get_future();
+    std::thread([module, promise = std::move(promise)]() mutable {
+        try {
+            py::gil_scoped_acquire gil;
+            promise.set_value(module->reload());
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }).detach();
+    return result;
+}
+
+void PythonBridge::watchModules(std::chrono::milliseconds interval) {
+    stopWatching();
+    {
+        std::lock_guard<std::mutex> lock(m_watch_mutex);
+        m_watch_stop = false;
+    }
+    m_watch_thread = std::thread(&PythonBridge::watchLoop, this, interval);
+}
+
+void PythonBridge::stopWatching() {
+    if (!m_watch_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_watch_mutex);
+        m_watch_stop = true;
+    }
+    m_watch_wakeup.notify_all();
+    
+    // 监视线程重新加载时需要GIL
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+    m_watch_thread.join();
+}
+
+void PythonBridge::watchLoop(std::chrono::milliseconds interval) {
+    std::unique_lock<std::mutex> lock(m_watch_mutex);
+    while (!m_watch_wakeup.wait_for(lock, interval, [this] { return m_watch_stop; })) {
+        lock.unlock();
+        
+        std::vector<std::shared_ptr<PythonModule>> modules;
+        {
+            std::lock_guard<std::mutex> modules_lock(m_modules_mutex);
+            modules.reserve(m_modules.size());
+            for (const auto& entry : m_modules) {
+                modules.push_back(entry.second);
+            }
+        }
+        
+        // 只检查文件时间戳，发现修改后才获取GIL
+        for (const auto& module : modules) {
+            if (module->isSourceModified()) {
+                py::gil_scoped_acquire gil;
+                module->reload();
+            }
+        }
+        
+        lock.lock();
+    }
+}
+
 } // namespace cpppy_bridge
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "python_executor.h"
+#include <iostream>
+
+namespace cpppy_bridge {
+
+// PythonExecutor 实现
+PythonExecutor::PythonExecutor(size_t num_threads, size_t queue_capacity)
+    : m_capacity(queue_capacity > 0 ? queue_capacity : 1) {
+
+    if (!PythonInterpreter::getInstance().isInitialized()) {
+        throw PythonInterpreterException("PythonExecutor requires an initialized interpreter");
+    }
+
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+
+    m_workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        m_workers.emplace_back(&PythonExecutor::workerLoop, this);
+    }
+}
+
+PythonExecutor::~PythonExecutor() {
+    shutdown();
+}
+
+void PythonExecutor::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping && m_workers.empty()) {
+            return;
+        }
+        m_stopping = true;
+    }
+    m_not_empty.notify_all();
+    m_not_full.notify_all();
+
+    // 工作线程需要GIL才能清空队列，等待期间释放当前线程持有的GIL
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+}
+
+bool PythonExecutor::isRunning() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_stopping;
+}
+
+size_t PythonExecutor::threadCount() const {
+    return m_workers.size();
+}
+
+size_t PythonExecutor::queueCapacity() const {
+    return m_capacity;
+}
+
+size_t PythonExecutor::pendingTasks() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+void PythonExecutor::enqueue(Task task) {
+    // 队列已满时阻塞；若调用方持有GIL则先释放，避免与工作线程死锁
+    std::optional<py::gil_scoped_release> release;
+    if (PythonInterpreter::holdsGIL()) {
+        release.emplace();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_full.wait(lock, [this] { return m_stopping || m_queue.size() < m_capacity; });
+        if (m_stopping) {
+            throw PythonBridgeException("PythonExecutor has been shut down");
+        }
+        m_queue.push_back(std::move(task));
+    }
+    m_not_empty.notify_one();
+}
+
+void PythonExecutor::workerLoop() {
+    // 为工作线程保留一个持久的线程状态，避免每次调用都重新创建
+    {
+        py::gil_scoped_acquire gil;
+        gil.inc_ref();
+    }
+
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_empty.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                break;
+            }
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        m_not_full.notify_one();
+
+        try {
+            task();
+        } catch (...) {
+            // 任务异常已通过promise传递，这里不应到达
+            std::cerr << "Unexpected exception in PythonExecutor worker" << std::endl;
+        }
+    }
+
+    if (Py_IsInitialized()) {
+        py::gil_scoped_acquire gil;
+        gil.dec_ref();
+    }
+}
+
+} // namespace cpppy_bridge
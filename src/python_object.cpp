@@ -0,0 +1,214 @@
+#include "python_object.h"
+
+namespace cpppy_bridge {
+
+// PythonClass 实现
+PythonClass::PythonClass(py::object type) : m_type(std::move(type)) {
+    if (!m_type || !PyType_Check(m_type.ptr())) {
+        throw TypeConversionException("object", "type", "PythonClass requires a class object");
+    }
+    m_name = py::str(m_type.attr("__qualname__"));
+}
+
+PythonClass::PythonClass(const std::shared_ptr<PythonModule>& module, const std::string& class_name)
+    : m_name(class_name) {
+    if (!module || !module->isLoaded()) {
+        throw PythonModuleException(module ? module->getName() : class_name, "Module not loaded");
+    }
+
+    m_type = module->getAttribute(class_name);
+    if (!PyType_Check(m_type.ptr())) {
+        throw PythonModuleException(module->getName(), class_name + " is not a class");
+    }
+}
+
+std::shared_ptr<PythonObject> PythonClass::instantiateWith(const py::tuple& args) {
+    PyObject* instance = PyObject_Call(m_type.ptr(), args.ptr(), nullptr);
+    try {
+        return std::make_shared<PythonObject>(detail::unpackResult<py::object>(instance), shared_from_this());
+    } catch (const py::error_already_set& e) {
+        auto error_info = ErrorHandler::handlePythonException(e);
+        ErrorHandler::convertPythonException(error_info);
+        throw; // Should not be reached
+    }
+}
+
+const PythonClass::Method& PythonClass::method(const std::string& name) {
+    {
+        std::lock_guard<std::mutex> lock(m_methods_mutex);
+        auto it = m_methods.find(name);
+        if (it != m_methods.end()) {
+            return *it->second;
+        }
+    }
+
+    // 解析过程会执行 Python 代码，不能持有锁
+    auto resolved = std::make_unique<Method>(resolve(name));
+    std::lock_guard<std::mutex> lock(m_methods_mutex);
+    return *m_methods.emplace(name, std::move(resolved)).first->second;
+}
+
+PythonClass::Method PythonClass::resolve(const std::string& name) const {
+    Method method{name, MethodKind::Attribute, py::object()};
+
+    // 按 MRO 查找原始类属性，不触发描述符
+    py::object raw;
+    try {
+        raw = py::module_::import("inspect").attr("getattr_static")(m_type, name);
+    } catch (const py::error_already_set& e) {
+        if (!e.matches(PyExc_AttributeError)) {
+            auto error_info = ErrorHandler::handlePythonException(e);
+            ErrorHandler::convertPythonException(error_info);
+        }
+        // 实例属性或 __getattr__ 提供的属性，每次调用时在实例上查找
+        return method;
+    }
+
+    PyObject* ptr = raw.ptr();
+    if (PyObject_TypeCheck(ptr, &PyStaticMethod_Type) || PyObject_TypeCheck(ptr, &PyClassMethod_Type)) {
+        method.kind = MethodKind::Static;
+        method.callable = m_type.attr(name.c_str());
+    } else if (PyFunction_Check(ptr) || Py_TYPE(ptr) == &PyMethodDescr_Type ||
+               Py_TYPE(ptr) == &PyWrapperDescr_Type) {
+        method.kind = MethodKind::Unbound;
+        method.callable = std::move(raw);
+    }
+    return method;
+}
+
+const std::string& PythonClass::getName() const {
+    return m_name;
+}
+
+const py::object& PythonClass::type() const {
+    return m_type;
+}
+
+// PythonMethod 实现
+PythonMethod::PythonMethod(py::object self, std::shared_ptr<PythonClass> cls, const PythonClass::Method* method)
+    : m_self(std::move(self)), m_class(std::move(cls)), m_method(method) {}
+
+bool PythonMethod::isValid() const {
+    return m_method != nullptr;
+}
+
+// PythonObject 实现
+PythonObject::PythonObject(py::object instance)
+    : m_instance(std::move(instance)),
+      m_class(std::make_shared<PythonClass>(py::reinterpret_borrow<py::object>(
+          reinterpret_cast<PyObject*>(Py_TYPE(m_instance.ptr()))))) {}
+
+PythonObject::PythonObject(py::object instance, std::shared_ptr<PythonClass> cls)
+    : m_instance(std::move(instance)), m_class(std::move(cls)) {}
+
+PythonMethod PythonObject::method(const std::string& method_name) {
+    return PythonMethod(m_instance, m_class, &m_class->method(method_name));
+}
+
+bool PythonObject::hasAttribute(const std::string& attr_name) const {
+    return py::hasattr(m_instance, attr_name.c_str());
+}
+
+const std::shared_ptr<PythonClass>& PythonObject::getClass() const {
+    return m_class;
+}
+
+const py::object& PythonObject::object() const {
+    return m_instance;
+}
+
+// InstancePool 实现
+InstancePool::Lease::Lease(InstancePool* pool, std::shared_ptr<PythonObject> instance)
+    : m_pool(pool), m_instance(std::move(instance)) {}
+
+InstancePool::Lease::Lease(Lease&& other) noexcept
+    : m_pool(other.m_pool), m_instance(std::move(other.m_instance)) {}
+
+InstancePool::Lease::~Lease() {
+    if (m_instance) {
+        m_pool->giveBack(std::move(m_instance));
+    }
+}
+
+InstancePool::InstancePool(std::shared_ptr<PythonClass> cls, py::tuple args)
+    : m_class(std::move(cls)), m_args(std::move(args)) {}
+
+InstancePool::~InstancePool() {
+    // 释放实例会执行 Python 代码
+    if (Py_IsInitialized()) {
+        py::gil_scoped_acquire gil;
+        m_local.clear();
+        m_idle.clear();
+        py::tuple args = std::move(m_args);
+        m_class.reset();
+    }
+}
+
+std::shared_ptr<PythonObject> InstancePool::local() {
+    const std::thread::id thread_id = std::this_thread::get_id();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_local.find(thread_id);
+        if (it != m_local.end()) {
+            return it->second;
+        }
+    }
+
+    auto instance = m_class->instantiateWith(m_args);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_created;
+    return m_local.emplace(thread_id, std::move(instance)).first->second;
+}
+
+void InstancePool::releaseLocal() {
+    std::shared_ptr<PythonObject> instance;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_local.find(std::this_thread::get_id());
+        if (it == m_local.end()) {
+            return;
+        }
+        instance = std::move(it->second);
+        m_local.erase(it);
+    }
+    // 在锁外释放实例
+}
+
+InstancePool::Lease InstancePool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_idle.empty()) {
+            auto instance = std::move(m_idle.back());
+            m_idle.pop_back();
+            return Lease(this, std::move(instance));
+        }
+    }
+
+    auto instance = m_class->instantiateWith(m_args);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_created;
+    }
+    return Lease(this, std::move(instance));
+}
+
+void InstancePool::giveBack(std::shared_ptr<PythonObject> instance) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_idle.push_back(std::move(instance));
+}
+
+size_t InstancePool::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_created;
+}
+
+size_t InstancePool::available() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_idle.size();
+}
+
+const std::shared_ptr<PythonClass>& InstancePool::getClass() const {
+    return m_class;
+}
+
+} // namespace cpppy_bridge
@@ -1,7 +1,8 @@
 #include "type_converter.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
-#include <typeinfo>
-#include <typeindex>
+#include <mutex>
 
 namespace cpppy_bridge {
 
@@ -143,11 +144,434 @@ size_t NumpyConverter::getArraySize(const py::array& arr) {
     return static_cast<size_t>(arr.size());
 }
 
-// CustomTypeRegistry static member initialization
-std::unordered_map<std::string, std::function<py::object(const void*)>>
-    CustomTypeRegistry::s_to_python_converters;
+// ColumnarTable non-template implementations
+size_t ColumnarTable::numRows() const {
+    return m_rows;
+}
+
+size_t ColumnarTable::numColumns() const {
+    return m_columns.size();
+}
+
+bool ColumnarTable::hasColumn(const std::string& name) const {
+    for (const auto& column : m_columns) {
+        if (column.name == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> ColumnarTable::columnNames() const {
+    std::vector<std::string> names;
+    names.reserve(m_columns.size());
+    for (const auto& column : m_columns) {
+        names.push_back(column.name);
+    }
+    return names;
+}
+
+const std::vector<ColumnarTable::Column>& ColumnarTable::columns() const {
+    return m_columns;
+}
+
+const ColumnarTable::Column& ColumnarTable::findColumn(const std::string& name) const {
+    for (const auto& column : m_columns) {
+        if (column.name == name) {
+            return column;
+        }
+    }
+    throw std::runtime_error("Column not found: " + name);
+}
+
+void ColumnarTable::appendColumn(Column column, size_t length) {
+    if (hasColumn(column.name)) {
+        throw std::runtime_error("Duplicate column: " + column.name);
+    }
+    if (!m_columns.empty() && length != m_rows) {
+        throw std::runtime_error("Column '" + column.name + "' length does not match the table");
+    }
+    m_rows = length;
+    m_columns.push_back(std::move(column));
+}
+
+namespace {
+
+// Arrow column helpers
+size_t arrowItemSize(const char* format) {
+    if (std::strcmp(format, ArrowFormat<double>::value) == 0) return sizeof(double);
+    if (std::strcmp(format, ArrowFormat<float>::value) == 0) return sizeof(float);
+    if (std::strcmp(format, ArrowFormat<int64_t>::value) == 0) return sizeof(int64_t);
+    if (std::strcmp(format, ArrowFormat<int32_t>::value) == 0) return sizeof(int32_t);
+    return 0;
+}
+
+// Map a foreign format string onto the static string stored in ColumnarTable::Column
+const char* canonicalArrowFormat(const char* format) {
+    for (const char* known : {ArrowFormat<double>::value, ArrowFormat<float>::value,
+                              ArrowFormat<int64_t>::value, ArrowFormat<int32_t>::value}) {
+        if (std::strcmp(format, known) == 0) {
+            return known;
+        }
+    }
+    return nullptr;
+}
+
+const char* numpyDtypeName(const char* format) {
+    if (std::strcmp(format, ArrowFormat<double>::value) == 0) return "float64";
+    if (std::strcmp(format, ArrowFormat<float>::value) == 0) return "float32";
+    if (std::strcmp(format, ArrowFormat<int64_t>::value) == 0) return "int64";
+    return "int32";
+}
+
+// Producer-side state; every child owns its own data so consumers may move children out
+struct ExportedChildSchema {
+    std::string name;
+};
+
+struct ExportedStructSchema {
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema*> child_ptrs;
+};
+
+struct ExportedChildArray {
+    std::shared_ptr<const void> owner;
+    const void* buffers[2] = {nullptr, nullptr};
+};
+
+struct ExportedStructArray {
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray*> child_ptrs;
+    const void* buffers[1] = {nullptr};
+};
+
+void releaseChildSchema(ArrowSchema* schema) {
+    delete static_cast<ExportedChildSchema*>(schema->private_data);
+    schema->release = nullptr;
+}
+
+void releaseStructSchema(ArrowSchema* schema) {
+    auto* state = static_cast<ExportedStructSchema*>(schema->private_data);
+    for (auto& child : state->children) {
+        if (child.release) {
+            child.release(&child);
+        }
+    }
+    delete state;
+    schema->release = nullptr;
+}
+
+void releaseChildArray(ArrowArray* array) {
+    delete static_cast<ExportedChildArray*>(array->private_data);
+    array->release = nullptr;
+}
+
+void releaseStructArray(ArrowArray* array) {
+    auto* state = static_cast<ExportedStructArray*>(array->private_data);
+    for (auto& child : state->children) {
+        if (child.release) {
+            child.release(&child);
+        }
+    }
+    delete state;
+    array->release = nullptr;
+}
+
+// PyCapsule protocol: an unconsumed struct is released together with its capsule
+void destroySchemaCapsule(PyObject* capsule) {
+    auto* schema = static_cast<ArrowSchema*>(PyCapsule_GetPointer(capsule, "arrow_schema"));
+    if (schema && schema->release) {
+        schema->release(schema);
+    }
+    delete schema;
+}
+
+void destroyArrayCapsule(PyObject* capsule) {
+    auto* array = static_cast<ArrowArray*>(PyCapsule_GetPointer(capsule, "arrow_array"));
+    if (array && array->release) {
+        array->release(array);
+    }
+    delete array;
+}
+
+py::tuple exportCapsules(const ColumnarTable& table) {
+    auto schema = std::make_unique<ArrowSchema>();
+    auto array = std::make_unique<ArrowArray>();
+    ColumnarConverter::exportTable(table, schema.get(), array.get());
+
+    PyObject* schema_capsule = PyCapsule_New(schema.get(), "arrow_schema", destroySchemaCapsule);
+    if (!schema_capsule) {
+        schema->release(schema.get());
+        array->release(array.get());
+        throw py::error_already_set();
+    }
+    schema.release();
+    py::object schema_obj = py::reinterpret_steal<py::object>(schema_capsule);
+
+    PyObject* array_capsule = PyCapsule_New(array.get(), "arrow_array", destroyArrayCapsule);
+    if (!array_capsule) {
+        array->release(array.get());
+        throw py::error_already_set();
+    }
+    array.release();
+    py::object array_obj = py::reinterpret_steal<py::object>(array_capsule);
+
+    return py::make_tuple(schema_obj, array_obj);
+}
+
+// Register the ColumnarBatch type in the current interpreter on first use
+void ensureColumnarBatchType() {
+    if (py::detail::get_type_info(typeid(ColumnarTable))) {
+        return;
+    }
+
+    static py::module_::module_def module_def;
+    py::module_ m = py::module_::create_extension_module(
+        "_cpppy_columnar", "Columnar tables exported from C++", &module_def);
 
-std::unordered_map<std::string, std::function<void*(const py::object&)>>
-    CustomTypeRegistry::s_from_python_converters;
+    py::class_<ColumnarTable>(m, "ColumnarBatch")
+        .def("__arrow_c_schema__", [](const ColumnarTable& table) {
+            return py::object(exportCapsules(table)[0]);
+        })
+        .def("__arrow_c_array__", [](const ColumnarTable& table, const py::object&) {
+            return exportCapsules(table);
+        }, py::arg("requested_schema") = py::none())
+        .def("__len__", &ColumnarTable::numRows)
+        .def_property_readonly("num_columns", &ColumnarTable::numColumns)
+        .def_property_readonly("column_names", &ColumnarTable::columnNames)
+        .def("column", [](const ColumnarTable& table, const std::string& name) {
+            // Read-only NumPy view that keeps the column buffer alive
+            for (const auto& column : table.columns()) {
+                if (column.name != name) {
+                    continue;
+                }
+                auto owner = std::make_unique<std::shared_ptr<const void>>(column.owner);
+                py::capsule base(owner.get(), [](void* ptr) {
+                    delete static_cast<std::shared_ptr<const void>*>(ptr);
+                });
+                owner.release();
+
+                const py::ssize_t item_size = static_cast<py::ssize_t>(arrowItemSize(column.format));
+                py::array result(py::dtype(numpyDtypeName(column.format)),
+                                 {static_cast<py::ssize_t>(table.numRows())}, {item_size},
+                                 column.data, base);
+                result.attr("setflags")(py::arg("write") = false);
+                return result;
+            }
+            throw py::key_error("Column not found: " + name);
+        }, py::arg("name"));
+
+    py::module::import("sys").attr("modules")["_cpppy_columnar"] = m;
+}
+
+// Release an imported schema on every exit path
+struct SchemaReleaser {
+    ArrowSchema* schema;
+    ~SchemaReleaser() {
+        if (schema && schema->release) {
+            schema->release(schema);
+        }
+    }
+};
+
+} // namespace
+
+// ColumnarConverter non-template implementations
+py::object ColumnarConverter::toArrow(const ColumnarTable& table) {
+    ensureColumnarBatchType();
+    return py::cast(table);
+}
+
+py::object ColumnarConverter::mapToArrow(std::map<std::string, std::vector<double>>&& columns) {
+    ColumnarTable table;
+    for (auto& [name, values] : columns) {
+        table.addColumn(name, std::move(values));
+    }
+    columns.clear();
+    return toArrow(table);
+}
+
+ColumnarTable ColumnarConverter::fromArrow(const py::object& obj) {
+    if (!py::hasattr(obj, "__arrow_c_array__")) {
+        throw std::runtime_error("Object does not implement the Arrow PyCapsule interface (__arrow_c_array__)");
+    }
+
+    py::tuple capsules = obj.attr("__arrow_c_array__")();
+    if (capsules.size() != 2) {
+        throw std::runtime_error("__arrow_c_array__ must return a (schema, array) capsule pair");
+    }
+
+    auto* schema_ptr = static_cast<ArrowSchema*>(PyCapsule_GetPointer(capsules[0].ptr(), "arrow_schema"));
+    if (!schema_ptr) {
+        throw py::error_already_set();
+    }
+    auto* array_ptr = static_cast<ArrowArray*>(PyCapsule_GetPointer(capsules[1].ptr(), "arrow_array"));
+    if (!array_ptr) {
+        throw py::error_already_set();
+    }
+
+    // Move the structs out of the capsules; the capsules no longer release them
+    ArrowSchema schema = *schema_ptr;
+    schema_ptr->release = nullptr;
+    ArrowArray array = *array_ptr;
+    array_ptr->release = nullptr;
+
+    return importTable(&schema, &array);
+}
+
+std::map<std::string, std::vector<double>> ColumnarConverter::toColumnMap(const ColumnarTable& table) {
+    std::map<std::string, std::vector<double>> result;
+    const size_t rows = table.numRows();
+
+    for (const auto& column : table.columns()) {
+        std::vector<double> values(rows);
+        if (std::strcmp(column.format, ArrowFormat<double>::value) == 0) {
+            std::memcpy(values.data(), column.data, rows * sizeof(double));
+        } else if (std::strcmp(column.format, ArrowFormat<float>::value) == 0) {
+            const auto* data = static_cast<const float*>(column.data);
+            std::copy(data, data + rows, values.begin());
+        } else if (std::strcmp(column.format, ArrowFormat<int64_t>::value) == 0) {
+            const auto* data = static_cast<const int64_t*>(column.data);
+            std::copy(data, data + rows, values.begin());
+        } else {
+            const auto* data = static_cast<const int32_t*>(column.data);
+            std::copy(data, data + rows, values.begin());
+        }
+        result.emplace(column.name, std::move(values));
+    }
+    return result;
+}
+
+void ColumnarConverter::exportTable(const ColumnarTable& table, ArrowSchema* schema, ArrowArray* array) {
+    const auto& columns = table.columns();
+    const size_t n = columns.size();
+
+    auto schema_state = std::make_unique<ExportedStructSchema>();
+    auto array_state = std::make_unique<ExportedStructArray>();
+    schema_state->children.resize(n);
+    array_state->children.resize(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        const auto& column = columns[i];
+
+        auto child_schema_state = new ExportedChildSchema{column.name};
+        ArrowSchema& child_schema = schema_state->children[i];
+        child_schema = ArrowSchema{};
+        child_schema.format = column.format;
+        child_schema.name = child_schema_state->name.c_str();
+        child_schema.release = releaseChildSchema;
+        child_schema.private_data = child_schema_state;
+        schema_state->child_ptrs.push_back(&child_schema);
+
+        auto child_array_state = new ExportedChildArray;
+        child_array_state->owner = column.owner;
+        child_array_state->buffers[1] = column.data;
+        ArrowArray& child_array = array_state->children[i];
+        child_array = ArrowArray{};
+        child_array.length = static_cast<int64_t>(table.numRows());
+        child_array.n_buffers = 2;
+        child_array.buffers = child_array_state->buffers;
+        child_array.release = releaseChildArray;
+        child_array.private_data = child_array_state;
+        array_state->child_ptrs.push_back(&child_array);
+    }
+
+    *schema = ArrowSchema{};
+    schema->format = "+s";
+    schema->name = "";
+    schema->n_children = static_cast<int64_t>(n);
+    schema->children = schema_state->child_ptrs.data();
+    schema->release = releaseStructSchema;
+    schema->private_data = schema_state.release();
+
+    *array = ArrowArray{};
+    array->length = static_cast<int64_t>(table.numRows());
+    array->n_buffers = 1;
+    array->n_children = static_cast<int64_t>(n);
+    array->buffers = array_state->buffers;
+    array->children = array_state->child_ptrs.data();
+    array->release = releaseStructArray;
+    array->private_data = array_state.release();
+}
+
+ColumnarTable ColumnarConverter::importTable(ArrowSchema* schema, ArrowArray* array) {
+    SchemaReleaser schema_guard{schema};
+
+    // All columns share ownership of the imported array; it is released with the last one
+    auto moved = std::make_unique<ArrowArray>(*array);
+    array->release = nullptr;
+    std::shared_ptr<const ArrowArray> owner(moved.release(), [](const ArrowArray* ptr) {
+        auto* mutable_ptr = const_cast<ArrowArray*>(ptr);
+        if (mutable_ptr->release) {
+            mutable_ptr->release(mutable_ptr);
+        }
+        delete mutable_ptr;
+    });
+
+    if (std::strcmp(schema->format, "+s") != 0) {
+        throw std::runtime_error("Arrow import expects a struct array (record batch)");
+    }
+    if (schema->n_children != owner->n_children) {
+        throw std::runtime_error("Arrow schema and array have different numbers of columns");
+    }
+
+    ColumnarTable table;
+    const int64_t length = owner->length;
+
+    for (int64_t i = 0; i < schema->n_children; ++i) {
+        const ArrowSchema* child_schema = schema->children[i];
+        const ArrowArray* child = owner->children[i];
+        const std::string name = child_schema->name ? child_schema->name : "";
+
+        const char* format = canonicalArrowFormat(child_schema->format);
+        if (!format) {
+            throw std::runtime_error("Unsupported Arrow type '" + std::string(child_schema->format) +
+                                     "' in column " + name);
+        }
+        if (child->null_count != 0 && child->n_buffers > 0 && child->buffers[0] != nullptr) {
+            throw std::runtime_error("Arrow column '" + name + "' contains nulls");
+        }
+        if (child->n_buffers != 2 || child->length < owner->offset + length) {
+            throw std::runtime_error("Malformed Arrow column: " + name);
+        }
+
+        ColumnarTable::Column column;
+        column.name = name;
+        column.format = format;
+        column.data = static_cast<const char*>(child->buffers[1]) +
+                      (child->offset + owner->offset) * static_cast<int64_t>(arrowItemSize(format));
+        column.owner = owner;
+        table.appendColumn(std::move(column), static_cast<size_t>(length));
+    }
+
+    return table;
+}
+
+// CustomTypeRegistry non-template implementations
+namespace {
+
+struct RetainedConverters {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<const void>> converters;
+};
+
+RetainedConverters& retainedConverters() {
+    static RetainedConverters retained;
+    return retained;
+}
+
+} // namespace
+
+void CustomTypeRegistry::retain(std::shared_ptr<const void> converter) {
+    auto& retained = retainedConverters();
+    std::lock_guard<std::mutex> lock(retained.mutex);
+    retained.converters.push_back(std::move(converter));
+}
+
+size_t CustomTypeRegistry::retainedCount() {
+    auto& retained = retainedConverters();
+    std::lock_guard<std::mutex> lock(retained.mutex);
+    return retained.converters.size();
+}
 
 } // namespace cpppy_bridge
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <string>
+#include "python_bridge.h"
+#include "async_bridge.h"
+
+// Built as C++20 so the co_await interface of AsyncCall is compiled and exercised
+static_assert(CPPPY_HAS_COROUTINES, "test_async_coroutine must be built with coroutine support");
+
+// Eagerly started, self-destroying coroutine that reports through a std::promise
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+template <typename ReturnType>
+DetachedTask awaitCall(cpppy_bridge::AsyncCall<ReturnType> call, std::promise<ReturnType> &result)
+{
+    try
+    {
+        result.set_value(co_await call);
+    }
+    catch (...)
+    {
+        result.set_exception(std::current_exception());
+    }
+}
+
+template <typename ReturnType>
+ReturnType waitReleased(std::future<ReturnType> &future)
+{
+    // The coroutine resumes on the loop thread, which needs the GIL to finish the call
+    py::gil_scoped_release release;
+    assert(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    return future.get();
+}
+
+int main()
+{
+    std::cout << "C++ Python Bridge Coroutine Test" << std::endl;
+    std::cout << "================================" << std::endl;
+
+    {
+        std::ofstream file("coroutine_test_module.py");
+        file << "import asyncio\n\n";
+        file << "async def delayed_double(x):\n    await asyncio.sleep(0.05)\n    return x * 2\n\n";
+        file << "async def fail():\n    await asyncio.sleep(0)\n    raise ValueError('async failure')\n\n";
+        file << "def sync_value():\n    return 7\n";
+    }
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto module = bridge.loadModule("coroutine_test_module");
+
+        // Suspends until the loop thread completes the call
+        cpppy_bridge::PythonFunction delayed_double(module, "delayed_double");
+        std::promise<int> doubled;
+        auto doubled_future = doubled.get_future();
+        awaitCall(delayed_double.callAsync<int>(21), doubled);
+        assert(waitReleased(doubled_future) == 42);
+
+        // Already finished calls do not suspend
+        cpppy_bridge::PythonFunction sync_value(module, "sync_value");
+        std::promise<int> immediate;
+        auto immediate_future = immediate.get_future();
+        awaitCall(sync_value.callAsync<int>(), immediate);
+        assert(immediate_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        assert(immediate_future.get() == 7);
+
+        // Python exceptions are rethrown from co_await
+        cpppy_bridge::PythonFunction fail(module, "fail");
+        std::promise<int> failing;
+        auto failing_future = failing.get_future();
+        awaitCall(fail.callAsync<int>(), failing);
+        bool threw = false;
+        try
+        {
+            waitReleased(failing_future);
+        }
+        catch (const std::exception &e)
+        {
+            threw = std::string(e.what()).find("async failure") != std::string::npos;
+        }
+        assert(threw);
+
+        std::cout << "AsyncCall coroutine tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "AsyncCall coroutine test failed: " << e.what() << std::endl;
+        std::remove("coroutine_test_module.py");
+        return 1;
+    }
+
+    std::remove("coroutine_test_module.py");
+    return 0;
+}
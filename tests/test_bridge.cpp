@@ -1,13 +1,38 @@
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <map>
 #include <string>
+#include <variant>
 #include <fstream>
 #include <filesystem>
+#include <cstdint>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
 #include "python_bridge.h"
 #include "type_converter.h"
 #include "error_handler.h"
+#include "error_log_sink.h"
+#include "python_executor.h"
+#include "interpreter_pool.h"
+#include "typed_function.h"
+#include "async_bridge.h"
+#include "python_stream.h"
+#include "python_object.h"
+#include "numpy_kernels.h"
+#include "process_bridge.h"
+#include "bridge_metrics.h"
+#include "bridge_memory.h"
+#include "bridge_allocator.h"
+#include <memory_resource>
+#if defined(__linux__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 class TestRunner
 {
@@ -57,17 +82,74 @@ void testPythonInterpreter()
     assert(!interpreter.isInitialized());
     interpreter.initialize();
     assert(interpreter.isInitialized());
+    assert(interpreter.isReady());
+    assert(interpreter.getStartupStats().interpreter_init.count() > 0);
 
     // Test code execution
     py::object result = interpreter.execute("2 + 3");
     assert(result.cast<int>() == 5);
 
-    // Test adding module path
+    // Test adding module path (added only once)
     interpreter.addModulePath("./test_path");
+    interpreter.addModulePath("./test_path");
+    assert(interpreter.execute("__import__('sys').path.count('./test_path')").cast<int>() == 1);
 
     std::cout << "PythonInterpreter tests passed" << std::endl;
 }
 
+void testStartupProfile()
+{
+    auto &interpreter = cpppy_bridge::PythonInterpreter::getInstance();
+    assert(interpreter.isInitialized());
+
+    auto contains = [](const std::vector<std::string> &names, const std::string &name)
+    {
+        return std::find(names.begin(), names.end(), name) != names.end();
+    };
+
+    // Preloading is synchronous by default and keeps the GIL with the caller
+    cpppy_bridge::StartupProfile profile;
+    assert(!profile.async_preload);
+    profile.preload_modules = {"json", "missing_preload_module"};
+    interpreter.initialize(profile);
+    assert(interpreter.isReady());
+    assert(cpppy_bridge::PythonInterpreter::holdsGIL());
+    auto stats = interpreter.getStartupStats();
+    assert(contains(stats.preloaded, "json"));
+    assert(contains(stats.failed_preloads, "missing_preload_module"));
+
+    // Background preloading hands the GIL back in waitUntilReady()
+    profile.preload_modules = {"decimal"};
+    profile.async_preload = true;
+    interpreter.initialize(profile);
+
+    // A second profile from another thread imports synchronously instead of
+    // replacing the running preload thread
+    std::thread other([&interpreter]()
+                      {
+        cpppy_bridge::StartupProfile again;
+        again.preload_modules = {"fractions"};
+        again.async_preload = true;
+        interpreter.initialize(again); });
+    other.join();
+
+    interpreter.waitUntilReady();
+    assert(interpreter.isReady());
+    assert(cpppy_bridge::PythonInterpreter::holdsGIL());
+    stats = interpreter.getStartupStats();
+    assert(contains(stats.preloaded, "decimal") && contains(stats.preloaded, "fractions"));
+
+    // The owning thread can start another background preload once it is ready
+    profile.preload_modules = {"statistics"};
+    interpreter.initialize(profile);
+    interpreter.initialize(profile);
+    interpreter.waitUntilReady();
+    assert(cpppy_bridge::PythonInterpreter::holdsGIL());
+    assert(interpreter.execute("__import__('sys').modules['statistics'].__name__").cast<std::string>() == "statistics");
+
+    std::cout << "StartupProfile tests passed" << std::endl;
+}
+
 void testPythonModule()
 {
     // Create a test Python file
@@ -128,6 +210,12 @@ test_variable = 42
     std::remove("test_module.py");
 }
 
+// Type without a Python binding, for conversion failure tests
+struct UnboundPoint
+{
+    int x;
+};
+
 void testPythonFunction()
 {
     // Create test module
@@ -162,6 +250,38 @@ def greet(name):
         std::string greeting = greet_func.call<std::string>("World");
         assert(greeting == "Hello, World!");
 
+        // Test fixed-signature vectorcall invoker
+        cpppy_bridge::TypedFunction<double(double, double)> typed_multiply(module, "multiply");
+        assert(typed_multiply.isValid());
+        assert(std::abs(typed_multiply(3.5, 2.0) - 7.0) < 0.001);
+        cpppy_bridge::TypedFunction<std::string(std::string)> typed_greet(module, "greet");
+        assert(typed_greet("Typed") == "Hello, Typed!");
+
+        // A failed argument conversion is raised right away, before later arguments are converted
+        cpppy_bridge::TypedFunction<double(UnboundPoint, UnboundPoint)> typed_unbound(module, "multiply");
+        bool conversion_failed = false;
+        try
+        {
+            typed_unbound(UnboundPoint{1}, UnboundPoint{2});
+        }
+        catch (const std::exception &)
+        {
+            conversion_failed = true;
+        }
+        assert(conversion_failed && !PyErr_Occurred());
+
+        // Test batched calls in both modes
+        std::vector<std::tuple<double, double>> batch = {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}};
+        auto per_call = multiply_func.callBatch<double>(batch);
+        auto vectorized = multiply_func.callBatch<double>(batch, cpppy_bridge::BatchMode::Vectorized);
+        assert(per_call.size() == 3 && vectorized.size() == 3);
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            double expected = std::get<0>(batch[i]) * std::get<1>(batch[i]);
+            assert(std::abs(per_call[i] - expected) < 0.001);
+            assert(std::abs(vectorized[i] - expected) < 0.001);
+        }
+
         std::cout << "PythonFunction tests passed" << std::endl;
     }
     catch (const std::exception &e)
@@ -217,6 +337,20 @@ def process_dict(data):
         py::object code_result = bridge.executeCode("3 * 4");
         assert(code_result.cast<int>() == 12);
 
+        // Test pre-resolved call handles and their invalidation
+        auto handle = bridge.resolve("bridge_test_module", "add_numbers");
+        assert(handle.isValid());
+        assert(handle.call<int>(2, 3) == 5);
+        uint64_t generation = handle.getGeneration();
+
+        module->setAttribute("add_numbers", module->getAttribute("process_dict"));
+        auto doubled = handle.call<std::map<std::string, int>>(std::map<std::string, int>{{"x", 4}});
+        assert(doubled["x"] == 8);
+        assert(handle.getGeneration() != generation);
+
+        assert(module->reload());
+        assert(handle.call<int>(2, 3) == 5);
+
         std::cout << "PythonBridge tests passed" << std::endl;
     }
     catch (const std::exception &e)
@@ -255,6 +389,55 @@ void testTypeConverter()
     assert(cpppy_bridge::TypeConverter::canConvert<double>(py_double));
     assert(cpppy_bridge::TypeConverter::canConvert<std::string>(py_string));
     assert(cpppy_bridge::TypeConverter::canConvert<bool>(py_bool));
+    assert(!cpppy_bridge::TypeConverter::canConvert<double>(py_string));
+    assert(!cpppy_bridge::TypeConverter::canConvert<std::vector<int>>(py_int));
+    assert(cpppy_bridge::TypeConverter::canConvert<std::vector<int>>(py::make_tuple(1, 2)));
+    assert(!PyErr_Occurred());
+
+    // Bulk paths accept numpy scalars like the element casters do
+    auto numpy_ints = cpppy_bridge::TypeConverter::fromPython<std::vector<int64_t>>(
+        py::eval("list(__import__('numpy').arange(3))"));
+    assert(numpy_ints.size() == 3 && numpy_ints[2] == 2);
+    auto numpy_floats = cpppy_bridge::TypeConverter::fromPython<std::map<std::string, double>>(
+        py::eval("{'x': __import__('numpy').float32(0.5)}"));
+    assert(numpy_floats.at("x") == 0.5);
+
+    // Distinct Python keys converting to the same C++ key: the last one wins
+    auto flags = cpppy_bridge::TypeConverter::fromPython<std::map<bool, std::string>>(py::eval("{2: 'first', 3: 'last'}"));
+    assert(flags.size() == 1 && flags.at(true) == "last");
+
+    // Variants pick the first alternative with an exact type match, then the first convertible one
+    using Payload = std::variant<std::monostate, bool, int, double, std::string, std::vector<std::string>,
+                                 std::vector<double>>;
+    auto payload = [](const py::object &obj) { return cpppy_bridge::TypeConverter::fromPython<Payload>(obj); };
+    assert(std::holds_alternative<std::monostate>(payload(py::none())));
+    assert(std::get<bool>(payload(py_bool)) == true);
+    assert(std::get<int>(payload(py_int)) == 42);
+    assert(std::get<double>(payload(py_double)) == 3.14);
+    assert(std::get<std::string>(payload(py_string)) == "Hello");
+    assert(std::get<std::vector<double>>(payload(py::eval("[1.5, 2.5]"))).size() == 2);
+    assert(std::get<std::vector<std::string>>(payload(py::eval("('a', 'b')"))).size() == 2);
+    assert(std::get<std::vector<std::string>>(payload(py::list())).empty());
+
+    // A matching type whose value does not load falls through to later alternatives
+    using Wide = std::variant<int, long long>;
+    assert(std::get<long long>(cpppy_bridge::TypeConverter::fromPython<Wide>(py::eval("2 ** 40"))) == (1LL << 40));
+    using Series = std::variant<std::vector<int>, std::vector<double>>;
+    auto series = cpppy_bridge::TypeConverter::fromPython<Series>(py::eval("[1, 2.5]"));
+    assert(std::get<std::vector<double>>(series)[1] == 2.5);
+    assert(!PyErr_Occurred());
+
+    using Numeric = std::variant<double, std::string>;
+    assert(std::get<double>(cpppy_bridge::ComplexTypeConverter::variantFromPython<double, std::string>(py_int)) == 42.0);
+    assert(std::holds_alternative<std::string>(cpppy_bridge::TypeConverter::fromPython<Numeric>(py::bytes("raw"))));
+    try
+    {
+        cpppy_bridge::TypeConverter::fromPython<Numeric>(py::dict());
+        assert(false);
+    }
+    catch (const std::runtime_error &)
+    {
+    }
 
     // Test safe conversion
     auto safe_int = cpppy_bridge::TypeConverter::safeCast<int>(py_int);
@@ -264,6 +447,21 @@ void testTypeConverter()
     auto safe_fail = cpppy_bridge::TypeConverter::safeCast<int>(py_string);
     assert(!safe_fail.has_value());
 
+    // Test custom type converters
+    struct Point { double x, y; };
+    assert(!cpppy_bridge::CustomTypeRegistry::hasToPythonConverter<Point>());
+    REGISTER_CUSTOM_TYPE_CONVERTER(
+        Point,
+        [](const Point& p) -> py::object { return py::make_tuple(p.x, p.y); },
+        [](const py::object& obj) { auto t = obj.cast<py::tuple>(); return Point{t[0].cast<double>(), t[1].cast<double>()}; }
+    );
+    assert(cpppy_bridge::CustomTypeRegistry::hasToPythonConverter<Point>());
+    assert(cpppy_bridge::CustomTypeRegistry::hasFromPythonConverter<Point>());
+    py::object py_point = cpppy_bridge::TypeConverter::toPython(Point{1.5, -2.0});
+    Point cpp_point = cpppy_bridge::TypeConverter::fromPython<Point>(py_point);
+    assert(cpp_point.x == 1.5 && cpp_point.y == -2.0);
+    static_assert(!cpppy_bridge::CustomConvertible<double>::value, "scalars skip the registry");
+
     std::cout << "TypeConverter tests passed" << std::endl;
 }
 
@@ -294,7 +492,7 @@ def value_error():
 
         // Test error callback
         bool callback_triggered = false;
-        cpppy_bridge::ErrorHandler::addErrorCallback([&callback_triggered](const cpppy_bridge::PythonErrorInfo &info)
+        auto callback_token = cpppy_bridge::ErrorHandler::addErrorCallback([&callback_triggered](const cpppy_bridge::PythonErrorInfo &info)
                                                      {
             callback_triggered = true;
             assert(!info.type.empty());
@@ -334,12 +532,85 @@ def value_error():
         }
 
         assert(callback_triggered);
+        assert(cpppy_bridge::ErrorHandler::removeErrorCallback(callback_token));
+        assert(!cpppy_bridge::ErrorHandler::removeErrorCallback(callback_token));
+
+        // Test scoped callbacks remove exactly their own entry
+        const size_t base_callbacks = cpppy_bridge::ErrorHandler::errorCallbackCount();
+        int outer_calls = 0;
+        int inner_calls = 0;
+        {
+            cpppy_bridge::ScopedErrorHandler outer([&outer_calls](const cpppy_bridge::PythonErrorInfo &)
+                                                   { ++outer_calls; });
+            {
+                cpppy_bridge::ScopedErrorHandler inner([&inner_calls](const cpppy_bridge::PythonErrorInfo &)
+                                                       { ++inner_calls; });
+                assert(cpppy_bridge::ErrorHandler::errorCallbackCount() == base_callbacks + 2);
+                cpppy_bridge::ErrorHandler::safeExecuteOptional([]()
+                                                               { return py::object(py::eval("1 / 0")); });
+            }
+            assert(cpppy_bridge::ErrorHandler::errorCallbackCount() == base_callbacks + 1);
+            cpppy_bridge::ErrorHandler::safeExecuteOptional([]()
+                                                           { return py::object(py::eval("1 / 0")); });
+        }
+        assert(cpppy_bridge::ErrorHandler::errorCallbackCount() == base_callbacks);
+        assert(outer_calls == 2);
+        assert(inner_calls == 1);
+
+        // Test registration while other threads trigger callbacks
+        {
+            std::atomic<int> concurrent_calls{0};
+            cpppy_bridge::ScopedErrorHandler counter([&concurrent_calls](const cpppy_bridge::PythonErrorInfo &)
+                                                     { ++concurrent_calls; });
+            cpppy_bridge::ErrorHandler::setErrorLogging(false);
+            py::gil_scoped_release release;
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t)
+            {
+                threads.emplace_back([]()
+                                     {
+                    for (int i = 0; i < 25; ++i) {
+                        py::gil_scoped_acquire acquire;
+                        cpppy_bridge::ErrorHandler::safeExecuteOptional([]()
+                                                                       { return py::object(py::eval("1 / 0")); });
+                    } });
+            }
+            for (int i = 0; i < 200; ++i)
+            {
+                cpppy_bridge::ScopedErrorHandler transient([](const cpppy_bridge::PythonErrorInfo &) {});
+            }
+            for (auto &thread : threads)
+            {
+                thread.join();
+            }
+            assert(concurrent_calls == 100);
+            cpppy_bridge::ErrorHandler::setErrorLogging(true);
+        }
+        assert(cpppy_bridge::ErrorHandler::errorCallbackCount() == base_callbacks);
 
         // Test safe execution
         auto safe_result = cpppy_bridge::ErrorHandler::safeExecuteOptional([&]()
                                                                            { return module->callFunction<double>("divide_by_zero"); });
         assert(!safe_result.has_value());
 
+        // Test lazily formatted error details shared between copies
+        try
+        {
+            module->getAttribute("value_error")();
+            assert(false); // Should not be reached
+        }
+        catch (const py::error_already_set &e)
+        {
+            auto info = cpppy_bridge::ErrorHandler::extractPythonErrorInfo(e);
+            assert(info.type == "ValueError");
+            assert(info.message == "Test value error");
+            auto copy = info;
+            assert(copy.function() == "value_error");
+            assert(copy.line() > 0);
+            assert(&copy.traceback() == &info.traceback());
+            assert(info.traceback().find("value_error") != std::string::npos);
+        }
+
         std::cout << "ErrorHandling tests passed" << std::endl;
     }
     catch (const std::exception &e)
@@ -352,6 +623,78 @@ def value_error():
     std::remove("error_test_module.py");
 }
 
+void testErrorLogSink()
+{
+    cpppy_bridge::PythonBridge bridge;
+    bridge.initialize();
+
+    // Capture JSON lines synchronously
+    std::mutex lines_mutex;
+    std::vector<std::string> lines;
+    auto capture = std::make_shared<cpppy_bridge::FunctionLogSink>([&](const cpppy_bridge::ErrorLogRecord &record)
+                                                                  {
+        std::lock_guard<std::mutex> lock(lines_mutex);
+        lines.push_back(cpppy_bridge::ErrorLogSink::format(record, cpppy_bridge::LogFormat::JsonLines)); });
+    cpppy_bridge::ErrorHandler::setLogSink(std::make_shared<cpppy_bridge::AsyncLogSink>(capture, 8));
+    cpppy_bridge::ErrorHandler::setErrorRateLimit(2);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        auto result = cpppy_bridge::ErrorHandler::safeExecuteOptional([]()
+                                                                      { return py::object(py::eval("int('not a number')")); });
+        assert(!result.has_value());
+    }
+    cpppy_bridge::ErrorHandler::flushErrorLog();
+
+    // At most two records per type and second pass the rate limiter (the loop may straddle two windows)
+    assert(!lines.empty() && lines.size() <= 4);
+    assert(lines[0].front() == '{' && lines[0].back() == '}');
+    assert(lines[0].find("\"type\":\"ValueError\"") != std::string::npos);
+
+    // The writer thread never needs the GIL: records arrive while this thread keeps holding it
+    std::atomic<int> written{0};
+    std::atomic<bool> has_traceback{false};
+    cpppy_bridge::ErrorHandler::setErrorRateLimit(0);
+    cpppy_bridge::ErrorHandler::setLogSink(std::make_shared<cpppy_bridge::AsyncLogSink>(
+        std::make_shared<cpppy_bridge::FunctionLogSink>([&](const cpppy_bridge::ErrorLogRecord &record)
+                                                        {
+            has_traceback = !record.info.traceback().empty();
+            ++written; })));
+    auto raised = cpppy_bridge::ErrorHandler::safeExecuteOptional([]()
+                                                                  { return py::object(py::module_::import("json").attr("loads")("{")); });
+    assert(!raised.has_value());
+    for (int i = 0; i < 200 && written < 1; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(written == 1 && has_traceback);
+    cpppy_bridge::ErrorHandler::setErrorRateLimit(2);
+
+    // Callbacks can run on a background thread
+    std::atomic<int> async_calls{0};
+    std::thread::id caller = std::this_thread::get_id();
+    std::atomic<bool> off_thread{false};
+    cpppy_bridge::ErrorHandler::setAsyncCallbacks(true);
+    auto async_token = cpppy_bridge::ErrorHandler::addErrorCallback([&](const cpppy_bridge::PythonErrorInfo &)
+                                                                    {
+        off_thread = std::this_thread::get_id() != caller;
+        ++async_calls; });
+    auto failed = cpppy_bridge::ErrorHandler::safeExecuteOptional([]()
+                                                                  { return py::object(py::eval("1 / 0")); });
+    assert(!failed.has_value());
+    cpppy_bridge::ErrorHandler::flushErrorLog();
+    assert(async_calls >= 1);
+    assert(off_thread);
+
+    cpppy_bridge::ErrorHandler::setAsyncCallbacks(false);
+    cpppy_bridge::ErrorHandler::removeErrorCallback(async_token);
+    cpppy_bridge::ErrorHandler::setErrorRateLimit(0);
+    cpppy_bridge::ErrorHandler::setLogSink(std::make_shared<cpppy_bridge::AsyncLogSink>(
+        std::make_shared<cpppy_bridge::StreamLogSink>(std::cerr)));
+
+    std::cout << "ErrorLogSink tests passed" << std::endl;
+}
+
 void testComplexDataTypes()
 {
     // Create test module
@@ -419,6 +762,32 @@ def process_nested(data):
         assert(nested_result["group2"] == 22);
         assert(nested_result["group3"] == 17);
 
+        // Test bulk container conversion paths
+        std::vector<double> doubles = {0.5, 1.5, 2.5};
+        py::object py_doubles = cpppy_bridge::ComplexTypeConverter::vectorToPython(doubles);
+        assert(py::len(py_doubles) == 3);
+        assert(cpppy_bridge::ComplexTypeConverter::vectorFromPython<double>(py_doubles) == doubles);
+        py::object py_array = py::module::import("array").attr("array")("d", py_doubles);
+        assert(cpppy_bridge::ComplexTypeConverter::vectorFromPython<double>(py_array) == doubles);
+        py::object py_int_tuple = py::make_tuple(1, 2, 3);
+        assert(cpppy_bridge::ComplexTypeConverter::vectorFromPython<int>(py_int_tuple) == std::vector<int>({1, 2, 3}));
+
+        // char keeps pybind11's one-character str conversion; signed and unsigned char stay integers
+        std::vector<char> chars = {'a', 'b'};
+        py::object py_chars = cpppy_bridge::ComplexTypeConverter::vectorToPython(chars);
+        assert(py::isinstance<py::str>(py_chars[py::int_(0)]) && py_chars[py::int_(1)].cast<std::string>() == "b");
+        assert(cpppy_bridge::ComplexTypeConverter::vectorFromPython<char>(py_chars) == chars);
+        py::object py_char = py::reinterpret_steal<py::object>(cpppy_bridge::detail::toOwnedPyObject('c'));
+        assert(py::isinstance<py::str>(py_char) && py_char.cast<std::string>() == "c");
+        std::vector<signed char> small_ints = {1, -2};
+        py::object py_small_ints = cpppy_bridge::ComplexTypeConverter::vectorToPython(small_ints);
+        assert(py_small_ints[py::int_(1)].cast<int>() == -2);
+
+        std::unordered_map<std::string, int> input_umap = {{"x", 1}, {"y", 2}};
+        py::object py_umap = cpppy_bridge::ComplexTypeConverter::mapToPython(input_umap);
+        auto result_umap = cpppy_bridge::ComplexTypeConverter::unorderedMapFromPython<std::string, int>(py_umap);
+        assert(result_umap == input_umap);
+
         std::cout << "ComplexDataTypes tests passed" << std::endl;
     }
     catch (const std::exception &e)
@@ -431,8 +800,1544 @@ def process_nested(data):
     std::remove("complex_test_module.py");
 }
 
-int main()
+void testPythonExecutor()
+{
+    std::string executor_module_content = R"(
+def scale(x, factor):
+    return x * factor
+)";
+
+    std::ofstream temp_file("executor_test_module.py");
+    temp_file << executor_module_content;
+    temp_file.close();
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto func = bridge.createFunction("executor_test_module", "scale");
+        assert(func != nullptr && func->isValid());
+
+        std::vector<std::future<int>> futures;
+        {
+            cpppy_bridge::PythonExecutor executor(4, 8);
+
+            // Worker threads need the GIL while the main thread waits
+            py::gil_scoped_release release;
+
+            std::vector<std::thread> submitters;
+            std::mutex futures_mutex;
+            for (int t = 0; t < 4; ++t)
+            {
+                submitters.emplace_back([&, t]() {
+                    for (int i = 0; i < 25; ++i)
+                    {
+                        auto future = executor.submit<int>(func, t * 100 + i, 2);
+                        std::lock_guard<std::mutex> lock(futures_mutex);
+                        futures.push_back(std::move(future));
+                    }
+                });
+            }
+            for (auto &submitter : submitters)
+            {
+                submitter.join();
+            }
+
+            long long total = 0;
+            for (auto &future : futures)
+            {
+                total += future.get();
+            }
+            // sum over t of 2 * (25 * 100 * t + 0 + ... + 24)
+            assert(total == 2 * (2500LL * (0 + 1 + 2 + 3) + 4 * 300));
+
+            executor.shutdown();
+            assert(!executor.isRunning());
+        }
+
+        // Python object arguments are copied here and released by the worker under the GIL
+        {
+            cpppy_bridge::PythonExecutor executor(1, 4);
+            py::object value = py::int_(21);
+            auto future = executor.submit<int>(func, value, py::int_(2));
+            py::gil_scoped_release release;
+            assert(future.get() == 42);
+        }
+
+        std::cout << "PythonExecutor tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "PythonExecutor test failed: " << e.what() << std::endl;
+        std::remove("executor_test_module.py");
+        throw;
+    }
+
+    std::remove("executor_test_module.py");
+}
+
+void testInterpreterPool()
+{
+    std::string pool_module_content = R"(
+def square_sum(n):
+    return sum(i * i for i in range(n))
+)";
+
+    std::ofstream temp_file("pool_test_module.py");
+    temp_file << pool_module_content;
+    temp_file.close();
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize({"."});
+        auto pool = bridge.createInterpreterPool(2);
+        assert(pool != nullptr);
+        assert(pool->size() == (cpppy_bridge::InterpreterPool::subInterpretersSupported() ? 2u : 1u));
+
+        int result = pool->callFunction<int>("pool_test_module", "square_sum", 10);
+        assert(result == 285);
+
+        int second = pool->callFunction<int>("pool_test_module", "square_sum", 4);
+        assert(second == 14);
+
+        uint64_t total_calls = 0;
+        for (const auto &stats : pool->getStats())
+        {
+            assert(!stats.busy);
+            total_calls += stats.calls;
+        }
+        assert(total_calls == 2);
+
+        pool.reset();
+        std::cout << "InterpreterPool tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "InterpreterPool test failed: " << e.what() << std::endl;
+        std::remove("pool_test_module.py");
+        throw;
+    }
+
+    std::remove("pool_test_module.py");
+}
+
+void testNumpyZeroCopy()
+{
+    cpppy_bridge::PythonBridge bridge;
+    bridge.initialize();
+
+    // Moving a vector into NumPy must not copy the buffer
+    std::vector<double> values = {1.0, 2.0, 3.0, 4.0};
+    const double *original = values.data();
+    py::array_t<double> arr = cpppy_bridge::NumpyConverter::vectorToNumpy(std::move(values));
+    assert(arr.data() == original);
+    assert(arr.size() == 4);
+
+    auto view = cpppy_bridge::NumpyConverter::view<double>(arr);
+    assert(view.isContiguous());
+    assert(view.data() == original);
+    assert(view[2] == 3.0);
+
+    // Shared buffers stay alive while either side holds them
+    std::shared_ptr<int[]> shared(new int[3]{7, 8, 9});
+    auto shared_arr = cpppy_bridge::NumpyConverter::sharedToNumpy(shared, 3);
+    shared.reset();
+    assert(cpppy_bridge::NumpyConverter::numpyToVector(shared_arr) == std::vector<int>({7, 8, 9}));
+
+    // Strided arrays are read without assuming C-contiguous layout
+    py::array strided = bridge.executeCode("__import__('numpy').arange(10.0)[::2]");
+    auto strided_view = cpppy_bridge::NumpyConverter::view<double>(strided);
+    assert(!strided_view.isContiguous());
+    auto strided_vec = cpppy_bridge::NumpyConverter::numpyToVector<double>(strided);
+    assert(strided_vec == std::vector<double>({0.0, 2.0, 4.0, 6.0, 8.0}));
+
+    py::array transposed = bridge.executeCode("__import__('numpy').arange(6.0).reshape(2, 3).T");
+    auto matrix = cpppy_bridge::NumpyConverter::numpyToMatrix2D<double>(transposed);
+    assert(matrix.size() == 3 && matrix[0].size() == 2);
+    assert(matrix[0][1] == 3.0 && matrix[2][0] == 2.0);
+
+    std::cout << "NumpyZeroCopy tests passed" << std::endl;
+}
+
+void testNumpyKernels()
+{
+    cpppy_bridge::PythonBridge bridge;
+    bridge.initialize();
+
+    auto close = [](double a, double b) { return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b)); };
+
+    // Results match numpy_operations() for every supported dtype
+    for (const char *dtype : {"float64", "float32", "int64", "int32"})
+    {
+        py::dict locals;
+        locals["dtype"] = dtype;
+        py::array arr = bridge.executeCode("__import__('numpy').arange(-500, 1500, dtype=dtype) % 97", locals);
+        py::dict expected = bridge.executeCode(
+            "dict(mean=float(np.mean(arr)), std=float(np.std(arr)), min=float(np.min(arr)), "
+            "max=float(np.max(arr)), sum=float(np.sum(arr)))",
+            py::dict(py::arg("arr") = arr, py::arg("np") = py::module_::import("numpy")));
+
+        auto stats = cpppy_bridge::NumpyKernels::stats(arr);
+        assert(stats.count == 2000);
+        assert(close(stats.mean, expected["mean"].cast<double>()));
+        assert(close(stats.stddev, expected["std"].cast<double>()));
+        assert(stats.min == expected["min"].cast<double>());
+        assert(stats.max == expected["max"].cast<double>());
+        assert(close(stats.sum, expected["sum"].cast<double>()));
+    }
+
+    // Every instruction set and the threaded path agree
+    std::vector<double> values(300001);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<double>((i * 7919) % 1000) * 0.25 - 60.0;
+    }
+    cpppy_bridge::KernelOptions serial;
+    serial.parallel_threshold = 0;
+    const auto reference = cpppy_bridge::NumpyKernels::stats(values.data(), values.size(), serial);
+    const auto detected = cpppy_bridge::NumpyKernels::detectedSimdLevel();
+    for (auto level : {cpppy_bridge::SimdLevel::Scalar, cpppy_bridge::SimdLevel::SSE2, cpppy_bridge::SimdLevel::AVX2,
+                       cpppy_bridge::SimdLevel::AVX512, cpppy_bridge::SimdLevel::NEON})
+    {
+        cpppy_bridge::NumpyKernels::setSimdLevel(level);
+        cpppy_bridge::KernelOptions threaded;
+        threaded.parallel_threshold = 1 << 16;
+        threaded.max_threads = 4;
+        for (const auto &options : {serial, threaded})
+        {
+            auto stats = cpppy_bridge::NumpyKernels::stats(values.data(), values.size(), options);
+            assert(close(stats.mean, reference.mean) && close(stats.stddev, reference.stddev));
+            assert(stats.min == reference.min && stats.max == reference.max);
+        }
+    }
+    cpppy_bridge::NumpyKernels::setSimdLevel(detected);
+    assert(cpppy_bridge::NumpyKernels::simdLevel() == detected);
+
+    // Large arrays release the GIL; non-contiguous arrays are handled
+    py::array large = cpppy_bridge::NumpyConverter::vectorToNumpy(values);
+    assert(close(cpppy_bridge::NumpyKernels::mean(large), reference.mean));
+    py::array strided = bridge.executeCode("__import__('numpy').arange(10.0)[::2]");
+    assert(cpppy_bridge::NumpyKernels::sum(strided) == 20.0);
+    assert(cpppy_bridge::NumpyKernels::max(strided) == 8.0);
+
+    // NaN propagates; empty arrays follow NumPy
+    py::array with_nan = bridge.executeCode("__import__('numpy').array([1.0, float('nan'), 3.0])");
+    assert(std::isnan(cpppy_bridge::NumpyKernels::min(with_nan)));
+    py::array empty = bridge.executeCode("__import__('numpy').zeros(0)");
+    assert(cpppy_bridge::NumpyKernels::sum(empty) == 0.0);
+    assert(std::isnan(cpppy_bridge::NumpyKernels::mean(empty)));
+    try
+    {
+        cpppy_bridge::NumpyKernels::min(empty);
+        assert(false);
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+
+    try
+    {
+        cpppy_bridge::NumpyKernels::stats(bridge.executeCode("__import__('numpy').zeros(4, dtype='uint8')"));
+        assert(false);
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+
+    std::cout << "NumpyKernels tests passed" << std::endl;
+}
+
+void testMatrixConversion()
+{
+    cpppy_bridge::PythonBridge bridge;
+    bridge.initialize();
+
+    cpppy_bridge::Matrix<double> matrix(2, 3, true);
+    assert(reinterpret_cast<std::uintptr_t>(matrix.data()) % 64 == 0);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            matrix(i, j) = static_cast<double>(i * 3 + j);
+        }
+    }
+
+    // Matrix -> NumPy shares the buffer
+    auto arr = cpppy_bridge::NumpyConverter::matrixToNumpy(matrix);
+    assert(arr.data() == matrix.data());
+    assert(arr.shape(0) == 2 && arr.shape(1) == 3);
+
+    // NumPy -> Matrix shares the buffer and keeps strides
+    auto round_trip = cpppy_bridge::NumpyConverter::numpyToMatrix(arr);
+    assert(round_trip.data() == matrix.data());
+    assert(round_trip(1, 2) == 5.0);
+
+    py::array transposed = py::object(arr.attr("T"));
+    auto transposed_matrix = cpppy_bridge::ComplexTypeConverter::matrixFromPython<double>(transposed);
+    assert(transposed_matrix.rows() == 3 && !transposed_matrix.isContiguous());
+    assert(transposed_matrix(2, 1) == 5.0);
+
+    // Nested lists convert with a single allocation
+    py::object nested = cpppy_bridge::ComplexTypeConverter::matrixToPython(matrix);
+    auto from_lists = cpppy_bridge::ComplexTypeConverter::matrixFromPython<double>(nested);
+    assert(from_lists.isContiguous() && from_lists(1, 0) == 3.0);
+
+    std::cout << "MatrixConversion tests passed" << std::endl;
+}
+
+void testConversionArena()
+{
+    cpppy_bridge::PythonBridge bridge;
+    bridge.initialize();
+
+    cpppy_bridge::ConversionArena arena(4096);
+
+    // Nothing may fall back to the default resource
+    std::pmr::memory_resource *previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    try
+    {
+        auto values = cpppy_bridge::ComplexTypeConverter::vectorFromPython<double>(
+            py::eval("[float(i) for i in range(1000)]"), &arena);
+        assert(values.size() == 1000 && values[999] == 999.0);
+        assert(values.get_allocator().resource() == &arena);
+
+        auto buffered = cpppy_bridge::ComplexTypeConverter::vectorFromPython<int32_t>(
+            py::module_::import("array").attr("array")("i", py::make_tuple(1, 2, 3)), &arena);
+        assert(buffered.size() == 3 && buffered[2] == 3);
+
+        py::array_t<double> grid = py::module_::import("numpy").attr("arange")(12.0).attr("reshape")(3, 4);
+        auto rows = cpppy_bridge::NumpyConverter::numpyToMatrix2D(grid, &arena);
+        assert(rows.size() == 3 && rows[2][3] == 11.0);
+        assert(rows[1].get_allocator().resource() == &arena);
+
+        py::array_t<double> column = py::object(py::object(grid.attr("T"))[py::int_(1)]);
+        auto strided = cpppy_bridge::NumpyConverter::numpyToVector(column, &arena);
+        assert(strided.size() == 3 && strided[2] == 9.0);
+
+        auto counts = cpppy_bridge::ComplexTypeConverter::unorderedMapFromPython<int, int>(
+            py::eval("{1: 10, 2: 20}"), &arena);
+        auto ordered = cpppy_bridge::ComplexTypeConverter::mapFromPython<int, double>(
+            py::eval("{3: 0.5, 1: 1.5}"), &arena);
+        assert(counts.at(2) == 20 && ordered.begin()->first == 1);
+    }
+    catch (...)
+    {
+        std::pmr::set_default_resource(previous);
+        throw;
+    }
+    std::pmr::set_default_resource(previous);
+
+    assert(arena.bytesAllocated() >= 1000 * sizeof(double) + 12 * sizeof(double));
+    const size_t peak = arena.peakBytes();
+    arena.release();
+    assert(arena.bytesAllocated() == 0 && arena.peakBytes() == peak);
+
+    // Default-allocated overloads are unchanged
+    auto plain = cpppy_bridge::NumpyConverter::numpyToMatrix2D(
+        py::array_t<double>(py::module_::import("numpy").attr("ones")(py::make_tuple(2, 2))));
+    assert(plain.size() == 2 && plain[1][1] == 1.0);
+
+    // CPython allocator adapter over a memory resource
+    std::pmr::synchronized_pool_resource pool;
+    cpppy_bridge::ResourceAllocator resource_allocator(&pool);
+    PyMemAllocatorEx allocator = resource_allocator.allocator();
+
+    auto *zeroed = static_cast<unsigned char *>(allocator.calloc(allocator.ctx, 16, 4));
+    assert(zeroed != nullptr && std::all_of(zeroed, zeroed + 64, [](unsigned char c)
+                                            { return c == 0; }));
+    zeroed[63] = 42;
+    auto *grown = static_cast<unsigned char *>(allocator.realloc(allocator.ctx, zeroed, 4096));
+    assert(grown != nullptr && grown[63] == 42);
+    assert(reinterpret_cast<std::uintptr_t>(grown) % alignof(std::max_align_t) == 0);
+    // Resizing within the block's capacity stays in place
+    assert(allocator.realloc(allocator.ctx, grown, 100) == grown && resource_allocator.bytesInUse() == 100);
+    assert(allocator.realloc(allocator.ctx, grown, 4096) == grown && grown[63] == 42);
+    void *empty = allocator.malloc(allocator.ctx, 0);
+    assert(empty != nullptr);
+    assert(resource_allocator.bytesInUse() == 4096 && resource_allocator.allocationCount() == 2);
+    assert(allocator.calloc(allocator.ctx, SIZE_MAX / 2, 4) == nullptr);
+    allocator.free(allocator.ctx, grown);
+    allocator.free(allocator.ctx, empty);
+    allocator.free(allocator.ctx, nullptr);
+    assert(resource_allocator.bytesInUse() == 0 && resource_allocator.allocationCount() == 0);
+
+    // Allocators only apply to the first interpreter in the process
+    cpppy_bridge::StartupProfile profile;
+    profile.allocator.preset = cpppy_bridge::PythonAllocator::Malloc;
+    assert(!profile.allocator.isDefault());
+    cpppy_bridge::PythonInterpreter::getInstance().initialize(profile);
+    assert(py::eval("1 + 1").cast<int>() == 2);
+
+#if defined(__linux__)
+    // Installation needs a fresh process: rerun this binary in allocator probe mode
+    std::vector<char *> probe_argv = {const_cast<char *>("test_bridge"), const_cast<char *>("--allocator-probe"),
+                                      nullptr};
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0)
+    {
+        execv("/proc/self/exe", probe_argv.data());
+        _exit(127);
+    }
+    int status = 0;
+    {
+        py::gil_scoped_release release;
+        waitpid(pid, &status, 0);
+    }
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+#endif
+
+    std::cout << "ConversionArena tests passed" << std::endl;
+}
+
+// Run in a child process by testConversionArena: the interpreter must be
+// created with the ResourceAllocator installed
+int runAllocatorProbe()
+{
+    // Custom allocators must outlive the interpreter, so both are leaked
+    auto *pool = new std::pmr::synchronized_pool_resource();
+    auto *resource_allocator = new cpppy_bridge::ResourceAllocator(pool);
+
+    cpppy_bridge::StartupProfile profile;
+    profile.allocator.mem = resource_allocator->allocator();
+    profile.allocator.object = resource_allocator->allocator();
+    cpppy_bridge::PythonInterpreter::getInstance().initialize(profile);
+
+    py::exec("probe = {str(i): [i] * 8 for i in range(1000)}");
+    const bool used = resource_allocator->bytesInUse() > 0 && resource_allocator->allocationCount() > 0;
+    std::cout << "Allocator probe: " << resource_allocator->bytesInUse() << " bytes in "
+              << resource_allocator->allocationCount() << " blocks" << std::endl;
+    return used ? 0 : 1;
+}
+
+void testColumnarInterchange()
+{
+    std::string columnar_module_content = R"(
+def column_sums(batch):
+    return {name: float(batch.column(name).sum()) for name in batch.column_names}
+
+def passthrough(batch):
+    return batch
+)";
+
+    std::ofstream temp_file("columnar_test_module.py");
+    temp_file << columnar_module_content;
+    temp_file.close();
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto module = bridge.loadModule("columnar_test_module");
+        assert(module->isLoaded());
+
+        std::vector<double> prices = {1.0, 2.0, 3.0};
+        const double *original = prices.data();
+        cpppy_bridge::ColumnarTable table;
+        table.addColumn("price", std::move(prices));
+        table.addColumn("volume", std::vector<int64_t>({10, 20, 30}));
+        assert(table.numRows() == 3 && table.numColumns() == 2);
+        assert(table.column<double>("price") == original);
+
+        py::object batch = cpppy_bridge::ColumnarConverter::toArrow(table);
+        assert(py::hasattr(batch, "__arrow_c_array__"));
+        assert(py::len(batch) == 3);
+
+        auto sums = module->callFunction<std::map<std::string, double>>("column_sums", batch);
+        assert(sums["price"] == 6.0);
+        assert(sums["volume"] == 60.0);
+
+        // Round trip through the capsule protocol shares the original buffers
+        py::object returned = module->callFunction<py::object>("passthrough", batch);
+        cpppy_bridge::ColumnarTable imported = cpppy_bridge::ColumnarConverter::fromArrow(returned);
+        assert(imported.columnNames() == std::vector<std::string>({"price", "volume"}));
+        assert(imported.column<double>("price") == original);
+        assert(imported.columnToVector<int64_t>("volume") == std::vector<int64_t>({10, 20, 30}));
+
+        auto column_map = cpppy_bridge::ColumnarConverter::toColumnMap(imported);
+        assert(column_map["volume"] == std::vector<double>({10.0, 20.0, 30.0}));
+
+        bool mismatched = false;
+        try
+        {
+            table.addColumn("short", std::vector<double>({1.0}));
+        }
+        catch (const std::runtime_error &)
+        {
+            mismatched = true;
+        }
+        assert(mismatched);
+
+        std::cout << "ColumnarInterchange tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "ColumnarInterchange test failed: " << e.what() << std::endl;
+        std::remove("columnar_test_module.py");
+        throw;
+    }
+
+    std::remove("columnar_test_module.py");
+}
+
+void testBridgeMetrics()
+{
+    std::string metrics_module_content = R"(
+def add(a, b):
+    return a + b
+
+def fail():
+    raise ValueError("metrics")
+)";
+
+    std::ofstream temp_file("metrics_test_module.py");
+    temp_file << metrics_module_content;
+    temp_file.close();
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto module = bridge.loadModule("metrics_test_module");
+        assert(module->isLoaded());
+
+        // Nothing is recorded while disabled
+        cpppy_bridge::BridgeMetrics::reset();
+        module->callFunction<int>("add", 1, 2);
+        assert(cpppy_bridge::BridgeMetrics::snapshot().find("metrics_test_module.add") == nullptr);
+
+        cpppy_bridge::BridgeMetrics::setEnabled(true);
+        for (int i = 0; i < 10; ++i)
+        {
+            assert(module->callFunction<int>("add", i, 1) == i + 1);
+        }
+
+        cpppy_bridge::PythonFunction add(module, "add");
+        std::thread worker([&add]()
+                           {
+            py::gil_scoped_acquire gil;
+            for (int i = 0; i < 5; ++i) {
+                add.call<int>(i, i);
+            } });
+        {
+            py::gil_scoped_release release;
+            worker.join();
+        }
+
+        cpppy_bridge::ErrorHandler::setErrorLogging(false);
+        for (int i = 0; i < 3; ++i)
+        {
+            try
+            {
+                module->callFunction<void>("fail");
+                assert(false); // Should not be reached
+            }
+            catch (const cpppy_bridge::PythonBridgeException &)
+            {
+                // Expected exception
+            }
+        }
+        cpppy_bridge::ErrorHandler::setErrorLogging(true);
+
+        auto values = cpppy_bridge::TypeConverter::fromPython<std::vector<double>>(py::eval("[1.0, 2.0, 3.0]"));
+        assert(values.size() == 3);
+        cpppy_bridge::BridgeMetrics::setEnabled(false);
+
+        // Histograms from both threads are merged on read
+        auto snapshot = cpppy_bridge::BridgeMetrics::snapshot();
+        const auto *add_metrics = snapshot.find("metrics_test_module.add");
+        assert(add_metrics != nullptr);
+        assert(add_metrics->calls == 15);
+        assert(add_metrics->exceptions == 0);
+        const auto &python_time = add_metrics->phase(cpppy_bridge::MetricPhase::Python);
+        assert(python_time.count == 15);
+        assert(python_time.min_ns <= python_time.percentileNanos(0.5));
+        assert(python_time.percentileNanos(0.5) <= python_time.max_ns);
+        assert(add_metrics->phase(cpppy_bridge::MetricPhase::ArgConversion).count == 15);
+        assert(add_metrics->phase(cpppy_bridge::MetricPhase::ResultConversion).count == 15);
+
+        const auto *fail_metrics = snapshot.find("metrics_test_module.fail");
+        assert(fail_metrics != nullptr);
+        assert(fail_metrics->calls == 3 && fail_metrics->exceptions == 3);
+
+        // Only the top-level conversion is timed, not each element
+        const auto *conversion = snapshot.find("TypeConverter.fromPython");
+        assert(conversion != nullptr && conversion->calls == 1);
+
+        // Bucket bounds stay within 12.5% of the recorded value
+        for (uint64_t ns : {uint64_t{7}, uint64_t{100}, uint64_t{12345}, uint64_t{987654321}})
+        {
+            uint64_t bound = cpppy_bridge::LatencyHistogram::bucketUpperBound(
+                cpppy_bridge::LatencyHistogram::bucketIndex(ns));
+            assert(bound >= ns && bound - ns <= ns / 8);
+        }
+
+        std::string text = cpppy_bridge::BridgeMetrics::exportPrometheus(snapshot);
+        assert(text.find("# TYPE cpppy_bridge_calls_total counter") != std::string::npos);
+        assert(text.find("cpppy_bridge_calls_total{function=\"metrics_test_module.add\"} 15") != std::string::npos);
+        assert(text.find("cpppy_bridge_exceptions_total{function=\"metrics_test_module.fail\"} 3") != std::string::npos);
+        assert(text.find("cpppy_bridge_python_seconds_count{function=\"metrics_test_module.add\"} 15") != std::string::npos);
+
+        cpppy_bridge::BridgeMetrics::reset();
+        assert(cpppy_bridge::BridgeMetrics::snapshot().find("metrics_test_module.add")->calls == 0);
+
+        std::cout << "BridgeMetrics tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "BridgeMetrics test failed: " << e.what() << std::endl;
+        cpppy_bridge::BridgeMetrics::setEnabled(false);
+        std::remove("metrics_test_module.py");
+        throw;
+    }
+
+    std::remove("metrics_test_module.py");
+}
+
+void testBridgeMemory()
 {
+    std::string memory_module_content = R"(
+retained = []
+
+def square(x):
+    return x * x
+
+def grow(n):
+    retained.extend(bytearray(1024) for _ in range(n))
+    return len(retained)
+)";
+
+    std::ofstream temp_file("memory_test_module.py");
+    temp_file << memory_module_content;
+    temp_file.close();
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto module = bridge.loadModule("memory_test_module");
+        assert(module->isLoaded());
+
+        // Live counters follow bridge objects
+        auto before = cpppy_bridge::BridgeMemoryStats::liveObjects();
+        assert(before.modules >= 1);
+        {
+            cpppy_bridge::PythonFunction square(module, "square");
+            auto objects = cpppy_bridge::BridgeMemoryStats::liveObjects();
+            assert(objects.functions == before.functions + 1);
+
+            square.withCache();
+            for (int i = 0; i < 4; ++i)
+            {
+                assert(square.call<int>(i) == i * i);
+            }
+            objects = cpppy_bridge::BridgeMemoryStats::liveObjects();
+            assert(objects.memo_caches == before.memo_caches + 1);
+            assert(objects.memo_entries == before.memo_entries + 4);
+            assert(objects.memo_bytes > before.memo_bytes);
+        }
+        auto after = cpppy_bridge::BridgeMemoryStats::liveObjects();
+        assert(after.functions == before.functions);
+        assert(after.memo_caches == before.memo_caches);
+        assert(after.memo_entries == before.memo_entries);
+
+        auto native = cpppy_bridge::BridgeMemoryStats::nativeHeap();
+#if defined(__linux__)
+        assert(native.rss_bytes > 0);
+        assert(native.peak_rss_bytes >= native.rss_bytes / 2);
+#endif
+        (void)native;
+
+        // Growth is attributed to the allocating line
+        auto &interpreter = cpppy_bridge::PythonInterpreter::getInstance();
+        interpreter.startTracemalloc();
+        assert(interpreter.isTracemallocActive());
+        interpreter.tracemallocGrowth();
+        module->callFunction<int>("grow", 256);
+
+        auto growth = interpreter.tracemallocGrowth(5);
+        assert(!growth.top.empty());
+        assert(growth.top[0].location.find("memory_test_module.py") != std::string::npos);
+        assert(growth.top[0].bytes >= 256 * 1024);
+        assert(growth.top[0].blocks >= 256);
+
+        auto snapshot = interpreter.takeTracemallocSnapshot(3);
+        assert(snapshot.top.size() <= 3);
+        assert(snapshot.traced_bytes > 0 && snapshot.peak_bytes >= snapshot.traced_bytes);
+        assert(cpppy_bridge::BridgeMemoryStats::pythonHeap().traced_bytes > 0);
+
+        // The sampler takes its first sample immediately and never waits for the GIL,
+        // even while this thread holds it
+        std::atomic<int> callbacks{0};
+        {
+            cpppy_bridge::MemorySampler sampler(std::chrono::milliseconds(10),
+                                                [&callbacks](const cpppy_bridge::MemorySample &)
+                                                { callbacks++; },
+                                                2);
+            for (int i = 0; i < 100 && callbacks < 3; ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            assert(callbacks >= 3);
+
+            // Python counters arrive once the main thread runs Python code
+            for (int i = 0; i < 200 && sampler.latest()->python.traced_bytes == 0; ++i)
+            {
+                {
+                    py::gil_scoped_release release;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+                py::exec("for _ in range(1000): pass");
+            }
+            sampler.stop();
+
+            auto history = sampler.history();
+            assert(!history.empty() && history.size() <= 2);
+            assert(history.back().python.traced_bytes > 0);
+            assert(history.back().python.allocated_blocks > 0);
+            assert(history.back().objects.modules >= 1);
+        }
+
+        interpreter.stopTracemalloc();
+        assert(!interpreter.isTracemallocActive());
+        assert(!interpreter.tracemallocStarted());
+        assert(cpppy_bridge::BridgeMemoryStats::pythonHeap().traced_bytes == 0);
+
+        std::string text = cpppy_bridge::BridgeMemoryStats::exportPrometheus(cpppy_bridge::BridgeMemoryStats::sample());
+        assert(text.find("# TYPE cpppy_bridge_python_allocated_blocks gauge") != std::string::npos);
+        assert(text.find("cpppy_bridge_python_gc_count{generation=\"2\"}") != std::string::npos);
+        assert(text.find("cpppy_bridge_live_objects{kind=\"module\"}") != std::string::npos);
+        assert(text.find("cpppy_bridge_memo_cache_bytes") != std::string::npos);
+
+        std::cout << "BridgeMemory tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "BridgeMemory test failed: " << e.what() << std::endl;
+        std::remove("memory_test_module.py");
+        throw;
+    }
+
+    std::remove("memory_test_module.py");
+}
+
+void testModuleReload()
+{
+    auto write_module = [](const std::string &content)
+    {
+        std::ofstream file("reload_test_module.py");
+        file << content;
+    };
+    write_module("def version():\n    return 1\n");
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto module = bridge.loadModule("reload_test_module");
+        assert(module->isLoaded());
+        assert(!module->getFilePath().empty());
+
+        cpppy_bridge::PythonFunction version(module, "version");
+        cpppy_bridge::TypedFunction<int()> typed_version(module, "version");
+        auto handle = bridge.resolve("reload_test_module", "version");
+        assert(version.call<int>() == 1);
+
+        // A reference held across the reload keeps running the old version
+        py::object in_flight = module->getAttribute("version");
+
+        write_module("def version():\n    return 2  # second version\n");
+        assert(bridge.reloadModule("reload_test_module"));
+        assert(version.call<int>() == 2);
+        assert(typed_version() == 2);
+        assert(handle.call<int>() == 2);
+        assert(in_flight().cast<int>() == 1);
+        assert(bridge.loadModule("reload_test_module") == module);
+
+        // A broken version leaves the current one active
+        const uint64_t generation = module->getGeneration();
+        write_module("def version(:\n");
+        assert(!bridge.reloadModule("reload_test_module"));
+        assert(module->getGeneration() == generation);
+        assert(version.call<int>() == 2);
+        assert(py::module::import("sys").attr("modules").contains("reload_test_module"));
+
+        // The watcher picks up changed files in the background
+        write_module("def version():\n    return 3  # third version, watched\n");
+        std::filesystem::last_write_time("reload_test_module.py",
+                                         std::filesystem::last_write_time("reload_test_module.py") + std::chrono::seconds(2));
+        bridge.watchModules(std::chrono::milliseconds(20));
+        {
+            py::gil_scoped_release release;
+            for (int i = 0; i < 200 && module->getGeneration() == generation; ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        bridge.stopWatching();
+        assert(module->getGeneration() > generation);
+        assert(version.call<int>() == 3);
+
+        auto async_reload = bridge.reloadModuleAsync("reload_test_module");
+        {
+            py::gil_scoped_release release;
+            async_reload.wait();
+        }
+        assert(async_reload.get());
+        assert(version.call<int>() == 3);
+
+        // Dropping the future while holding the GIL does not wait for the reload
+        const auto before_drop = module->getGeneration();
+        bridge.reloadModuleAsync("reload_test_module");
+        {
+            py::gil_scoped_release release;
+            for (int i = 0; i < 500 && module->getGeneration() == before_drop; ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        assert(module->getGeneration() > before_drop);
+
+        std::cout << "ModuleReload tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "ModuleReload test failed: " << e.what() << std::endl;
+        std::remove("reload_test_module.py");
+        throw;
+    }
+
+    std::remove("reload_test_module.py");
+}
+
+void testCodeCache()
+{
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto &cache = cpppy_bridge::PythonInterpreter::getInstance().getCodeCache();
+        cache.clear();
+        auto before = cache.getStats();
+
+        // Repeated expressions are compiled once
+        for (int i = 0; i < 10; ++i)
+        {
+            assert(bridge.executeCode("6 * 7").cast<int>() == 42);
+        }
+        auto stats = cache.getStats();
+        assert(stats.misses - before.misses == 1);
+        assert(stats.hits - before.hits == 9);
+
+        // Parameters through a reused locals dict
+        py::dict params;
+        for (int i = 0; i < 5; ++i)
+        {
+            params["x"] = i;
+            assert(bridge.executeCode("x * x + 1", params).cast<int>() == i * i + 1);
+        }
+
+        // Exec mode runs statements; assignments land in locals
+        py::dict scope;
+        assert(bridge.executeCode("y = 3\nz = y * 2", scope, cpppy_bridge::CodeMode::Exec).is_none());
+        assert(scope["z"].cast<int>() == 6);
+        bridge.executeCode("cache_test_value = 11", cpppy_bridge::CodeMode::Exec);
+        assert(bridge.executeCode("cache_test_value").cast<int>() == 11);
+
+        // The same text in another mode is a separate entry
+        stats = cache.getStats();
+        bridge.executeCode("6 * 7", cpppy_bridge::CodeMode::Exec);
+        assert(cache.getStats().misses == stats.misses + 1);
+
+        // Entries beyond the capacity are evicted least recently used first
+        cache.setCapacity(2);
+        assert(cache.getStats().size <= 2);
+        bridge.executeCode("1 + 1");
+        bridge.executeCode("2 + 2");
+        bridge.executeCode("3 + 3");
+        stats = cache.getStats();
+        assert(stats.size == 2);
+        bridge.executeCode("3 + 3");
+        assert(cache.getStats().hits == stats.hits + 1);
+        cache.setCapacity(256);
+
+        // Files are recompiled only after they change
+        {
+            std::ofstream script("code_cache_script.py");
+            script << "cache_script_value = 1\n";
+        }
+        bridge.executeFile("code_cache_script.py");
+        stats = cache.getStats();
+        bridge.executeFile("code_cache_script.py");
+        assert(cache.getStats().hits == stats.hits + 1);
+        assert(bridge.executeCode("cache_script_value").cast<int>() == 1);
+
+        {
+            std::ofstream script("code_cache_script.py");
+            script << "cache_script_value = 2  # changed\n";
+        }
+        std::filesystem::last_write_time("code_cache_script.py",
+                                         std::filesystem::last_write_time("code_cache_script.py") + std::chrono::seconds(2));
+        bridge.executeFile("code_cache_script.py");
+        assert(cache.getStats().invalidations == stats.invalidations + 1);
+        assert(bridge.executeCode("cache_script_value").cast<int>() == 2);
+
+        // Compilation errors are not cached
+        bool threw = false;
+        try
+        {
+            bridge.executeCode("1 +");
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        std::cout << "CodeCache tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "CodeCache test failed: " << e.what() << std::endl;
+        std::remove("code_cache_script.py");
+        throw;
+    }
+
+    std::remove("code_cache_script.py");
+}
+
+void testMemoization()
+{
+    auto write_module = [](const std::string &square_body)
+    {
+        std::ofstream file("memo_test_module.py");
+        file << "calls = 0\n\n";
+        file << "def square(x):\n    global calls\n    calls += 1\n    return " << square_body << "\n\n";
+        file << "def label(name, tags):\n    global calls\n    calls += 1\n    return name + ':' + ','.join(tags)\n\n";
+        file << "def call_count():\n    return calls\n";
+    };
+    write_module("x * x");
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto module = bridge.loadModule("memo_test_module");
+        auto call_count = [&module] { return module->callFunction<int>("call_count"); };
+
+        cpppy_bridge::PythonFunction square(module, "square");
+        square.withCache();
+        assert(square.call<int>(12) == 144);
+        assert(square.call<int>(12) == 144);
+        assert(square.call<int>(12L) == 144);
+        assert(call_count() == 1);
+
+        // Hits never touch the GIL; misses acquire it
+        {
+            py::gil_scoped_release release;
+            assert(square.call<int>(12) == 144);
+            std::thread worker([&square] { assert(square.call<int>(7) == 49); });
+            worker.join();
+        }
+        assert(call_count() == 2);
+
+        // A hit completes on another thread while this one keeps the GIL
+        {
+            std::promise<int> hit;
+            auto hit_future = hit.get_future();
+            std::thread worker([&square, &hit] { hit.set_value(square.call<int>(12)); });
+            const bool finished = hit_future.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+            {
+                // Let a worker stuck on the GIL finish instead of deadlocking the test
+                py::gil_scoped_release release;
+                worker.join();
+            }
+            assert(finished && hit_future.get() == 144);
+        }
+
+        auto stats = square.getCacheStats();
+        assert(stats.hits == 4 && stats.misses == 2 && stats.entries == 2);
+
+        cpppy_bridge::PythonFunction label(module, "label");
+        label.withCache();
+        std::vector<std::string> tags = {"a", "b"};
+        assert(label.call<std::string>("item", tags) == "item:a,b");
+        assert(label.call<std::string>(std::string("item"), tags) == "item:a,b");
+        assert(call_count() == 3);
+
+        // Time-to-live and LRU bounds
+        cpppy_bridge::MemoCachePolicy short_lived;
+        short_lived.ttl = std::chrono::milliseconds(20);
+        cpppy_bridge::PythonFunction expiring(module, "square");
+        expiring.withCache(short_lived);
+        expiring.call<int>(3);
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        expiring.call<int>(3);
+        assert(expiring.getCacheStats().expirations == 1);
+
+        cpppy_bridge::MemoCachePolicy small;
+        small.max_entries = 4;
+        small.shards = 1;
+        cpppy_bridge::PythonFunction bounded(module, "square");
+        bounded.withCache(small);
+        for (int i = 0; i < 10; ++i)
+        {
+            bounded.call<int>(i);
+        }
+        assert(bounded.getCacheStats().entries == 4);
+        assert(bounded.getCacheStats().evictions == 6);
+
+        // Results holding Python objects are never cached
+        cpppy_bridge::PythonFunction boxed(module, "square");
+        boxed.withCache();
+        py::object first = boxed.call<py::object>(5);
+        py::object second = boxed.call<py::object>(5);
+        assert(first.cast<int>() == 25 && second.cast<int>() == 25);
+        assert(boxed.getCacheStats().hits == 0 && boxed.getCacheStats().entries == 0);
+
+        // Results computed before a reload are not stored afterwards
+        cpppy_bridge::MemoCache cache;
+        assert(!cache.find<int>("key", 2));
+        cache.insert("key", 1, 1);
+        assert(cache.getStats().entries == 0);
+        cache.insert("key", 1, 2);
+        assert(cache.find<int>("key", 2) == 1);
+
+        // Reloading the module invalidates cached results
+        write_module("x * x + 1");
+        assert(bridge.reloadModule("memo_test_module"));
+        assert(square.call<int>(12) == 145);
+        assert(square.getCacheStats().invalidations == 1);
+
+        std::cout << "Memoization tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Memoization test failed: " << e.what() << std::endl;
+        std::remove("memo_test_module.py");
+        throw;
+    }
+
+    std::remove("memo_test_module.py");
+}
+
+void testArgumentPack()
+{
+    {
+        std::ofstream file("argument_pack_module.py");
+        file << "def add(a, b):\n    return a + b\n\n";
+        file << "def count(*args):\n    return len(args)\n";
+    }
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto module = bridge.loadModule("argument_pack_module");
+        auto add = bridge.resolve("argument_pack_module", "add");
+
+        // The tuple is refilled in place call after call
+        cpppy_bridge::ArgumentPack pack(2);
+        const uint64_t allocations = pack.allocations();
+        double total = 0.0;
+        for (int i = 0; i < 100; ++i)
+        {
+            pack.set(0, total).set(1, 1.0);
+            total = add.callPy(pack).cast<double>();
+        }
+        assert(total == 100.0);
+        assert(pack.allocations() == allocations);
+
+        // Slots keep their values; only changed arguments are set
+        pack.set(0, 40);
+        assert(add.callPy(pack).cast<double>() == 41.0);
+        assert(module->callFunction("add", pack).cast<double>() == 41.0);
+        cpppy_bridge::PythonFunction add_function(module, "add");
+        assert(add_function.callPy(pack).cast<double>() == 41.0);
+
+        // A tuple referenced elsewhere is copied before it is written
+        py::object held = py::reinterpret_borrow<py::object>(pack.tuple());
+        pack.set(1, std::string("unused"));
+        assert(pack.allocations() == allocations + 1);
+        assert(held.cast<py::tuple>()[1].cast<double>() == 1.0);
+        held = py::object();
+
+        pack.assign(std::string("a"), std::string("b"));
+        assert(add.callPy(pack).cast<std::string>() == "ab");
+        pack.assign(1, 2, 3);
+        assert(pack.size() == 3);
+        assert(module->callFunction("count", pack).cast<int>() == 3);
+
+        // Small values are shared objects; -0.0 keeps its sign
+        assert(cpppy_bridge::SmallValueCache::integer(1000).ptr() == cpppy_bridge::SmallValueCache::integer(1000).ptr());
+        assert(cpppy_bridge::SmallValueCache::floating(2.0).ptr() == cpppy_bridge::SmallValueCache::floating(2.0).ptr());
+        assert(cpppy_bridge::SmallValueCache::integer(1 << 20).cast<int>() == (1 << 20));
+        assert(cpppy_bridge::SmallValueCache::floating(0.25).cast<double>() == 0.25);
+        py::object negative_zero = cpppy_bridge::SmallValueCache::floating(-0.0);
+        assert(py::module::import("math").attr("copysign")(1.0, negative_zero).cast<double>() == -1.0);
+
+        // The vector overload passes arguments without intermediate containers
+        std::vector<py::object> many;
+        for (int i = 0; i < 12; ++i)
+        {
+            many.push_back(py::int_(i));
+        }
+        assert(module->callFunction("count", many).cast<int>() == 12);
+        assert(module->callFunction("count", std::vector<py::object>(many.begin(), many.begin() + 3)).cast<int>() == 3);
+
+        std::cout << "ArgumentPack tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "ArgumentPack test failed: " << e.what() << std::endl;
+        std::remove("argument_pack_module.py");
+        throw;
+    }
+
+    std::remove("argument_pack_module.py");
+}
+
+void testAsyncCalls()
+{
+    {
+        std::ofstream file("async_test_module.py");
+        file << "import asyncio\n\n";
+        file << "async def delayed_double(x):\n    await asyncio.sleep(0.05)\n    return x * 2\n\n";
+        file << "async def fail():\n    await asyncio.sleep(0)\n    raise ValueError('async failure')\n\n";
+        file << "def sync_value():\n    return 7\n";
+    }
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto module = bridge.loadModule("async_test_module");
+        cpppy_bridge::PythonFunction delayed_double(module, "delayed_double");
+
+        // Many coroutines are multiplexed on the single loop thread
+        auto start = std::chrono::steady_clock::now();
+        std::vector<cpppy_bridge::AsyncCall<int>> calls;
+        for (int i = 0; i < 200; ++i)
+        {
+            calls.push_back(delayed_double.callAsync<int>(i));
+        }
+        assert(cpppy_bridge::AsyncLoop::getInstance().isRunning());
+        for (int i = 0; i < 200; ++i)
+        {
+            assert(calls[i].get() == i * 2);
+        }
+        assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+
+        // Python exceptions surface from get()
+        cpppy_bridge::PythonFunction fail(module, "fail");
+        auto failing = fail.callAsync<void>();
+        bool threw = false;
+        try
+        {
+            failing.get();
+        }
+        catch (const std::exception &e)
+        {
+            threw = std::string(e.what()).find("async failure") != std::string::npos;
+        }
+        assert(threw);
+
+        // Plain functions complete immediately
+        cpppy_bridge::PythonFunction sync_value(module, "sync_value");
+        auto immediate = sync_value.callAsync<int>();
+        assert(immediate.isReady());
+        assert(immediate.get() == 7);
+
+        // Continuations and the std::future adapter
+        std::atomic<bool> continued{false};
+        auto chained = delayed_double.callAsync<int>(5);
+        chained.then([&continued] { continued = true; });
+        assert(chained.get() == 10);
+        {
+            // The continuation runs right after waiters are woken
+            py::gil_scoped_release release;
+            for (int i = 0; i < 200 && !continued; ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+        assert(continued);
+
+        auto future = delayed_double.callAsync<int>(21).toFuture();
+        {
+            py::gil_scoped_release release;
+            assert(future.get() == 42);
+        }
+
+        std::cout << "AsyncCalls tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "AsyncCalls test failed: " << e.what() << std::endl;
+        std::remove("async_test_module.py");
+        throw;
+    }
+
+    std::remove("async_test_module.py");
+}
+
+void testPythonStream()
+{
+    {
+        std::ofstream file("stream_test_module.py");
+        file << "import array\n\n";
+        file << "def numbers(n):\n    for i in range(n):\n        yield i\n\n";
+        file << "def batches(count, size):\n    for b in range(count):\n";
+        file << "        yield array.array('d', [float(b * size + i) for i in range(size)])\n\n";
+        file << "def words():\n    yield 'alpha'\n    yield 'beta'\n\n";
+        file << "def broken():\n    yield 1\n    raise ValueError('stream failure')\n";
+    }
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+        auto module = bridge.loadModule("stream_test_module");
+
+        // Scalars arrive in prefetched chunks
+        auto numbers = module->callStream<int64_t>("numbers", 10000);
+        int64_t sum = 0;
+        int64_t count = 0;
+        for (int64_t value : numbers)
+        {
+            sum += value;
+            ++count;
+        }
+        assert(count == 10000);
+        assert(sum == 10000LL * 9999 / 2);
+        assert(numbers.chunksRead() == 3);
+
+        // Buffer-protocol items are copied whole
+        cpppy_bridge::StreamOptions options;
+        options.chunk_size = 256;
+        cpppy_bridge::PythonStream<double> batches(module->getAttribute("batches")(8, 100), options);
+        std::vector<double> chunk;
+        size_t total = 0;
+        while (batches.nextChunk(chunk))
+        {
+            assert(chunk.size() <= options.chunk_size + 99);
+            assert(chunk[0] == static_cast<double>(total));
+            total += chunk.size();
+        }
+        assert(total == 800);
+
+        // Synchronous pulls and non-numeric types
+        options.prefetch = false;
+        cpppy_bridge::PythonStream<std::string> words(module->getAttribute("words")(), options);
+        std::vector<std::string> collected(words.begin(), words.end());
+        assert((collected == std::vector<std::string>{"alpha", "beta"}));
+
+        // Iterator errors are raised when reached
+        auto broken = module->callStream<int>("broken");
+        bool threw = false;
+        try
+        {
+            for (int value : broken)
+            {
+                (void)value;
+            }
+        }
+        catch (const std::exception &e)
+        {
+            threw = std::string(e.what()).find("stream failure") != std::string::npos;
+        }
+        assert(threw);
+
+        // Abandoning a stream early stops its producer
+        {
+            auto partial = module->callStream<int>("numbers", 1000000);
+            auto it = partial.begin();
+            assert(*it == 0);
+        }
+
+        std::cout << "PythonStream tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "PythonStream test failed: " << e.what() << std::endl;
+        std::remove("stream_test_module.py");
+        throw;
+    }
+
+    std::remove("stream_test_module.py");
+}
+
+void testPythonObject()
+{
+    auto write_module = [](const std::string &scale)
+    {
+        std::ofstream file("object_test_module.py");
+        file << "class Accumulator:\n";
+        file << "    instances = 0\n\n";
+        file << "    def __init__(self, start=0.0):\n";
+        file << "        Accumulator.instances += 1\n";
+        file << "        self.total = start\n";
+        file << "        self.callback = lambda x: x * 2\n\n";
+        file << "    def add(self, x):\n        self.total += x * " << scale << "\n        return self.total\n\n";
+        file << "    def reset(self):\n        self.total = 0.0\n\n";
+        file << "    @staticmethod\n    def twice(x):\n        return 2 * x\n\n";
+        file << "    @classmethod\n    def created(cls):\n        return cls.instances\n\n";
+        file << "    @property\n    def doubled(self):\n        return self.total * 2\n\n";
+        file << "class Tagged(list):\n    pass\n";
+    };
+    write_module("1");
+
+    try
+    {
+        cpppy_bridge::PythonBridge bridge;
+        bridge.initialize();
+
+        auto acc = bridge.createInstance("object_test_module", "Accumulator", 1.5);
+        assert(acc->call<double>("add", 2.0) == 3.5);
+        assert(acc->call<double>("add", 1) == 4.5);
+        assert(acc->getAttribute<double>("total") == 4.5);
+        assert(acc->getAttribute<double>("doubled") == 9.0);
+        acc->call<void>("reset");
+        assert(acc->getAttribute<double>("total") == 0.0);
+
+        // Method kinds are resolved once per class
+        auto cls = acc->getClass();
+        assert(cls->method("add").kind == cpppy_bridge::PythonClass::MethodKind::Unbound);
+        assert(cls->method("twice").kind == cpppy_bridge::PythonClass::MethodKind::Static);
+        assert(cls->method("created").kind == cpppy_bridge::PythonClass::MethodKind::Static);
+        assert(cls->method("callback").kind == cpppy_bridge::PythonClass::MethodKind::Attribute);
+        assert(acc->call<int>("twice", 21) == 42);
+        assert(acc->call<int>("created") == 1);
+        assert(acc->call<int>("callback", 5) == 10);
+        assert(bridge.getClass("object_test_module", "Accumulator") == cls);
+
+        auto add = acc->method("add");
+        for (int i = 0; i < 100; ++i)
+        {
+            add.call<double>(1.0);
+        }
+        acc->setAttribute("total", add.call<double>(0.0) + 0.5);
+        assert(acc->getAttribute<double>("total") == 100.5);
+
+        // Built-in method descriptors are called unbound as well
+        auto tagged = bridge.createInstance("object_test_module", "Tagged");
+        assert(tagged->getClass()->method("append").kind == cpppy_bridge::PythonClass::MethodKind::Unbound);
+        tagged->call<void>("append", 7);
+        assert(tagged->call<int>("__len__") == 1);
+
+        try
+        {
+            acc->call<void>("missing");
+            assert(false);
+        }
+        catch (const cpppy_bridge::PythonBridgeException &)
+        {
+        }
+
+        // Argument conversion stops at the first failure without leaving an error set
+        const int created = acc->call<int>("created");
+        bool call_failed = false;
+        try
+        {
+            acc->call<double>("add", UnboundPoint{1}, UnboundPoint{2});
+        }
+        catch (const std::exception &)
+        {
+            call_failed = true;
+        }
+        assert(call_failed && !PyErr_Occurred());
+        bool instantiate_failed = false;
+        try
+        {
+            cls->instantiate(UnboundPoint{1}, UnboundPoint{2});
+        }
+        catch (const std::exception &)
+        {
+            instantiate_failed = true;
+        }
+        assert(instantiate_failed && !PyErr_Occurred());
+        assert(acc->call<int>("created") == created);
+
+        // Per-thread and leased instances
+        auto pool = bridge.createInstancePool("object_test_module", "Accumulator", 0.0);
+        auto mine = pool->local();
+        assert(pool->local() == mine);
+        {
+            py::gil_scoped_release release;
+            std::thread worker([&pool, &mine]
+            {
+                py::gil_scoped_acquire gil;
+                auto theirs = pool->local();
+                assert(theirs != mine);
+                theirs->call<double>("add", 3.0);
+                pool->releaseLocal();
+            });
+            worker.join();
+        }
+        assert(mine->getAttribute<double>("total") == 0.0);
+        {
+            auto first = pool->acquire();
+            auto second = pool->acquire();
+            first->call<double>("add", 1.0);
+            assert(pool->available() == 0);
+        }
+        assert(pool->available() == 2);
+        assert(pool->size() == 4);
+
+        // Reloading yields a new class; existing instances keep the old one
+        write_module("10");
+        assert(bridge.reloadModule("object_test_module"));
+        auto reloaded = bridge.createInstance("object_test_module", "Accumulator");
+        assert(reloaded->getClass() != cls);
+        assert(reloaded->call<double>("add", 1.0) == 10.0);
+        assert(acc->call<double>("add", 1.0) == 101.5);
+
+        std::cout << "PythonObject tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "PythonObject test failed: " << e.what() << std::endl;
+        std::remove("object_test_module.py");
+        throw;
+    }
+
+    std::remove("object_test_module.py");
+}
+
+void testProcessBridge()
+{
+    {
+        std::ofstream file("process_test_module.py");
+        file << "import os\n\n";
+        file << "def add(a, b):\n    return a + b\n\n";
+        file << "def greet(name):\n    return 'hello ' + name\n\n";
+        file << "def total(values):\n    return float(values.sum())\n\n";
+        file << "def scaled(values, k):\n    return values * k\n\n";
+        file << "def fail():\n    raise ValueError('worker failure')\n\n";
+        file << "def crash():\n    os._exit(3)\n";
+    }
+
+    try
+    {
+        cpppy_bridge::ProcessBridgeConfig config;
+        config.num_workers = 2;
+        config.ring_bytes = 4096;
+        cpppy_bridge::ProcessBridge bridge(config);
+        assert(bridge.size() == 2);
+
+        auto module = bridge.loadModule("process_test_module");
+        assert(module->callFunction<int>("add", 2, 3) == 5);
+        assert(bridge.call<std::string>("process_test_module", "greet", "bridge") == "hello bridge");
+
+        // Arrays travel as shared-memory segments
+        std::vector<double> values(100000, 0.5);
+        assert(bridge.call<double>("process_test_module", "total", values) == 50000.0);
+        cpppy_bridge::SharedArray<float> shared({4});
+        for (size_t i = 0; i < shared.size(); ++i)
+        {
+            shared[i] = static_cast<float>(i);
+        }
+        auto doubled = bridge.call<std::vector<float>>("process_test_module", "scaled", shared, 2);
+        assert((doubled == std::vector<float>{0.0f, 2.0f, 4.0f, 6.0f}));
+
+#if defined(__linux__)
+        // Result segments are unlinked even when the result is discarded or rejected
+        auto shm_entries = []()
+        {
+            size_t count = 0;
+            for (const auto &entry : std::filesystem::directory_iterator("/dev/shm"))
+            {
+                (void)entry;
+                ++count;
+            }
+            return count;
+        };
+        const size_t shm_before = shm_entries();
+        bridge.call<void>("process_test_module", "scaled", shared, 2);
+        bool rejected = false;
+        try
+        {
+            bridge.call<int>("process_test_module", "scaled", shared, 2);
+        }
+        catch (const cpppy_bridge::TypeConversionException &)
+        {
+            rejected = true;
+        }
+        assert(rejected);
+        try
+        {
+            bridge.call<std::vector<double>>("process_test_module", "scaled", shared, 2);
+            assert(false); // Should not be reached
+        }
+        catch (const cpppy_bridge::TypeConversionException &)
+        {
+            // Expected exception: float32 array for a double vector
+        }
+        assert(shm_entries() == shm_before);
+#endif
+
+        // Many small calls wrap around the rings
+        auto greet = bridge.createFunction("process_test_module", "greet");
+        for (int i = 0; i < 1000; ++i)
+        {
+            assert(greet->call<std::string>(std::string(64, 'x')).size() == 70);
+        }
+
+        bool threw = false;
+        try
+        {
+            bridge.call<void>("process_test_module", "fail");
+        }
+        catch (const cpppy_bridge::PythonFunctionException &e)
+        {
+            threw = std::string(e.what()).find("worker failure") != std::string::npos;
+        }
+        assert(threw);
+
+        // A crashed worker fails its call and is restarted
+        threw = false;
+        try
+        {
+            bridge.call<void>("process_test_module", "crash");
+        }
+        catch (const cpppy_bridge::PythonInterpreterException &)
+        {
+            threw = true;
+        }
+        assert(threw);
+        assert(bridge.call<int>("process_test_module", "add", 20, 22) == 42);
+
+        uint64_t restarts = 0;
+        for (int i = 0; i < 200 && restarts == 0; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(25));
+            for (const auto &stats : bridge.getStats())
+            {
+                restarts += stats.restarts;
+            }
+        }
+        assert(restarts == 1);
+
+        std::cout << "ProcessBridge tests passed" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "ProcessBridge test failed: " << e.what() << std::endl;
+        std::remove("process_test_module.py");
+        throw;
+    }
+
+    std::remove("process_test_module.py");
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && std::string(argv[1]) == "--allocator-probe")
+    {
+        return runAllocatorProbe();
+    }
+
     std::cout << "C++ Python Bridge Test Suite" << std::endl;
     std::cout << "=============================" << std::endl;
 
@@ -440,12 +2345,31 @@ int main()
 
     // Run all tests
     runner.runTest("PythonInterpreter", testPythonInterpreter);
+    runner.runTest("StartupProfile", testStartupProfile);
     runner.runTest("PythonModule", testPythonModule);
     runner.runTest("PythonFunction", testPythonFunction);
     runner.runTest("PythonBridge", testPythonBridge);
     runner.runTest("TypeConverter", testTypeConverter);
     runner.runTest("ErrorHandling", testErrorHandling);
+    runner.runTest("ErrorLogSink", testErrorLogSink);
     runner.runTest("ComplexDataTypes", testComplexDataTypes);
+    runner.runTest("NumpyZeroCopy", testNumpyZeroCopy);
+    runner.runTest("NumpyKernels", testNumpyKernels);
+    runner.runTest("MatrixConversion", testMatrixConversion);
+    runner.runTest("ConversionArena", testConversionArena);
+    runner.runTest("ColumnarInterchange", testColumnarInterchange);
+    runner.runTest("BridgeMetrics", testBridgeMetrics);
+    runner.runTest("BridgeMemory", testBridgeMemory);
+    runner.runTest("ModuleReload", testModuleReload);
+    runner.runTest("CodeCache", testCodeCache);
+    runner.runTest("Memoization", testMemoization);
+    runner.runTest("ArgumentPack", testArgumentPack);
+    runner.runTest("AsyncCalls", testAsyncCalls);
+    runner.runTest("PythonStream", testPythonStream);
+    runner.runTest("PythonObject", testPythonObject);
+    runner.runTest("PythonExecutor", testPythonExecutor);
+    runner.runTest("InterpreterPool", testInterpreterPool);
+    runner.runTest("ProcessBridge", testProcessBridge);
 
     // Print test summary
     runner.printSummary();